@@ -0,0 +1,37 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <benchmark/benchmark.h>
+
+#include "BenchHelpers.hpp"
+
+using namespace SimpleObjects_Bench;
+
+static void BM_CompareEqualTree(benchmark::State& state)
+{
+	const size_t depth = static_cast<size_t>(state.range(0));
+	const SimObj::Object lhs = BuildTree(depth, 4);
+	const SimObj::Object rhs = BuildTree(depth, 4);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(lhs.BaseObjectIsEqual(rhs));
+	}
+}
+BENCHMARK(BM_CompareEqualTree)->DenseRange(1, 4);
+
+static void BM_CompareOrderTree(benchmark::State& state)
+{
+	// the lists differ only in the last item, so the whole tree is compared
+	const size_t depth = static_cast<size_t>(state.range(0));
+	SimObj::List lhs = { BuildTree(depth, 4), SimObj::Int64(1) };
+	SimObj::List rhs = { BuildTree(depth, 4), SimObj::Int64(2) };
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(lhs.BaseObjectCompare(rhs));
+	}
+}
+BENCHMARK(BM_CompareOrderTree)->DenseRange(2, 4, 2);
@@ -0,0 +1,291 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "BenchHelpers.hpp"
+
+using namespace SimpleObjects_Bench;
+
+namespace
+{
+
+std::vector<SimObj::String> BuildStrKeys(size_t num)
+{
+	std::vector<SimObj::String> keys;
+	keys.reserve(num);
+	for (size_t i = 0; i < num; ++i)
+	{
+		keys.push_back(SimObj::String("dict_key_" + std::to_string(i)));
+	}
+	return keys;
+}
+
+std::vector<SimObj::InternedString> BuildInternedKeys(size_t num)
+{
+	std::vector<SimObj::InternedString> keys;
+	keys.reserve(num);
+	for (size_t i = 0; i < num; ++i)
+	{
+		keys.push_back(SimObj::InternedString(
+			("dict_key_" + std::to_string(i)).c_str()));
+	}
+	return keys;
+}
+
+std::vector<SimObj::Int64> BuildIntKeys(size_t num)
+{
+	std::vector<SimObj::Int64> keys;
+	keys.reserve(num);
+	for (size_t i = 0; i < num; ++i)
+	{
+		keys.push_back(SimObj::Int64(static_cast<int64_t>(i * 7919)));
+	}
+	return keys;
+}
+
+std::vector<SimObj::Tuple> BuildTupleKeys(size_t num)
+{
+	std::vector<SimObj::Tuple> keys;
+	keys.reserve(num);
+	for (size_t i = 0; i < num; ++i)
+	{
+		keys.push_back(SimObj::Tuple({
+			SimObj::String("dict_key"),
+			SimObj::Int64(static_cast<int64_t>(i)) }));
+	}
+	return keys;
+}
+
+template<typename _DictType, typename _KeyType>
+void BenchInsert(benchmark::State& state, const std::vector<_KeyType>& keys)
+{
+	for (auto _ : state)
+	{
+		_DictType dict;
+		for (const auto& key : keys)
+		{
+			dict.InsertOrAssign(SimObj::HashableObject(key), SimObj::Null());
+		}
+		benchmark::DoNotOptimize(dict);
+	}
+	state.SetItemsProcessed(
+		state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+template<typename _DictType, typename _KeyType>
+void BenchFind(benchmark::State& state, const std::vector<_KeyType>& keys)
+{
+	_DictType dict;
+	for (const auto& key : keys)
+	{
+		dict.InsertOrAssign(SimObj::HashableObject(key), SimObj::Null());
+	}
+	const SimObj::DictBaseObj& dictBase = dict;
+
+	for (auto _ : state)
+	{
+		for (const auto& key : keys)
+		{
+			auto it = dictBase.FindVal(key);
+			benchmark::DoNotOptimize(it);
+		}
+	}
+	state.SetItemsProcessed(
+		state.iterations() * static_cast<int64_t>(keys.size()));
+}
+
+/**
+ * @brief Look up raw strings, either directly, or by constructing a String
+ *        for each lookup, as it had to be done before raw lookups were added.
+ *        The keys are long enough to not fit in the small string buffer.
+ *
+ */
+template<bool _RawLookup>
+void BenchFindRawStr(benchmark::State& state, size_t num)
+{
+	std::vector<std::string> rawKeys;
+	SimObj::Dict dict;
+	for (size_t i = 0; i < num; ++i)
+	{
+		rawKeys.push_back("request_field_name_" + std::to_string(i));
+		dict.InsertOrAssign(
+			SimObj::HashableObject(SimObj::String(rawKeys.back())),
+			SimObj::Null());
+	}
+
+	for (auto _ : state)
+	{
+		for (const auto& key : rawKeys)
+		{
+			bool res = _RawLookup ?
+				dict.HasKey(key) :
+				dict.HasKey(SimObj::String(key));
+			benchmark::DoNotOptimize(res);
+		}
+	}
+	state.SetItemsProcessed(
+		state.iterations() * static_cast<int64_t>(rawKeys.size()));
+}
+
+/**
+ * @brief Build a list of records with the same keys, and then read one
+ *        field from each of them
+ *
+ */
+template<typename _DictType>
+void BenchRecords(benchmark::State& state, size_t numRecords)
+{
+	const std::vector<SimObj::String> keys = BuildStrKeys(8);
+
+	for (auto _ : state)
+	{
+		std::vector<_DictType> records(numRecords);
+		for (auto& record : records)
+		{
+			for (const auto& key : keys)
+			{
+				record.InsertOrAssign(
+					SimObj::HashableObject(key), SimObj::Int64(1));
+			}
+		}
+
+		int64_t sum = 0;
+		for (const auto& record : records)
+		{
+			sum += record[keys[5]].AsCppInt64();
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(
+		state.iterations() * static_cast<int64_t>(numRecords));
+}
+
+} // namespace
+
+static void BM_DictInsertStrKey(benchmark::State& state)
+{
+	BenchInsert<SimObj::Dict>(state, BuildStrKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_DictInsertStrKey)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_DictInsertInt64Key(benchmark::State& state)
+{
+	BenchInsert<SimObj::Dict>(state, BuildIntKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_DictInsertInt64Key)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_DictFindStrKey(benchmark::State& state)
+{
+	BenchFind<SimObj::Dict>(state, BuildStrKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_DictFindStrKey)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_DictFindInt64Key(benchmark::State& state)
+{
+	BenchFind<SimObj::Dict>(state, BuildIntKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_DictFindInt64Key)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_DictFindTupleKey(benchmark::State& state)
+{
+	BenchFind<SimObj::Dict>(state, BuildTupleKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_DictFindTupleKey)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_DictFindRawStrKey(benchmark::State& state)
+{
+	BenchFindRawStr<true>(state, static_cast<size_t>(state.range(0)));
+}
+BENCHMARK(BM_DictFindRawStrKey)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_DictFindTmpStrKey(benchmark::State& state)
+{
+	BenchFindRawStr<false>(state, static_cast<size_t>(state.range(0)));
+}
+BENCHMARK(BM_DictFindTmpStrKey)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_FlatDictInsertStrKey(benchmark::State& state)
+{
+	BenchInsert<SimObj::FlatDict>(
+		state, BuildStrKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_FlatDictInsertStrKey)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_FlatDictFindStrKey(benchmark::State& state)
+{
+	BenchFind<SimObj::FlatDict>(
+		state, BuildStrKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_FlatDictFindStrKey)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_FlatDictFindInt64Key(benchmark::State& state)
+{
+	BenchFind<SimObj::FlatDict>(
+		state, BuildIntKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_FlatDictFindInt64Key)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_SmallDictInsertStrKey(benchmark::State& state)
+{
+	BenchInsert<SimObj::SmallDict>(
+		state, BuildStrKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_SmallDictInsertStrKey)->DenseRange(2, 8, 2)->Arg(64);
+
+static void BM_SmallDictFindStrKey(benchmark::State& state)
+{
+	BenchFind<SimObj::SmallDict>(
+		state, BuildStrKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_SmallDictFindStrKey)->DenseRange(2, 8, 2)->Arg(64);
+
+static void BM_SortedDictInsertStrKey(benchmark::State& state)
+{
+	BenchInsert<SimObj::SortedDict>(
+		state, BuildStrKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_SortedDictInsertStrKey)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_SortedDictFindStrKey(benchmark::State& state)
+{
+	BenchFind<SimObj::SortedDict>(
+		state, BuildStrKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_SortedDictFindStrKey)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_DictInsertInternedKey(benchmark::State& state)
+{
+	BenchInsert<SimObj::Dict>(
+		state, BuildInternedKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_DictInsertInternedKey)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_DictFindInternedKey(benchmark::State& state)
+{
+	BenchFind<SimObj::Dict>(
+		state, BuildInternedKeys(static_cast<size_t>(state.range(0))));
+}
+BENCHMARK(BM_DictFindInternedKey)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_DictRecords(benchmark::State& state)
+{
+	BenchRecords<SimObj::Dict>(state, static_cast<size_t>(state.range(0)));
+}
+BENCHMARK(BM_DictRecords)->Arg(1000);
+
+static void BM_FlatDictRecords(benchmark::State& state)
+{
+	BenchRecords<SimObj::FlatDict>(state, static_cast<size_t>(state.range(0)));
+}
+BENCHMARK(BM_FlatDictRecords)->Arg(1000);
+
+static void BM_ShapedDictRecords(benchmark::State& state)
+{
+	BenchRecords<SimObj::ShapedDict>(state, static_cast<size_t>(state.range(0)));
+}
+BENCHMARK(BM_ShapedDictRecords)->Arg(1000);
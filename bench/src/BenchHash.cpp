@@ -0,0 +1,44 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "BenchHelpers.hpp"
+
+using namespace SimpleObjects_Bench;
+
+static void BM_BytesHash(benchmark::State& state)
+{
+	const size_t size = static_cast<size_t>(state.range(0));
+	std::vector<uint8_t> data(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		data[i] = static_cast<uint8_t>(i * 31);
+	}
+	const SimObj::Bytes bytes(data.begin(), data.end());
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(bytes.Hash());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BytesHash)->RangeMultiplier(4)->Range(4, 64 << 10);
+
+static void BM_StringHash(benchmark::State& state)
+{
+	const SimObj::String str(
+		std::string(static_cast<size_t>(state.range(0)), 'x'));
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(str.Hash());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringHash)->RangeMultiplier(4)->Range(4, 64 << 10);
@@ -0,0 +1,61 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstdint>
+
+#include <string>
+
+#include <SimpleObjects/SimpleObjects.hpp>
+
+namespace SimpleObjects_Bench
+{
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimObj = SimpleObjects;
+#else
+namespace SimObj = SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+/**
+ * @brief Build a tree with the given depth, where each inner node is a list
+ *        of `width` items, alternating between dicts and lists, and leaves
+ *        are numbers and strings
+ *
+ */
+inline SimObj::Object BuildTree(size_t depth, size_t width)
+{
+	if (depth == 0)
+	{
+		return SimObj::List({
+			SimObj::Int64(123456789),
+			SimObj::Double(1.25),
+			SimObj::String("leaf string value"),
+			SimObj::Bool(true),
+			SimObj::Null(),
+		});
+	}
+
+	if (depth % 2 == 0)
+	{
+		SimObj::List list;
+		for (size_t i = 0; i < width; ++i)
+		{
+			list.push_back(BuildTree(depth - 1, width));
+		}
+		return list;
+	}
+
+	SimObj::Dict dict;
+	for (size_t i = 0; i < width; ++i)
+	{
+		dict[SimObj::String("key" + std::to_string(i))] =
+			BuildTree(depth - 1, width);
+	}
+	return dict;
+}
+
+} // namespace SimpleObjects_Bench
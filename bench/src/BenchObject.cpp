@@ -0,0 +1,128 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include "BenchHelpers.hpp"
+
+using namespace SimpleObjects_Bench;
+
+static void BM_ObjectConstructInt64(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		SimObj::Object obj = SimObj::Int64(12345);
+		benchmark::DoNotOptimize(obj);
+	}
+}
+BENCHMARK(BM_ObjectConstructInt64);
+
+static void BM_ObjectConstructString(benchmark::State& state)
+{
+	const SimObj::String str("a short string");
+	for (auto _ : state)
+	{
+		SimObj::Object obj = str;
+		benchmark::DoNotOptimize(obj);
+	}
+}
+BENCHMARK(BM_ObjectConstructString);
+
+static void BM_ObjectCopyInt64(benchmark::State& state)
+{
+	const SimObj::Object src = SimObj::Int64(12345);
+	for (auto _ : state)
+	{
+		SimObj::Object obj = src;
+		benchmark::DoNotOptimize(obj);
+	}
+}
+BENCHMARK(BM_ObjectCopyInt64);
+
+static void BM_ObjectCopyTree(benchmark::State& state)
+{
+	const SimObj::Object src = BuildTree(static_cast<size_t>(state.range(0)), 4);
+	for (auto _ : state)
+	{
+		SimObj::Object obj = src;
+		benchmark::DoNotOptimize(obj);
+	}
+}
+BENCHMARK(BM_ObjectCopyTree)->DenseRange(1, 4);
+
+static void BM_ListPushBack(benchmark::State& state)
+{
+	const size_t num = static_cast<size_t>(state.range(0));
+	for (auto _ : state)
+	{
+		SimObj::List list;
+		for (size_t i = 0; i < num; ++i)
+		{
+			list.push_back(SimObj::Int64(static_cast<int64_t>(i)));
+		}
+		benchmark::DoNotOptimize(list);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ListPushBack)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_BytesBaseAppend(benchmark::State& state)
+{
+	const SimObj::Bytes src(
+		std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5AU));
+	const SimObj::BytesBaseObj& srcBase = src;
+	for (auto _ : state)
+	{
+		SimObj::Bytes dest;
+		SimObj::BytesBaseObj& destBase = dest;
+		destBase.Append(srcBase);
+		benchmark::DoNotOptimize(dest);
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BytesBaseAppend)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_StringBaseStartsWith(benchmark::State& state)
+{
+	const SimObj::String str(
+		std::string(static_cast<size_t>(state.range(0)), 'a'));
+	const SimObj::String prefix = str;
+	const SimObj::StringBaseObj& strBase = str;
+	const SimObj::StringBaseObj& prefixBase = prefix;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(strBase.StartsWith(prefixBase));
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringBaseStartsWith)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_BytesCountIterator(benchmark::State& state)
+{
+	const SimObj::Bytes bytes(
+		std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5AU));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(
+			std::count(bytes.cbegin(), bytes.cend(), 0x5AU));
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BytesCountIterator)->RangeMultiplier(8)->Range(8, 4096);
+
+static void BM_BytesCountNativeIterator(benchmark::State& state)
+{
+	const SimObj::Bytes bytes(
+		std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5AU));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(
+			std::count(bytes.NativeBegin(), bytes.NativeEnd(), 0x5AU));
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BytesCountNativeIterator)->RangeMultiplier(8)->Range(8, 4096);
@@ -0,0 +1,63 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <benchmark/benchmark.h>
+
+#include <tuple>
+#include <utility>
+
+#include "BenchHelpers.hpp"
+
+using namespace SimpleObjects_Bench;
+
+namespace
+{
+
+using BenchStaticDict = SimObj::StaticDict<std::tuple<
+	std::pair<SimObj::StrKey<SIMOBJ_KSTR("Name")>,    SimObj::String>,
+	std::pair<SimObj::StrKey<SIMOBJ_KSTR("Address")>, SimObj::String>,
+	std::pair<SimObj::StrKey<SIMOBJ_KSTR("Age")>,     SimObj::Int64>,
+	std::pair<SimObj::StrKey<SIMOBJ_KSTR("Score")>,   SimObj::Double>,
+	std::pair<SimObj::Int64Key<10>,                   SimObj::List>,
+	std::pair<SimObj::Int64Key<20>,                   SimObj::Bool>
+> >;
+
+} // namespace
+
+static void BM_StaticDictConstruct(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		BenchStaticDict dict;
+		auto ptr = &dict;
+		benchmark::DoNotOptimize(ptr);
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_StaticDictConstruct);
+
+static void BM_StaticDictAtStrKey(benchmark::State& state)
+{
+	BenchStaticDict dict;
+	const SimObj::String key("Score");
+	for (auto _ : state)
+	{
+		auto ptr = &dict.at(key);
+		benchmark::DoNotOptimize(ptr);
+	}
+}
+BENCHMARK(BM_StaticDictAtStrKey);
+
+static void BM_StaticDictAtInt64Key(benchmark::State& state)
+{
+	BenchStaticDict dict;
+	const SimObj::Int64 key(20);
+	for (auto _ : state)
+	{
+		auto ptr = &dict.at(key);
+		benchmark::DoNotOptimize(ptr);
+	}
+}
+BENCHMARK(BM_StaticDictAtInt64Key);
@@ -0,0 +1,55 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <benchmark/benchmark.h>
+
+#include <iterator>
+#include <string>
+
+#include "BenchHelpers.hpp"
+
+using namespace SimpleObjects_Bench;
+
+static void BM_DebugString(benchmark::State& state)
+{
+	const SimObj::Object obj = BuildTree(static_cast<size_t>(state.range(0)), 4);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(obj.DebugString());
+	}
+}
+BENCHMARK(BM_DebugString)->DenseRange(1, 4);
+
+static void BM_ToString(benchmark::State& state)
+{
+	const SimObj::Object obj = BuildTree(static_cast<size_t>(state.range(0)), 4);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(obj.ToString());
+	}
+}
+BENCHMARK(BM_ToString)->DenseRange(1, 4);
+
+static void BM_DumpString(benchmark::State& state)
+{
+	const SimObj::Object obj = BuildTree(static_cast<size_t>(state.range(0)), 4);
+	for (auto _ : state)
+	{
+		std::string out;
+		obj.DumpString(SimObj::ToOutIt<char>(std::back_inserter(out)));
+		benchmark::DoNotOptimize(out);
+	}
+}
+BENCHMARK(BM_DumpString)->DenseRange(1, 4);
+
+static void BM_JsonDump(benchmark::State& state)
+{
+	const SimObj::Object obj = BuildTree(static_cast<size_t>(state.range(0)), 4);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(SimObj::JsonWriter::Dump(obj));
+	}
+}
+BENCHMARK(BM_JsonDump)->DenseRange(1, 4);
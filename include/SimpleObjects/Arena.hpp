@@ -0,0 +1,460 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A monotonic (bump-pointer) memory arena.
+ *        Memory is carved out of large chunks, and it's never given back to
+ *        the arena individually; instead, all memory is released at once by
+ *        `Reset` or when the arena is destroyed, in time independent of the
+ *        number of allocations.
+ *
+ *        The arena is used by objects and containers in two ways:
+ *        1. Objects (i.e., subclasses of BaseObject) allocated on the heap
+ *           (e.g., by `Copy`/`Move`, or by `ObjectImpl` for payloads too large
+ *           to be stored in place) are taken from the arena that is active in
+ *           the current thread (see `ArenaScope`);
+ *        2. Containers using `ArenaAllocator` (e.g., a `ListImpl` built on
+ *           `std::vector<Object, ArenaAllocator<Object> >`) grow in the arena
+ *           that is active when the container is constructed.
+ *
+ *        When a whole object tree is built in an arena, the tree can be
+ *        dropped without running any destructor (see `Create`), and the
+ *        memory is then reclaimed by `Reset`.
+ *        It is the user's responsibility to make sure no object allocated
+ *        from the arena is accessed, or destroyed, after the arena is reset.
+ */
+class MonotonicArena
+{
+public: // static members
+
+	static constexpr size_t sk_defaultChunkSize = 4096;
+	static constexpr size_t sk_maxAlign = alignof(std::max_align_t);
+
+	/**
+	 * @brief Get the arena that is active in the current thread
+	 *
+	 * @return The pointer to the active arena, or nullptr if there is none
+	 */
+	static MonotonicArena* GetCurrent() noexcept
+	{
+		return CurrentRef();
+	}
+
+public:
+
+	explicit MonotonicArena(size_t initChunkSize = sk_defaultChunkSize) :
+		m_chunk(nullptr),
+		m_nextChunkSize(initChunkSize > 0 ? initChunkSize : 1),
+		m_allocSize(0)
+	{}
+
+	MonotonicArena(const MonotonicArena& other) = delete;
+
+	MonotonicArena(MonotonicArena&& other) = delete;
+
+	~MonotonicArena()
+	{
+		Release();
+	}
+
+	MonotonicArena& operator=(const MonotonicArena& rhs) = delete;
+
+	MonotonicArena& operator=(MonotonicArena&& rhs) = delete;
+
+	/**
+	 * @brief Allocate a block of memory from the arena
+	 *
+	 * @param size  The size of the block
+	 * @param align The alignment of the block, which must be a power of 2
+	 *              and no larger than `sk_maxAlign`
+	 * @return The pointer to the allocated memory
+	 */
+	void* Allocate(size_t size, size_t align = sk_maxAlign)
+	{
+		if ((align == 0) || (align > sk_maxAlign) || ((align & (align - 1)) != 0))
+		{
+			throw std::bad_alloc();
+		}
+
+		void* res = m_chunk != nullptr ? m_chunk->Allocate(size, align) : nullptr;
+		if (res == nullptr)
+		{
+			AddChunk(size);
+			res = m_chunk->Allocate(size, align);
+		}
+
+		m_allocSize += size;
+		return res;
+	}
+
+	/**
+	 * @brief Deallocate a block of memory; since this is a monotonic arena,
+	 *        the memory is only reclaimed when the arena is reset.
+	 *
+	 */
+	void Deallocate(void* /* ptr */, size_t /* size */) noexcept
+	{}
+
+	/**
+	 * @brief Release all memory allocated from the arena.
+	 *        The last (and the largest) chunk is kept, so that the arena can
+	 *        be reused without asking the system for memory again.
+	 *
+	 */
+	void Reset() noexcept
+	{
+		if (m_chunk != nullptr)
+		{
+			FreeChunks(m_chunk->m_prev);
+			m_chunk->m_prev = nullptr;
+			m_chunk->m_used = 0;
+		}
+		m_allocSize = 0;
+	}
+
+	/**
+	 * @brief Release all memory allocated from the arena, and give all
+	 *        chunks back to the system
+	 *
+	 */
+	void Release() noexcept
+	{
+		FreeChunks(m_chunk);
+		m_chunk = nullptr;
+		m_allocSize = 0;
+	}
+
+	/**
+	 * @brief Get the total size of memory allocated from the arena since
+	 *        the last reset
+	 *
+	 */
+	size_t GetAllocatedSize() const noexcept
+	{
+		return m_allocSize;
+	}
+
+	/**
+	 * @brief Construct an object in the arena. The object will never be
+	 *        destroyed; thus, it should only be used for object trees whose
+	 *        memory all comes from this arena, so that they can be released
+	 *        all at once by `Reset`.
+	 *
+	 * @param args The arguments passed to the constructor
+	 * @return The reference to the newly constructed object
+	 */
+	template<typename _T, typename... _Args>
+	_T& Create(_Args&&... args)
+	{
+		ArenaScopeGuard guard(*this);
+		void* ptr = Allocate(sizeof(_T), alignof(_T));
+		return *(::new (ptr) _T(std::forward<_Args>(args)...));
+	}
+
+private: // helper types and functions
+
+	friend class ArenaScope;
+
+	struct Chunk
+	{
+		Chunk* m_prev;
+		size_t m_size;
+		size_t m_used;
+
+		uint8_t* Begin() noexcept
+		{
+			return reinterpret_cast<uint8_t*>(this) + sk_headerSize;
+		}
+
+		void* Allocate(size_t size, size_t align) noexcept
+		{
+			uintptr_t begin = reinterpret_cast<uintptr_t>(Begin());
+			uintptr_t pos = begin + m_used;
+			uintptr_t aligned = (pos + (align - 1)) & ~(uintptr_t(align) - 1);
+			size_t offset = static_cast<size_t>(aligned - begin);
+
+			if ((offset > m_size) || (size > m_size - offset))
+			{
+				return nullptr;
+			}
+
+			m_used = offset + size;
+			return reinterpret_cast<void*>(aligned);
+		}
+	}; // struct Chunk
+
+	static constexpr size_t sk_headerSize =
+		((sizeof(Chunk) + sk_maxAlign - 1) / sk_maxAlign) * sk_maxAlign;
+
+	struct ArenaScopeGuard
+	{
+		ArenaScopeGuard(MonotonicArena& arena) :
+			m_prev(CurrentRef())
+		{
+			CurrentRef() = &arena;
+		}
+
+		~ArenaScopeGuard()
+		{
+			CurrentRef() = m_prev;
+		}
+
+		MonotonicArena* m_prev;
+	}; // struct ArenaScopeGuard
+
+	static MonotonicArena*& CurrentRef() noexcept
+	{
+		static thread_local MonotonicArena* s_current = nullptr;
+		return s_current;
+	}
+
+	static void FreeChunks(Chunk* chunk) noexcept
+	{
+		while (chunk != nullptr)
+		{
+			Chunk* prev = chunk->m_prev;
+			::operator delete(static_cast<void*>(chunk));
+			chunk = prev;
+		}
+	}
+
+	void AddChunk(size_t minSize)
+	{
+		size_t size = m_nextChunkSize;
+		if (size < minSize + sk_maxAlign)
+		{
+			size = minSize + sk_maxAlign;
+		}
+
+		void* mem = ::operator new(sk_headerSize + size);
+		Chunk* chunk = static_cast<Chunk*>(mem);
+		chunk->m_prev = m_chunk;
+		chunk->m_size = size;
+		chunk->m_used = 0;
+		m_chunk = chunk;
+
+		// chunks grow geometrically, so the number of chunks is
+		// logarithmic to the total size of the allocations
+		if (m_nextChunkSize <= (std::numeric_limits<size_t>::max)() / 2)
+		{
+			m_nextChunkSize *= 2;
+		}
+	}
+
+	Chunk* m_chunk;
+	size_t m_nextChunkSize;
+	size_t m_allocSize;
+
+}; // class MonotonicArena
+
+/**
+ * @brief Make the given arena active in the current thread, during the
+ *        lifetime of this scope object.
+ *        Scopes can be nested; the previously active arena is restored when
+ *        the scope ends.
+ *
+ */
+class ArenaScope
+{
+public:
+
+	explicit ArenaScope(MonotonicArena& arena) :
+		m_guard(arena)
+	{}
+
+	ArenaScope(const ArenaScope& other) = delete;
+
+	ArenaScope(ArenaScope&& other) = delete;
+
+	~ArenaScope() = default;
+
+	ArenaScope& operator=(const ArenaScope& rhs) = delete;
+
+	ArenaScope& operator=(ArenaScope&& rhs) = delete;
+
+private:
+
+	MonotonicArena::ArenaScopeGuard m_guard;
+
+}; // class ArenaScope
+
+/**
+ * @brief A standard allocator drawing memory from a MonotonicArena.
+ *        A default-constructed allocator is bound to the arena that is active
+ *        in the current thread, or to the heap if there is none.
+ *        Copies of containers (i.e., `select_on_container_copy_construction`)
+ *        follow the same rule, so that copying an object tree inside an
+ *        `ArenaScope` places the copy in that arena.
+ *
+ * @tparam _ValType The type of values being allocated
+ */
+template<typename _ValType>
+class ArenaAllocator
+{
+public: // static members
+
+	template<typename _OtherValType>
+	friend class ArenaAllocator;
+
+	typedef _ValType     value_type;
+	typedef _ValType*    pointer;
+	typedef const _ValType* const_pointer;
+	typedef size_t       size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	typedef std::false_type propagate_on_container_copy_assignment;
+	typedef std::true_type  propagate_on_container_move_assignment;
+	typedef std::true_type  propagate_on_container_swap;
+
+	template<typename _OtherValType>
+	struct rebind
+	{
+		typedef ArenaAllocator<_OtherValType> other;
+	}; // struct rebind
+
+public:
+
+	ArenaAllocator() noexcept :
+		m_arena(MonotonicArena::GetCurrent())
+	{}
+
+	explicit ArenaAllocator(MonotonicArena* arena) noexcept :
+		m_arena(arena)
+	{}
+
+	ArenaAllocator(const ArenaAllocator& other) noexcept = default;
+
+	template<typename _OtherValType>
+	ArenaAllocator(const ArenaAllocator<_OtherValType>& other) noexcept :
+		m_arena(other.m_arena)
+	{}
+
+	~ArenaAllocator() = default;
+
+	ArenaAllocator& operator=(const ArenaAllocator& rhs) noexcept = default;
+
+	_ValType* allocate(size_t n)
+	{
+		if (n > (std::numeric_limits<size_t>::max)() / sizeof(_ValType))
+		{
+			throw std::bad_alloc();
+		}
+
+		const size_t size = n * sizeof(_ValType);
+		void* ptr = m_arena != nullptr ?
+			m_arena->Allocate(size, alignof(_ValType)) :
+			::operator new(size);
+		return static_cast<_ValType*>(ptr);
+	}
+
+	void deallocate(_ValType* ptr, size_t n) noexcept
+	{
+		if (m_arena != nullptr)
+		{
+			m_arena->Deallocate(ptr, n * sizeof(_ValType));
+		}
+		else
+		{
+			::operator delete(static_cast<void*>(ptr));
+		}
+	}
+
+	ArenaAllocator select_on_container_copy_construction() const noexcept
+	{
+		return ArenaAllocator();
+	}
+
+	MonotonicArena* GetArena() const noexcept
+	{
+		return m_arena;
+	}
+
+	template<typename _OtherValType>
+	bool operator==(const ArenaAllocator<_OtherValType>& rhs) const noexcept
+	{
+		return m_arena == rhs.m_arena;
+	}
+
+	template<typename _OtherValType>
+	bool operator!=(const ArenaAllocator<_OtherValType>& rhs) const noexcept
+	{
+		return m_arena != rhs.m_arena;
+	}
+
+private:
+
+	MonotonicArena* m_arena;
+
+}; // class ArenaAllocator
+
+namespace Internal
+{
+
+/**
+ * @brief Allocate memory for an object (i.e., a subclass of BaseObject),
+ *        from the arena active in the current thread, or from the heap.
+ *        A small header is placed in front of the object to remember where
+ *        the memory came from.
+ *
+ */
+struct ObjAllocator
+{
+	static constexpr size_t sk_headerSize = MonotonicArena::sk_maxAlign;
+
+	static_assert(sizeof(MonotonicArena*) <= sk_headerSize,
+		"The header is too small to store the pointer to the arena");
+
+	static void* Allocate(size_t size)
+	{
+		MonotonicArena* arena = MonotonicArena::GetCurrent();
+		void* mem = arena != nullptr ?
+			arena->Allocate(sk_headerSize + size) :
+			::operator new(sk_headerSize + size);
+
+		*static_cast<MonotonicArena**>(mem) = arena;
+		return static_cast<uint8_t*>(mem) + sk_headerSize;
+	}
+
+	static void Deallocate(void* ptr) noexcept
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+
+		void* mem = static_cast<uint8_t*>(ptr) - sk_headerSize;
+		MonotonicArena* arena = *static_cast<MonotonicArena**>(mem);
+		if (arena != nullptr)
+		{
+			arena->Deallocate(mem, 0);
+		}
+		else
+		{
+			::operator delete(mem);
+		}
+	}
+}; // struct ObjAllocator
+
+} // namespace Internal
+
+} // namespace SimpleObjects
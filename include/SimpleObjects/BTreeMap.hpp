@@ -0,0 +1,1387 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A B-tree map, sorted by keys, which can be used as the container
+ *        type of DictImpl, in place of `std::map`.
+ *
+ *        Each node holds up to 30 pointers to key-value pairs (i.e., 256
+ *        bytes for a leaf node), so a lookup walks a few nodes and binary
+ *        searches inside each of them, instead of chasing one node per
+ *        comparison.
+ *        The pairs themselves are stored in chunks owned by the map, and
+ *        they never move once they are constructed, so splitting, merging,
+ *        and rotating nodes only moves pointers, and inserting never
+ *        invalidates references to the pairs.
+ *
+ *        When a pair is inserted at the end of a node, the node is split
+ *        unevenly, leaving the old node almost full; thus, pairs inserted
+ *        in sorted order (e.g., with `emplace_hint(end(), ...)`) are packed
+ *        densely, in amortized constant time each.
+ *
+ * @tparam _KeyType     The type of keys
+ * @tparam _ValType     The type of mapped values
+ * @tparam _CompareType The strict weak ordering of keys
+ * @tparam _Alloc       The allocator of key-value pairs; it's rebound to
+ *                      allocate the nodes and the chunks of pairs
+ */
+template<
+	typename _KeyType,
+	typename _ValType,
+	typename _CompareType = std::less<_KeyType>,
+	typename _Alloc = std::allocator<std::pair<const _KeyType, _ValType> > >
+class BTreeMap
+{
+public: // static members
+
+	using Self = BTreeMap<_KeyType, _ValType, _CompareType, _Alloc>;
+
+	typedef _KeyType                                key_type;
+	typedef _ValType                                mapped_type;
+	typedef std::pair<const _KeyType, _ValType>     value_type;
+	typedef size_t                                  size_type;
+	typedef std::ptrdiff_t                          difference_type;
+	typedef _CompareType                            key_compare;
+	typedef _Alloc                                  allocator_type;
+	typedef value_type&                             reference;
+	typedef const value_type&                       const_reference;
+	typedef value_type*                             pointer;
+	typedef const value_type*                       const_pointer;
+
+	template<bool _IsConst>
+	class IteratorImpl;
+
+	typedef IteratorImpl<false>                     iterator;
+	typedef IteratorImpl<true>                      const_iterator;
+
+	static constexpr size_t sk_maxVals = 30;
+	static constexpr size_t sk_minVals = sk_maxVals / 2;
+
+private: // static members
+
+	struct InternalNode;
+
+	struct LeafNode
+	{
+		InternalNode* m_parent;
+		uint8_t m_pos;
+		uint8_t m_count;
+		bool m_isLeaf;
+		value_type* m_vals[sk_maxVals];
+	}; // struct LeafNode
+
+	struct InternalNode : LeafNode
+	{
+		LeafNode* m_children[sk_maxVals + 1];
+	}; // struct InternalNode
+
+public:
+
+	/**
+	 * @brief The iterator walks the pairs in the order of keys
+	 *
+	 */
+	template<bool _IsConst>
+	class IteratorImpl
+	{
+	public: // static members
+
+		template<bool>
+		friend class IteratorImpl;
+
+		friend class BTreeMap;
+
+		typedef std::forward_iterator_tag           iterator_category;
+		typedef std::pair<const _KeyType, _ValType> value_type;
+		typedef std::ptrdiff_t                      difference_type;
+		typedef typename std::conditional<_IsConst,
+			const value_type*, value_type*>::type   pointer;
+		typedef typename std::conditional<_IsConst,
+			const value_type&, value_type&>::type   reference;
+
+	public:
+
+		IteratorImpl() :
+			m_node(nullptr),
+			m_idx(0)
+		{}
+
+		template<bool _OtherIsConst,
+			typename std::enable_if<
+				_IsConst && !_OtherIsConst, int>::type = 0>
+		IteratorImpl(const IteratorImpl<_OtherIsConst>& other) :
+			m_node(other.m_node),
+			m_idx(other.m_idx)
+		{}
+
+		reference operator*() const
+		{
+			return *(m_node->m_vals[m_idx]);
+		}
+
+		pointer operator->() const
+		{
+			return m_node->m_vals[m_idx];
+		}
+
+		IteratorImpl& operator++()
+		{
+			if (!m_node->m_isLeaf)
+			{
+				// the next one is the smallest in the right subtree
+				m_node = Child(m_node, m_idx + 1);
+				while (!m_node->m_isLeaf)
+				{
+					m_node = Child(m_node, 0);
+				}
+				m_idx = 0;
+				return *this;
+			}
+
+			++m_idx;
+			while (m_idx >= m_node->m_count)
+			{
+				if (m_node->m_parent == nullptr)
+				{
+					m_node = nullptr;
+					m_idx = 0;
+					return *this;
+				}
+				m_idx = m_node->m_pos;
+				m_node = m_node->m_parent;
+			}
+			return *this;
+		}
+
+		IteratorImpl operator++(int)
+		{
+			IteratorImpl tmp(*this);
+			++(*this);
+			return tmp;
+		}
+
+		bool operator==(const IteratorImpl& rhs) const
+		{
+			return (m_node == rhs.m_node) && (m_idx == rhs.m_idx);
+		}
+
+		bool operator!=(const IteratorImpl& rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+	private:
+
+		IteratorImpl(const LeafNode* node, size_t idx) :
+			m_node(node),
+			m_idx(idx)
+		{}
+
+		const LeafNode* m_node;
+		size_t m_idx;
+
+	}; // class IteratorImpl
+
+public:
+
+	BTreeMap() :
+		BTreeMap(allocator_type())
+	{}
+
+	explicit BTreeMap(const allocator_type& alloc) :
+		m_alloc(alloc),
+		m_comp(),
+		m_root(nullptr),
+		m_size(0),
+		m_lastChunk(nullptr),
+		m_numChunks(0),
+		m_chunkUsed(0),
+		m_freeSlots(nullptr)
+	{}
+
+	BTreeMap(
+		std::initializer_list<value_type> l,
+		const allocator_type& alloc = allocator_type()) :
+		BTreeMap(l.begin(), l.end(), alloc)
+	{}
+
+	/**
+	 * @brief Construct from a range of key-value pairs; it takes linear time
+	 *        if the range is sorted by keys
+	 *
+	 */
+	template<typename _ItType>
+	BTreeMap(
+		_ItType begin, _ItType end,
+		const allocator_type& alloc = allocator_type()) :
+		BTreeMap(alloc)
+	{
+		try
+		{
+			insert(begin, end);
+		}
+		catch(...)
+		{
+			Release();
+			throw;
+		}
+	}
+
+	BTreeMap(const Self& other) :
+		BTreeMap(
+			other,
+			AllocTraits::select_on_container_copy_construction(other.m_alloc))
+	{}
+
+	BTreeMap(const Self& other, const allocator_type& alloc) :
+		BTreeMap(alloc)
+	{
+		m_comp = other.m_comp;
+		CopyFrom(other);
+	}
+
+	BTreeMap(Self&& other) noexcept :
+		m_alloc(other.m_alloc),
+		m_comp(std::move(other.m_comp)),
+		m_root(other.m_root),
+		m_size(other.m_size),
+		m_lastChunk(other.m_lastChunk),
+		m_numChunks(other.m_numChunks),
+		m_chunkUsed(other.m_chunkUsed),
+		m_freeSlots(other.m_freeSlots)
+	{
+		other.Forget();
+	}
+
+	~BTreeMap()
+	{
+		Release();
+	}
+
+	Self& operator=(const Self& rhs)
+	{
+		if (this != &rhs)
+		{
+			Release();
+			AssignAlloc(m_alloc, rhs.m_alloc,
+				typename AllocTraits::propagate_on_container_copy_assignment());
+			m_comp = rhs.m_comp;
+			CopyFrom(rhs);
+		}
+		return *this;
+	}
+
+	Self& operator=(Self&& rhs)
+	{
+		if (this != &rhs)
+		{
+			Release();
+			m_comp = std::move(rhs.m_comp);
+			if (AllocTraits::propagate_on_container_move_assignment::value ||
+				(m_alloc == rhs.m_alloc))
+			{
+				AssignAlloc(m_alloc, rhs.m_alloc,
+					typename AllocTraits::propagate_on_container_move_assignment());
+				m_root = rhs.m_root;
+				m_size = rhs.m_size;
+				m_lastChunk = rhs.m_lastChunk;
+				m_numChunks = rhs.m_numChunks;
+				m_chunkUsed = rhs.m_chunkUsed;
+				m_freeSlots = rhs.m_freeSlots;
+				rhs.Forget();
+			}
+			else
+			{
+				// the memory can't be taken over by a different allocator
+				CopyFrom(rhs);
+			}
+		}
+		return *this;
+	}
+
+	allocator_type get_allocator() const
+	{
+		return m_alloc;
+	}
+
+	key_compare key_comp() const
+	{
+		return m_comp;
+	}
+
+	// ========== capacity ==========
+
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	size_t size() const
+	{
+		return m_size;
+	}
+
+	// ========== iterators ==========
+
+	iterator begin()
+	{
+		return iterator(Leftmost(), 0);
+	}
+
+	iterator end()
+	{
+		return iterator();
+	}
+
+	const_iterator begin() const
+	{
+		return cbegin();
+	}
+
+	const_iterator end() const
+	{
+		return cend();
+	}
+
+	const_iterator cbegin() const
+	{
+		return const_iterator(Leftmost(), 0);
+	}
+
+	const_iterator cend() const
+	{
+		return const_iterator();
+	}
+
+	// ========== lookup ==========
+
+	iterator find(const key_type& key)
+	{
+		return ToMutableIt(FindImpl(key));
+	}
+
+	const_iterator find(const key_type& key) const
+	{
+		return FindImpl(key);
+	}
+
+	size_t count(const key_type& key) const
+	{
+		return find(key) == cend() ? 0 : 1;
+	}
+
+	mapped_type& at(const key_type& key)
+	{
+		auto it = find(key);
+		if (it == end())
+		{
+			throw std::out_of_range("BTreeMap::at - key not found");
+		}
+		return it->second;
+	}
+
+	const mapped_type& at(const key_type& key) const
+	{
+		auto it = find(key);
+		if (it == cend())
+		{
+			throw std::out_of_range("BTreeMap::at - key not found");
+		}
+		return it->second;
+	}
+
+	mapped_type& operator[](const key_type& key)
+	{
+		return EmplaceImpl(key).first->second;
+	}
+
+	mapped_type& operator[](key_type&& key)
+	{
+		return EmplaceImpl(std::forward<key_type>(key)).first->second;
+	}
+
+	/**
+	 * @brief Find the first pair whose key is not less than `key`
+	 *
+	 */
+	iterator lower_bound(const key_type& key)
+	{
+		return ToMutableIt(BoundImpl<false>(key));
+	}
+
+	const_iterator lower_bound(const key_type& key) const
+	{
+		return BoundImpl<false>(key);
+	}
+
+	/**
+	 * @brief Find the first pair whose key is greater than `key`
+	 *
+	 */
+	iterator upper_bound(const key_type& key)
+	{
+		return ToMutableIt(BoundImpl<true>(key));
+	}
+
+	const_iterator upper_bound(const key_type& key) const
+	{
+		return BoundImpl<true>(key);
+	}
+
+	// ========== modifiers ==========
+
+	/**
+	 * @brief Insert a key-value pair, with the mapped value constructed from
+	 *        `args`, if the key is not in the map yet; nothing is constructed
+	 *        if the key already exists
+	 *
+	 */
+	template<typename... _Args>
+	std::pair<iterator, bool> emplace(const key_type& key, _Args&&... args)
+	{
+		return EmplaceImpl(key, std::forward<_Args>(args)...);
+	}
+
+	template<typename... _Args>
+	std::pair<iterator, bool> emplace(key_type&& key, _Args&&... args)
+	{
+		return EmplaceImpl(
+			std::forward<key_type>(key), std::forward<_Args>(args)...);
+	}
+
+	/**
+	 * @brief Same as `emplace`, except that if `hint` is `end()` and `key`
+	 *        is greater than all keys in the map, the pair is appended to
+	 *        the last node without searching
+	 *
+	 */
+	template<typename _KArgType, typename... _Args>
+	iterator emplace_hint(
+		const_iterator hint, _KArgType&& key, _Args&&... args)
+	{
+		if ((hint == cend()) && (m_root != nullptr))
+		{
+			LeafNode* last = Rightmost();
+			if (m_comp(last->m_vals[last->m_count - 1]->first, key))
+			{
+				return EmplaceAt(last, last->m_count,
+					std::forward<_KArgType>(key),
+					std::forward<_Args>(args)...);
+			}
+		}
+		return EmplaceImpl(
+			std::forward<_KArgType>(key),
+			std::forward<_Args>(args)...).first;
+	}
+
+	std::pair<iterator, bool> insert(const value_type& val)
+	{
+		return EmplaceImpl(val.first, val.second);
+	}
+
+	template<typename _PairType>
+	std::pair<iterator, bool> insert(_PairType&& val)
+	{
+		return EmplaceImpl(
+			std::forward<_PairType>(val).first,
+			std::forward<_PairType>(val).second);
+	}
+
+	template<typename _ItType>
+	void insert(_ItType begin, _ItType end)
+	{
+		for (; begin != end; ++begin)
+		{
+			emplace_hint(cend(), begin->first, begin->second);
+		}
+	}
+
+	size_t erase(const key_type& key)
+	{
+		const_iterator it = find(key);
+		if (it == cend())
+		{
+			return 0;
+		}
+		EraseAt(const_cast<LeafNode*>(it.m_node), it.m_idx);
+		return 1;
+	}
+
+	iterator erase(const_iterator it)
+	{
+		const_iterator next = it;
+		++next;
+		if (next == cend())
+		{
+			EraseAt(const_cast<LeafNode*>(it.m_node), it.m_idx);
+			return end();
+		}
+
+		// the next pair doesn't move, but its node may change after the
+		// rebalancing, so it's searched again
+		const value_type* nextVal = &(*next);
+		EraseAt(const_cast<LeafNode*>(it.m_node), it.m_idx);
+		return find(nextVal->first);
+	}
+
+	iterator erase(iterator it)
+	{
+		return erase(const_iterator(it));
+	}
+
+	void clear()
+	{
+		Release();
+	}
+
+	void swap(Self& other)
+	{
+		using std::swap;
+		SwapAlloc(m_alloc, other.m_alloc,
+			typename AllocTraits::propagate_on_container_swap());
+		swap(m_comp, other.m_comp);
+		swap(m_root, other.m_root);
+		swap(m_size, other.m_size);
+		swap(m_lastChunk, other.m_lastChunk);
+		swap(m_numChunks, other.m_numChunks);
+		swap(m_chunkUsed, other.m_chunkUsed);
+		swap(m_freeSlots, other.m_freeSlots);
+	}
+
+	// ========== operators ==========
+
+	/**
+	 * @brief Two maps are equal if they have the same pairs, in order
+	 *
+	 */
+	bool operator==(const Self& rhs) const
+	{
+		if (m_size != rhs.m_size)
+		{
+			return false;
+		}
+		for (auto it = cbegin(), jt = rhs.cbegin(); it != cend(); ++it, ++jt)
+		{
+			if (!(it->first == jt->first) || !(it->second == jt->second))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool operator!=(const Self& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+private: // static members
+
+	using AllocTraits = std::allocator_traits<allocator_type>;
+
+	static_assert(sk_maxVals < 256 && sk_minVals > 0,
+		"The number of values in a node must fit in uint8_t");
+
+	/**
+	 * @brief The storage of a key-value pair; a free slot links to the next
+	 *        free one
+	 *
+	 */
+	union ValSlot
+	{
+		ValSlot* m_next;
+		alignas(value_type) unsigned char m_val[sizeof(value_type)];
+	}; // union ValSlot
+
+	/**
+	 * @brief The nodes allocated ahead of an insertion, so that splitting
+	 *        the nodes can't fail halfway; internal nodes are linked through
+	 *        `m_parent`
+	 *
+	 */
+	struct SpareNodes
+	{
+		LeafNode* m_leaf;
+		InternalNode* m_internals;
+	}; // struct SpareNodes
+
+	using LeafAlloc =
+		typename AllocTraits::template rebind_alloc<LeafNode>;
+	using LeafAllocTraits =
+		typename AllocTraits::template rebind_traits<LeafNode>;
+	using InternalAlloc =
+		typename AllocTraits::template rebind_alloc<InternalNode>;
+	using InternalAllocTraits =
+		typename AllocTraits::template rebind_traits<InternalNode>;
+	using SlotAlloc =
+		typename AllocTraits::template rebind_alloc<ValSlot>;
+	using SlotAllocTraits =
+		typename AllocTraits::template rebind_traits<ValSlot>;
+
+	static constexpr size_t sk_firstChunkSize = 16;
+	static constexpr size_t sk_maxChunkShift = 10;
+
+	/**
+	 * @brief The number of slots in the chunk at `idx`; the first slot of
+	 *        each chunk links to the previous chunk
+	 *
+	 */
+	static size_t ChunkSize(size_t idx)
+	{
+		return sk_firstChunkSize <<
+			(idx < sk_maxChunkShift ? idx : sk_maxChunkShift);
+	}
+
+	static LeafNode* Child(const LeafNode* node, size_t idx)
+	{
+		return static_cast<const InternalNode*>(node)->m_children[idx];
+	}
+
+	static void SetChild(InternalNode* node, size_t idx, LeafNode* child)
+	{
+		node->m_children[idx] = child;
+		child->m_parent = node;
+		child->m_pos = static_cast<uint8_t>(idx);
+	}
+
+	static iterator ToMutableIt(const_iterator it)
+	{
+		return iterator(it.m_node, it.m_idx);
+	}
+
+	static void AssignAlloc(
+		allocator_type& dst, const allocator_type& src, std::true_type)
+	{
+		dst = src;
+	}
+
+	static void AssignAlloc(
+		allocator_type&, const allocator_type&, std::false_type)
+	{}
+
+	static void SwapAlloc(allocator_type& a, allocator_type& b, std::true_type)
+	{
+		using std::swap;
+		swap(a, b);
+	}
+
+	static void SwapAlloc(allocator_type&, allocator_type&, std::false_type)
+	{}
+
+private:
+
+	/**
+	 * @brief The index of the first value in `node` whose key is not less
+	 *        than `key` (or greater than `key`, if `_Upper` is set)
+	 *
+	 */
+	template<bool _Upper>
+	size_t SearchNode(const LeafNode* node, const key_type& key) const
+	{
+		size_t lo = 0;
+		size_t hi = node->m_count;
+		while (lo < hi)
+		{
+			const size_t mid = lo + ((hi - lo) / 2);
+			const bool goRight = _Upper ?
+				!m_comp(key, node->m_vals[mid]->first) :
+				m_comp(node->m_vals[mid]->first, key);
+			if (goRight)
+			{
+				lo = mid + 1;
+			}
+			else
+			{
+				hi = mid;
+			}
+		}
+		return lo;
+	}
+
+	const_iterator FindImpl(const key_type& key) const
+	{
+		const LeafNode* node = m_root;
+		while (node != nullptr)
+		{
+			const size_t idx = SearchNode<false>(node, key);
+			if ((idx < node->m_count) &&
+				!m_comp(key, node->m_vals[idx]->first))
+			{
+				return const_iterator(node, idx);
+			}
+			node = node->m_isLeaf ? nullptr : Child(node, idx);
+		}
+		return cend();
+	}
+
+	template<bool _Upper>
+	const_iterator BoundImpl(const key_type& key) const
+	{
+		// the candidates found deeper in the tree are smaller
+		const_iterator res = cend();
+		const LeafNode* node = m_root;
+		while (node != nullptr)
+		{
+			const size_t idx = SearchNode<_Upper>(node, key);
+			if (idx < node->m_count)
+			{
+				res = const_iterator(node, idx);
+			}
+			node = node->m_isLeaf ? nullptr : Child(node, idx);
+		}
+		return res;
+	}
+
+	LeafNode* Leftmost() const
+	{
+		LeafNode* node = m_root;
+		while ((node != nullptr) && !node->m_isLeaf)
+		{
+			node = Child(node, 0);
+		}
+		return node;
+	}
+
+	LeafNode* Rightmost() const
+	{
+		LeafNode* node = m_root;
+		while ((node != nullptr) && !node->m_isLeaf)
+		{
+			node = Child(node, node->m_count);
+		}
+		return node;
+	}
+
+	template<typename _KArgType, typename... _Args>
+	std::pair<iterator, bool> EmplaceImpl(_KArgType&& key, _Args&&... args)
+	{
+		LeafNode* node = m_root;
+		while (node != nullptr)
+		{
+			const size_t idx = SearchNode<false>(node, key);
+			if ((idx < node->m_count) &&
+				!m_comp(key, node->m_vals[idx]->first))
+			{
+				return std::make_pair(iterator(node, idx), false);
+			}
+			if (node->m_isLeaf)
+			{
+				return std::make_pair(
+					EmplaceAt(node, idx,
+						std::forward<_KArgType>(key),
+						std::forward<_Args>(args)...),
+					true);
+			}
+			node = Child(node, idx);
+		}
+		return std::make_pair(
+			EmplaceAt(nullptr, 0,
+				std::forward<_KArgType>(key),
+				std::forward<_Args>(args)...),
+			true);
+	}
+
+	/**
+	 * @brief Construct a pair, and insert it into the leaf at `pos`; the
+	 *        memory needed is allocated before the tree is modified, so the
+	 *        map is left untouched if anything throws
+	 *
+	 * @param leaf The leaf node to insert into, or `nullptr` if the map is
+	 *             empty
+	 */
+	template<typename _KArgType, typename... _Args>
+	iterator EmplaceAt(
+		LeafNode* leaf, size_t pos, _KArgType&& key, _Args&&... args)
+	{
+		ValSlot* slot = AcquireSlot();
+		value_type* val = reinterpret_cast<value_type*>(slot->m_val);
+		try
+		{
+			AllocTraits::construct(m_alloc, val,
+				std::piecewise_construct,
+				std::forward_as_tuple(std::forward<_KArgType>(key)),
+				std::forward_as_tuple(std::forward<_Args>(args)...));
+		}
+		catch(...)
+		{
+			ReleaseSlot(slot);
+			throw;
+		}
+
+		SpareNodes spares = { nullptr, nullptr };
+		try
+		{
+			AllocSpares(leaf, spares);
+		}
+		catch(...)
+		{
+			AllocTraits::destroy(m_alloc, val);
+			ReleaseSlot(slot);
+			throw;
+		}
+
+		if (leaf == nullptr)
+		{
+			leaf = spares.m_leaf;
+			spares.m_leaf = nullptr;
+			leaf->m_parent = nullptr;
+			leaf->m_pos = 0;
+			m_root = leaf;
+		}
+		auto loc = InsertAt(leaf, pos, val, nullptr, spares);
+		++m_size;
+		return iterator(loc.first, loc.second);
+	}
+
+	/**
+	 * @brief Allocate the nodes needed to split the full nodes on the path
+	 *        from `leaf` to the root
+	 *
+	 */
+	void AllocSpares(const LeafNode* leaf, SpareNodes& spares)
+	{
+		try
+		{
+			if (leaf == nullptr || leaf->m_count == sk_maxVals)
+			{
+				spares.m_leaf = NewNode<true>();
+			}
+			if (leaf == nullptr)
+			{
+				return;
+			}
+
+			const LeafNode* node = leaf;
+			while ((node != nullptr) && (node->m_count == sk_maxVals))
+			{
+				if (!node->m_isLeaf)
+				{
+					PushSpare(spares);
+				}
+				node = node->m_parent;
+			}
+			if ((node == nullptr) && (leaf->m_count == sk_maxVals))
+			{
+				// the root is split, so a new root is needed
+				PushSpare(spares);
+			}
+		}
+		catch(...)
+		{
+			FreeSpares(spares);
+			throw;
+		}
+	}
+
+	void PushSpare(SpareNodes& spares)
+	{
+		InternalNode* node = static_cast<InternalNode*>(NewNode<false>());
+		node->m_parent = spares.m_internals;
+		spares.m_internals = node;
+	}
+
+	LeafNode* PopSpare(SpareNodes& spares, bool isLeaf)
+	{
+		LeafNode* node = nullptr;
+		if (isLeaf)
+		{
+			node = spares.m_leaf;
+			spares.m_leaf = nullptr;
+		}
+		else
+		{
+			node = spares.m_internals;
+			spares.m_internals = spares.m_internals->m_parent;
+		}
+		node->m_parent = nullptr;
+		node->m_count = 0;
+		return node;
+	}
+
+	void FreeSpares(SpareNodes& spares)
+	{
+		if (spares.m_leaf != nullptr)
+		{
+			FreeNode(spares.m_leaf);
+			spares.m_leaf = nullptr;
+		}
+		while (spares.m_internals != nullptr)
+		{
+			InternalNode* node = spares.m_internals;
+			spares.m_internals = node->m_parent;
+			FreeNode(node);
+		}
+	}
+
+	/**
+	 * @brief Insert `val` into `node` at `pos`, with `right` as its right
+	 *        child if `node` is an internal node; a full node is split, and
+	 *        the value in the middle is moved up to the parent
+	 *
+	 * @return The node and the index where `val` is placed
+	 */
+	std::pair<LeafNode*, size_t> InsertAt(
+		LeafNode* node, size_t pos,
+		value_type* val, LeafNode* right,
+		SpareNodes& spares)
+	{
+		const size_t count = node->m_count;
+		if (count < sk_maxVals)
+		{
+			for (size_t i = count; i > pos; --i)
+			{
+				node->m_vals[i] = node->m_vals[i - 1];
+			}
+			node->m_vals[pos] = val;
+			if (!node->m_isLeaf)
+			{
+				InternalNode* inode = static_cast<InternalNode*>(node);
+				for (size_t i = count + 1; i > pos + 1; --i)
+				{
+					SetChild(inode, i, inode->m_children[i - 1]);
+				}
+				SetChild(inode, pos + 1, right);
+			}
+			node->m_count = static_cast<uint8_t>(count + 1);
+			return std::make_pair(node, pos);
+		}
+
+		value_type* vals[sk_maxVals + 1];
+		LeafNode* children[sk_maxVals + 2];
+		for (size_t i = 0, j = 0; i <= sk_maxVals; ++i)
+		{
+			vals[i] = (i == pos) ? val : node->m_vals[j++];
+		}
+		if (!node->m_isLeaf)
+		{
+			const InternalNode* inode = static_cast<InternalNode*>(node);
+			for (size_t i = 0, j = 0; i <= sk_maxVals + 1; ++i)
+			{
+				children[i] = (i == pos + 1) ? right : inode->m_children[j++];
+			}
+		}
+
+		// appending to a node leaves it almost full, so that the nodes built
+		// from sorted input are packed
+		const size_t leftCount = (pos == count) ?
+			(sk_maxVals - 1) :
+			((sk_maxVals + 1) / 2);
+		const size_t rightCount = sk_maxVals - leftCount;
+
+		if (node->m_parent == nullptr)
+		{
+			InternalNode* root =
+				static_cast<InternalNode*>(PopSpare(spares, false));
+			root->m_pos = 0;
+			SetChild(root, 0, node);
+			m_root = root;
+		}
+		LeafNode* sibling = PopSpare(spares, node->m_isLeaf);
+
+		for (size_t i = 0; i < leftCount; ++i)
+		{
+			node->m_vals[i] = vals[i];
+		}
+		for (size_t i = 0; i < rightCount; ++i)
+		{
+			sibling->m_vals[i] = vals[leftCount + 1 + i];
+		}
+		if (!node->m_isLeaf)
+		{
+			InternalNode* inode = static_cast<InternalNode*>(node);
+			InternalNode* isibling = static_cast<InternalNode*>(sibling);
+			for (size_t i = 0; i <= leftCount; ++i)
+			{
+				SetChild(inode, i, children[i]);
+			}
+			for (size_t i = 0; i <= rightCount; ++i)
+			{
+				SetChild(isibling, i, children[leftCount + 1 + i]);
+			}
+		}
+		node->m_count = static_cast<uint8_t>(leftCount);
+		sibling->m_count = static_cast<uint8_t>(rightCount);
+
+		auto midLoc = InsertAt(
+			node->m_parent, node->m_pos, vals[leftCount], sibling, spares);
+		if (pos < leftCount)
+		{
+			return std::make_pair(node, pos);
+		}
+		else if (pos == leftCount)
+		{
+			return midLoc;
+		}
+		return std::make_pair(sibling, pos - leftCount - 1);
+	}
+
+	/**
+	 * @brief Remove the value at `idx` of `node`; a value in an internal
+	 *        node is replaced by its predecessor, which is always in a leaf
+	 *
+	 */
+	void EraseAt(LeafNode* node, size_t idx)
+	{
+		value_type* victim = node->m_vals[idx];
+		if (!node->m_isLeaf)
+		{
+			LeafNode* leaf = Child(node, idx);
+			while (!leaf->m_isLeaf)
+			{
+				leaf = Child(leaf, leaf->m_count);
+			}
+			node->m_vals[idx] = leaf->m_vals[leaf->m_count - 1];
+			node = leaf;
+			idx = leaf->m_count - 1;
+		}
+
+		for (size_t i = idx + 1; i < node->m_count; ++i)
+		{
+			node->m_vals[i - 1] = node->m_vals[i];
+		}
+		--(node->m_count);
+		--m_size;
+
+		AllocTraits::destroy(m_alloc, victim);
+		ReleaseSlot(reinterpret_cast<ValSlot*>(victim));
+
+		Rebalance(node);
+	}
+
+	/**
+	 * @brief Refill the nodes with too few values, from `node` up to the
+	 *        root, by borrowing a value from a sibling, or merging with it
+	 *
+	 */
+	void Rebalance(LeafNode* node)
+	{
+		while ((node != m_root) && (node->m_count < sk_minVals))
+		{
+			InternalNode* parent = node->m_parent;
+			const size_t pos = node->m_pos;
+			LeafNode* left = pos > 0 ?
+				parent->m_children[pos - 1] : nullptr;
+			LeafNode* right = pos < parent->m_count ?
+				parent->m_children[pos + 1] : nullptr;
+
+			if ((left != nullptr) && (left->m_count > sk_minVals))
+			{
+				RotateRight(parent, pos - 1);
+				return;
+			}
+			if ((right != nullptr) && (right->m_count > sk_minVals))
+			{
+				RotateLeft(parent, pos);
+				return;
+			}
+			Merge(parent, (left != nullptr) ? (pos - 1) : pos);
+			node = parent;
+		}
+
+		if (m_root->m_count == 0)
+		{
+			LeafNode* oldRoot = m_root;
+			if (oldRoot->m_isLeaf)
+			{
+				m_root = nullptr;
+			}
+			else
+			{
+				m_root = Child(oldRoot, 0);
+				m_root->m_parent = nullptr;
+				m_root->m_pos = 0;
+			}
+			FreeNode(oldRoot);
+		}
+	}
+
+	/**
+	 * @brief Move the last value of the child at `sep` up to the parent, and
+	 *        the separator down to the front of the child at `sep + 1`
+	 *
+	 */
+	void RotateRight(InternalNode* parent, size_t sep)
+	{
+		LeafNode* left = parent->m_children[sep];
+		LeafNode* right = parent->m_children[sep + 1];
+
+		for (size_t i = right->m_count; i > 0; --i)
+		{
+			right->m_vals[i] = right->m_vals[i - 1];
+		}
+		right->m_vals[0] = parent->m_vals[sep];
+		parent->m_vals[sep] = left->m_vals[left->m_count - 1];
+		if (!right->m_isLeaf)
+		{
+			InternalNode* iright = static_cast<InternalNode*>(right);
+			for (size_t i = right->m_count + 1; i > 0; --i)
+			{
+				SetChild(iright, i, iright->m_children[i - 1]);
+			}
+			SetChild(iright, 0, Child(left, left->m_count));
+		}
+		--(left->m_count);
+		++(right->m_count);
+	}
+
+	/**
+	 * @brief Move the first value of the child at `sep + 1` up to the parent,
+	 *        and the separator down to the end of the child at `sep`
+	 *
+	 */
+	void RotateLeft(InternalNode* parent, size_t sep)
+	{
+		LeafNode* left = parent->m_children[sep];
+		LeafNode* right = parent->m_children[sep + 1];
+
+		left->m_vals[left->m_count] = parent->m_vals[sep];
+		parent->m_vals[sep] = right->m_vals[0];
+		for (size_t i = 1; i < right->m_count; ++i)
+		{
+			right->m_vals[i - 1] = right->m_vals[i];
+		}
+		if (!left->m_isLeaf)
+		{
+			InternalNode* ileft = static_cast<InternalNode*>(left);
+			InternalNode* iright = static_cast<InternalNode*>(right);
+			SetChild(ileft, left->m_count + 1, iright->m_children[0]);
+			for (size_t i = 1; i <= right->m_count; ++i)
+			{
+				SetChild(iright, i - 1, iright->m_children[i]);
+			}
+		}
+		++(left->m_count);
+		--(right->m_count);
+	}
+
+	/**
+	 * @brief Merge the child at `sep + 1`, and the separator, into the child
+	 *        at `sep`
+	 *
+	 */
+	void Merge(InternalNode* parent, size_t sep)
+	{
+		LeafNode* left = parent->m_children[sep];
+		LeafNode* right = parent->m_children[sep + 1];
+		const size_t leftCount = left->m_count;
+
+		left->m_vals[leftCount] = parent->m_vals[sep];
+		for (size_t i = 0; i < right->m_count; ++i)
+		{
+			left->m_vals[leftCount + 1 + i] = right->m_vals[i];
+		}
+		if (!left->m_isLeaf)
+		{
+			InternalNode* ileft = static_cast<InternalNode*>(left);
+			InternalNode* iright = static_cast<InternalNode*>(right);
+			for (size_t i = 0; i <= right->m_count; ++i)
+			{
+				SetChild(ileft, leftCount + 1 + i, iright->m_children[i]);
+			}
+		}
+		left->m_count = static_cast<uint8_t>(leftCount + 1 + right->m_count);
+
+		for (size_t i = sep + 1; i < parent->m_count; ++i)
+		{
+			parent->m_vals[i - 1] = parent->m_vals[i];
+			SetChild(parent, i, parent->m_children[i + 1]);
+		}
+		--(parent->m_count);
+
+		FreeNode(right);
+	}
+
+	template<bool _IsLeaf>
+	LeafNode* NewNode()
+	{
+		LeafNode* node = nullptr;
+		if (_IsLeaf)
+		{
+			LeafAlloc leafAlloc(m_alloc);
+			node = LeafAllocTraits::allocate(leafAlloc, 1);
+			LeafAllocTraits::construct(leafAlloc, node);
+		}
+		else
+		{
+			InternalAlloc internalAlloc(m_alloc);
+			InternalNode* inode = InternalAllocTraits::allocate(internalAlloc, 1);
+			InternalAllocTraits::construct(internalAlloc, inode);
+			node = inode;
+		}
+		node->m_isLeaf = _IsLeaf;
+		return node;
+	}
+
+	void FreeNode(LeafNode* node)
+	{
+		if (node->m_isLeaf)
+		{
+			LeafAlloc leafAlloc(m_alloc);
+			LeafAllocTraits::destroy(leafAlloc, node);
+			LeafAllocTraits::deallocate(leafAlloc, node, 1);
+		}
+		else
+		{
+			InternalAlloc internalAlloc(m_alloc);
+			InternalNode* inode = static_cast<InternalNode*>(node);
+			InternalAllocTraits::destroy(internalAlloc, inode);
+			InternalAllocTraits::deallocate(internalAlloc, inode, 1);
+		}
+	}
+
+	ValSlot* AcquireSlot()
+	{
+		if (m_freeSlots != nullptr)
+		{
+			ValSlot* slot = m_freeSlots;
+			m_freeSlots = slot->m_next;
+			return slot;
+		}
+
+		if ((m_lastChunk == nullptr) ||
+			(m_chunkUsed == ChunkSize(m_numChunks - 1)))
+		{
+			SlotAlloc slotAlloc(m_alloc);
+			ValSlot* chunk = SlotAllocTraits::allocate(
+				slotAlloc, ChunkSize(m_numChunks));
+			chunk[0].m_next = m_lastChunk;
+			m_lastChunk = chunk;
+			++m_numChunks;
+			m_chunkUsed = 1;
+		}
+		return m_lastChunk + (m_chunkUsed++);
+	}
+
+	void ReleaseSlot(ValSlot* slot)
+	{
+		slot->m_next = m_freeSlots;
+		m_freeSlots = slot;
+	}
+
+	/**
+	 * @brief Copy the pairs of `other` in order, which packs the nodes; this
+	 *        map must be empty
+	 *
+	 */
+	void CopyFrom(const Self& other)
+	{
+		try
+		{
+			for (const auto& item : other)
+			{
+				LeafNode* last = Rightmost();
+				EmplaceAt(last, last != nullptr ? last->m_count : 0,
+					item.first, item.second);
+			}
+		}
+		catch(...)
+		{
+			Release();
+			throw;
+		}
+	}
+
+	void DestroyNode(LeafNode* node)
+	{
+		for (size_t i = 0; i < node->m_count; ++i)
+		{
+			AllocTraits::destroy(m_alloc, node->m_vals[i]);
+		}
+		if (!node->m_isLeaf)
+		{
+			for (size_t i = 0; i <= node->m_count; ++i)
+			{
+				DestroyNode(Child(node, i));
+			}
+		}
+		FreeNode(node);
+	}
+
+	void Release()
+	{
+		if (m_root != nullptr)
+		{
+			DestroyNode(m_root);
+		}
+
+		SlotAlloc slotAlloc(m_alloc);
+		for (size_t i = m_numChunks; i > 0; --i)
+		{
+			ValSlot* chunk = m_lastChunk;
+			m_lastChunk = chunk[0].m_next;
+			SlotAllocTraits::deallocate(slotAlloc, chunk, ChunkSize(i - 1));
+		}
+
+		Forget();
+	}
+
+	/**
+	 * @brief Drop the references to the memory, which has been released or
+	 *        taken over by another map
+	 *
+	 */
+	void Forget()
+	{
+		m_root = nullptr;
+		m_size = 0;
+		m_lastChunk = nullptr;
+		m_numChunks = 0;
+		m_chunkUsed = 0;
+		m_freeSlots = nullptr;
+	}
+
+	allocator_type m_alloc;
+	key_compare m_comp;
+	LeafNode* m_root;
+	size_t m_size;
+	ValSlot* m_lastChunk;
+	size_t m_numChunks;
+	size_t m_chunkUsed;
+	ValSlot* m_freeSlots;
+
+}; // class BTreeMap
+
+template<typename _KeyType, typename _ValType,
+	typename _CompareType, typename _Alloc>
+constexpr size_t BTreeMap<_KeyType, _ValType,
+	_CompareType, _Alloc>::sk_maxVals;
+
+template<typename _KeyType, typename _ValType,
+	typename _CompareType, typename _Alloc>
+constexpr size_t BTreeMap<_KeyType, _ValType,
+	_CompareType, _Alloc>::sk_minVals;
+
+template<typename _KeyType, typename _ValType,
+	typename _CompareType, typename _Alloc>
+constexpr size_t BTreeMap<_KeyType, _ValType,
+	_CompareType, _Alloc>::sk_firstChunkSize;
+
+template<typename _KeyType, typename _ValType,
+	typename _CompareType, typename _Alloc>
+constexpr size_t BTreeMap<_KeyType, _ValType,
+	_CompareType, _Alloc>::sk_maxChunkShift;
+
+} // namespace SimpleObjects
@@ -8,6 +8,7 @@
 #include <functional>
 #include <string>
 
+#include "Arena.hpp"
 #include "BasicDefs.hpp"
 #include "Compare.hpp"
 #include "Exception.hpp"
@@ -34,6 +35,8 @@ template<typename _KeyType, typename _ValType, typename _ToStringType>
 class DictBaseObject;
 template<typename _ValType, typename _ToStringType>
 class BytesBaseObject;
+template<typename _ValBaseType, typename _ToStringType>
+class TupleBaseObject;
 template<
 	typename _DynKeyType,
 	typename _DynValType,
@@ -77,6 +80,9 @@ public: // Static members:
 											std::reference_wrapper,
 											ToStringType>;
 
+	using TupleBase     = TupleBaseObject<HashableBaseObject<ToStringType>,
+										ToStringType>;
+
 	static constexpr Self* sk_null = nullptr;
 
 public:
@@ -91,6 +97,32 @@ public:
 	virtual ~BaseObject() = default;
 	// LCOV_EXCL_STOP
 
+	// ========== Memory allocation ==========
+
+	/**
+	 * @brief Allocate memory for an object; the memory is taken from the
+	 *        arena active in the current thread (see ArenaScope), or from
+	 *        the heap if there is none
+	 *
+	 */
+	static void* operator new(size_t size)
+	{
+		return Internal::ObjAllocator::Allocate(size);
+	}
+
+	static void* operator new(size_t /* size */, void* ptr) noexcept
+	{
+		return ptr;
+	}
+
+	static void operator delete(void* ptr) noexcept
+	{
+		Internal::ObjAllocator::Deallocate(ptr);
+	}
+
+	static void operator delete(void* /* ptr */, void* /* place */) noexcept
+	{}
+
 	virtual ObjCategory GetCategory() const = 0;
 
 	virtual const char* GetCategoryName() const = 0;
@@ -365,6 +397,16 @@ public:
 		throw TypeError("Bytes", this->GetCategoryName());
 	}
 
+	virtual TupleBase& AsTuple()
+	{
+		throw TypeError("Tuple", this->GetCategoryName());
+	}
+
+	virtual const TupleBase& AsTuple() const
+	{
+		throw TypeError("Tuple", this->GetCategoryName());
+	}
+
 	virtual HashableBase& AsHashable()
 	{
 		throw TypeError("Hashable", this->GetCategoryName());
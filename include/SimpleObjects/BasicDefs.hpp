@@ -24,6 +24,7 @@ enum class ObjCategory
 	Dict,
 	StaticDict,
 	Bytes,
+	Tuple,
 };
 
 enum class RealNumType
@@ -145,6 +146,16 @@ struct CategoryTraits<ObjCategory::Bytes>
 	{ return "Bytes";  }
 }; // struct CategoryTraits<ObjCategory::Bytes>
 
+template<>
+struct CategoryTraits<ObjCategory::Tuple>
+{
+	static constexpr ObjCategory sk_cat()
+	{ return ObjCategory::Tuple; }
+
+	static constexpr const char* sk_catName()
+	{ return "Tuple";  }
+}; // struct CategoryTraits<ObjCategory::Tuple>
+
 } // namespace Internal
 
 } // namespace SimpleObjects
@@ -7,7 +7,11 @@
 
 #include "BytesBaseObject.hpp"
 
-#include "Internal/hash.hpp"
+#include <algorithm>
+#include <functional>
+
+#include "Internal/HashCache.hpp"
+#include "Internal/HashPolicy.hpp"
 #include "Internal/make_unique.hpp"
 
 #include "Compare.hpp"
@@ -20,6 +24,40 @@ namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 #endif
 {
 
+namespace Internal
+{
+
+/**
+ * @brief Append a contiguous range of values to a contiguous container in
+ *        bulk; unlike `insert`, the range may be part of the container
+ *
+ */
+template<typename _CtnType>
+inline void AppendContiguous(_CtnType& ctn,
+	const typename _CtnType::value_type* begin,
+	const typename _CtnType::value_type* end)
+{
+	using ValPtr = const typename _CtnType::value_type*;
+
+	const size_t len = static_cast<size_t>(end - begin);
+	const size_t oldSize = ctn.size();
+	ValPtr ctnData = ctn.data();
+	std::less<ValPtr> less;
+	if (!less(begin, ctnData) && less(begin, ctnData + oldSize))
+	{
+		// the range will be invalidated once the container is reallocated
+		const size_t offset = static_cast<size_t>(begin - ctnData);
+		ctn.resize(oldSize + len);
+		std::copy_n(ctn.data() + offset, len, ctn.data() + oldSize);
+	}
+	else
+	{
+		ctn.insert(ctn.end(), begin, end);
+	}
+}
+
+} // namespace Internal
+
 template<typename _CtnType, typename _ToStringType>
 class BytesImpl :
 	public BytesBaseObject<
@@ -53,6 +91,8 @@ public: // Static member:
 	typedef typename Base::const_iterator                const_iterator;
 	typedef typename Base::iterator                      reverse_iterator;
 	typedef typename Base::const_iterator                const_reverse_iterator;
+	typedef typename ContainerType::iterator             native_iterator;
+	typedef typename ContainerType::const_iterator       const_native_iterator;
 
 	static constexpr ObjCategory sk_cat()
 	{
@@ -65,33 +105,47 @@ public: // Static member:
 public:
 
 	BytesImpl() :
-		m_data()
+		m_data(),
+		m_hashCache()
+	{}
+
+	explicit BytesImpl(const allocator_type& alloc) :
+		m_data(alloc),
+		m_hashCache()
 	{}
 
 	explicit BytesImpl(const ContainerType& data):
-		m_data(data)
+		m_data(data),
+		m_hashCache()
 	{}
 
 	explicit BytesImpl(ContainerType&& data):
-		m_data(std::forward<ContainerType>(data))
+		m_data(std::forward<ContainerType>(data)),
+		m_hashCache()
 	{}
 
 	BytesImpl(std::initializer_list<value_type> l):
-		m_data(l)
+		m_data(l),
+		m_hashCache()
 	{}
 
 	template<typename _ItType>
 	BytesImpl(_ItType begin, _ItType end) :
-		m_data(begin, end)
+		m_data(begin, end),
+		m_hashCache()
 	{}
 
 	BytesImpl(const Self& other) :
-		m_data(other.m_data)
+		m_data(other.m_data),
+		m_hashCache(other.m_hashCache)
 	{}
 
 	BytesImpl(Self&& other) :
-		m_data(std::forward<ContainerType>(other.m_data))
-	{}
+		m_data(std::forward<ContainerType>(other.m_data)),
+		m_hashCache(other.m_hashCache)
+	{
+		other.m_hashCache.Reset();
+	}
 
 	virtual ~BytesImpl() = default;
 
@@ -100,6 +154,7 @@ public:
 		if (this != &rhs)
 		{
 			m_data = rhs.m_data;
+			m_hashCache = rhs.m_hashCache;
 		}
 		return *this;
 	}
@@ -109,6 +164,8 @@ public:
 		if (this != &rhs)
 		{
 			m_data = std::forward<ContainerType>(rhs.m_data);
+			m_hashCache = rhs.m_hashCache;
+			rhs.m_hashCache.Reset();
 		}
 		return *this;
 	}
@@ -231,7 +288,10 @@ public:
 
 	virtual std::size_t Hash() const override
 	{
-		return Internal::hash_range(m_data.cbegin(), m_data.cend());
+		return m_hashCache.Get([this]() {
+			return Internal::DefaultHashPolicy::HashBytes(
+				m_data.data(), m_data.size());
+		});
 	}
 
 	// ========== Overrides BytesBaseObject ==========
@@ -245,6 +305,7 @@ public:
 
 	virtual void resize(size_t len) override
 	{
+		m_hashCache.Reset();
 		m_data.resize(len);
 	}
 
@@ -257,6 +318,7 @@ public:
 
 	virtual reference operator[](size_t idx) override
 	{
+		m_hashCache.Reset();
 		try
 		{
 			return m_data.at(idx);
@@ -288,19 +350,29 @@ public:
 
 	virtual void push_back(const_reference b) override
 	{
+		m_hashCache.Reset();
 		m_data.push_back(b);
 	}
 
 	virtual void pop_back() override
 	{
+		m_hashCache.Reset();
 		m_data.pop_back();
 	}
 
+	using Base::Append;
 	virtual void Append(const_iterator begin, const_iterator end) override
 	{
+		m_hashCache.Reset();
 		m_data.insert(m_data.end(), begin, end);
 	}
 
+	virtual void Append(const_pointer begin, const_pointer end) override
+	{
+		m_hashCache.Reset();
+		Internal::AppendContiguous(m_data, begin, end);
+	}
+
 	// ========== iterators ==========
 
 	using Base::begin;
@@ -308,11 +380,13 @@ public:
 
 	virtual iterator begin() override
 	{
+		m_hashCache.Reset();
 		return ToRdIt<false>(m_data.begin());
 	}
 
 	virtual iterator end() override
 	{
+		m_hashCache.Reset();
 		return ToRdIt<false>(m_data.end());
 	}
 
@@ -328,11 +402,13 @@ public:
 
 	virtual iterator rbegin() override
 	{
+		m_hashCache.Reset();
 		return ToRdIt<false>(m_data.rbegin());
 	}
 
 	virtual iterator rend() override
 	{
+		m_hashCache.Reset();
 		return ToRdIt<false>(m_data.rend());
 	}
 
@@ -346,6 +422,36 @@ public:
 		return ToRdIt<true>(m_data.crend());
 	}
 
+	// ========== native iterators ==========
+
+	// The iterators of the underlying container, which, unlike the
+	// type-erased ones above, don't allocate, and can be inlined and
+	// vectorized by the std algorithms. They are invalidated by the same
+	// operations as the ones of `ContainerType`.
+	// Getting the non-const ones drops the cached hash, as `begin()` does.
+
+	native_iterator NativeBegin()
+	{
+		m_hashCache.Reset();
+		return m_data.begin();
+	}
+
+	native_iterator NativeEnd()
+	{
+		m_hashCache.Reset();
+		return m_data.end();
+	}
+
+	const_native_iterator NativeBegin() const
+	{
+		return m_data.cbegin();
+	}
+
+	const_native_iterator NativeEnd() const
+	{
+		return m_data.cend();
+	}
+
 	// ========== Interface copy/Move ==========
 
 	using Base::Copy;
@@ -423,6 +529,7 @@ private:
 	}
 
 	ContainerType m_data;
+	Internal::HashCache m_hashCache;
 
 }; // class BytesImpl
 
@@ -216,9 +216,24 @@ public:
 	virtual void Append(const_iterator begin,
 		const_iterator end) = 0;
 
+	/**
+	 * @brief Append the bytes in a contiguous range;
+	 *        the concrete classes copy them in bulk, instead of one at a time
+	 *        through the type-erased iterators.
+	 *        The range may be part of this object.
+	 *
+	 * @param begin the begin of the range
+	 * @param end   the end of the range
+	 */
+	virtual void Append(const_pointer begin, const_pointer end)
+	{
+		return this->Append(ToRdIt<true>(begin), ToRdIt<true>(end));
+	}
+
 	virtual void Append(const Self& other)
 	{
-		return this->Append(other.cbegin(), other.cend());
+		const_pointer otherData = other.data();
+		return this->Append(otherData, otherData + other.size());
 	}
 
 	virtual Self& operator+=(const Self& rhs)
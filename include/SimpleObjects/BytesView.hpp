@@ -0,0 +1,507 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "BytesBaseObject.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "Internal/HashPolicy.hpp"
+#include "Internal/make_unique.hpp"
+
+#include "Bytes.hpp"
+#include "Compare.hpp"
+#include "ToString.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A bytes object that refers to a buffer owned by someone else,
+ *        so that it can be constructed without copying the data.
+ *        The borrowed buffer MUST outlive this object, and all the copies
+ *        of it (including the slices), unless they have been mutated.
+ *        The data is copied into a container owned by this object, only
+ *        when it's going to be mutated (i.e., copy-on-write), which includes
+ *        getting a non-const reference or iterator to the data.
+ *        It's equal to, and has the same hash value as, a BytesImpl with
+ *        the same content.
+ *
+ * @tparam _CtnType The type of the container used once the data is owned
+ */
+template<typename _CtnType, typename _ToStringType>
+class BytesViewImpl :
+	public BytesBaseObject<
+		typename _CtnType::value_type,
+		_ToStringType>
+{
+public: // Static member:
+
+	using ContainerType = _CtnType;
+	using ToStringType = _ToStringType;
+	using Self = BytesViewImpl<ContainerType, ToStringType>;
+	using Base = BytesBaseObject<
+		typename ContainerType::value_type, ToStringType>;
+	using BaseBase = typename Base::Base;
+	using BaseBaseBase = typename BaseBase::Base;
+
+	static_assert(std::is_same<BaseBase, HashableBaseObject<_ToStringType> >::value,
+		"Expecting Base::Base to be HashableBaseObject class");
+	static_assert(std::is_same<BaseBaseBase, BaseObject<_ToStringType> >::value,
+		"Expecting Base::Base::Base to be BaseObject class");
+
+	typedef typename ContainerType::value_type           value_type;
+	typedef typename ContainerType::size_type            size_type;
+	typedef typename ContainerType::difference_type      difference_type;
+	typedef typename ContainerType::reference            reference;
+	typedef typename ContainerType::const_reference      const_reference;
+	typedef typename ContainerType::pointer              pointer;
+	typedef typename ContainerType::const_pointer        const_pointer;
+	typedef typename Base::iterator                      iterator;
+	typedef typename Base::const_iterator                const_iterator;
+	typedef typename Base::iterator                      reverse_iterator;
+	typedef typename Base::const_iterator                const_reverse_iterator;
+
+	static constexpr ObjCategory sk_cat()
+	{
+		return ObjCategory::Bytes;
+	}
+
+	static_assert(std::is_same<value_type, uint8_t>::value,
+		"Current implementation only supports uint8_t bytes.");
+
+public:
+
+	BytesViewImpl() :
+		BytesViewImpl(nullptr, 0)
+	{}
+
+	BytesViewImpl(const_pointer data, size_t size) :
+		m_ptr(data),
+		m_size(size),
+		m_data(),
+		m_isOwned(false)
+	{}
+
+	/**
+	 * @brief Construct a view that refers to the data of the given bytes
+	 *        object
+	 *
+	 */
+	explicit BytesViewImpl(const Base& other) :
+		BytesViewImpl(other.data(), other.size())
+	{}
+
+	BytesViewImpl(const Self& other) :
+		m_ptr(other.m_ptr),
+		m_size(other.m_size),
+		m_data(other.m_data),
+		m_isOwned(other.m_isOwned)
+	{}
+
+	BytesViewImpl(Self&& other) :
+		m_ptr(other.m_ptr),
+		m_size(other.m_size),
+		m_data(std::forward<ContainerType>(other.m_data)),
+		m_isOwned(other.m_isOwned)
+	{}
+
+	virtual ~BytesViewImpl() = default;
+
+	Self& operator=(const Self& rhs)
+	{
+		if (this != &rhs)
+		{
+			m_ptr = rhs.m_ptr;
+			m_size = rhs.m_size;
+			m_data = rhs.m_data;
+			m_isOwned = rhs.m_isOwned;
+		}
+		return *this;
+	}
+
+	Self& operator=(Self&& rhs)
+	{
+		if (this != &rhs)
+		{
+			m_ptr = rhs.m_ptr;
+			m_size = rhs.m_size;
+			m_data = std::forward<ContainerType>(rhs.m_data);
+			m_isOwned = rhs.m_isOwned;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Check if the data has been copied into this object, due to
+	 *        mutations
+	 *
+	 */
+	bool IsOwned() const
+	{
+		return m_isOwned;
+	}
+
+	/**
+	 * @brief Get a view of a part of the data, without copying it.
+	 *        If the data is owned by this object, the returned view refers
+	 *        to it, and thus, this object must outlive the returned view.
+	 *
+	 * @param pos   The beginning position of the slice
+	 * @param count The length of the slice, which will be truncated if it's
+	 *              beyond the end of the data
+	 * @return The view of the slice
+	 */
+	Self Slice(size_t pos, size_t count) const
+	{
+		if (pos > size())
+		{
+			throw IndexError(pos);
+		}
+		return Self(data() + pos, std::min(count, size() - pos));
+	}
+
+	// ========== Comparisons ==========
+
+	// ===== BytesBase class
+
+	virtual bool BytesBaseEqual(size_t pos1, size_t count1,
+		const_pointer begin, const_pointer end) const override
+	{
+		auto ptrDiff = end - begin;
+		return Internal::RealNumCompare<decltype(ptrDiff), size_t>::Equal(
+				ptrDiff, count1) ?
+			std::equal(data() + pos1, data() + pos1 + count1, begin) :
+			false;
+	}
+
+	virtual int BytesBaseCompare(size_t pos1, size_t count1,
+		const_pointer begin, const_pointer end) const override
+	{
+		return Internal::LexicographicalCompareThreeWay(
+			data() + pos1, data() + pos1 + count1,
+			begin, end);
+	}
+
+	using Base::operator==;
+#ifdef __cpp_lib_three_way_comparison
+	using Base::operator<=>;
+
+	// Since C++20, comparing with a BytesImpl through the base class
+	// is ambiguous with the reversed candidates, so exact matches are given
+	template<typename _OtherCtnType>
+	bool operator==(const BytesImpl<_OtherCtnType, ToStringType>& rhs) const
+	{
+		return Base::operator==(rhs);
+	}
+
+	template<typename _OtherCtnType>
+	std::strong_ordering operator<=>(
+		const BytesImpl<_OtherCtnType, ToStringType>& rhs) const
+	{
+		return Base::operator<=>(rhs);
+	}
+#else
+	using Base::operator!=;
+	using Base::operator<;
+	using Base::operator>;
+	using Base::operator<=;
+	using Base::operator>=;
+#endif
+
+	// ========== Overrides BaseObject ==========
+
+	virtual ObjCategory GetCategory() const override
+	{
+		return sk_cat();
+	}
+
+	using BaseBaseBase::Set;
+
+	virtual void Set(const BaseBaseBase& other) override
+	{
+		try
+		{
+			const Self& casted = dynamic_cast<const Self&>(other);
+			*this = casted;
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("Bytes", this->GetCategoryName());
+		}
+	}
+
+	virtual void Set(BaseBaseBase&& other) override
+	{
+		try
+		{
+			Self&& casted = dynamic_cast<Self&&>(other);
+			*this = std::forward<Self>(casted);
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("Bytes", this->GetCategoryName());
+		}
+	}
+
+	virtual bool IsTrue() const override
+	{
+		return size() > 0;
+	}
+
+	// ========== Overrides HashableBaseObject ==========
+
+	virtual std::size_t Hash() const override
+	{
+		return Internal::DefaultHashPolicy::HashBytes(data(), size());
+	}
+
+	// ========== Overrides BytesBaseObject ==========
+
+	// ========== capacity ==========
+
+	virtual size_t size() const override
+	{
+		return m_isOwned ? m_data.size() : m_size;
+	}
+
+	virtual void resize(size_t len) override
+	{
+		MakeOwned().resize(len);
+	}
+
+	virtual void reserve(size_t len) override
+	{
+		MakeOwned().reserve(len);
+	}
+
+	// ========== value access ==========
+
+	virtual reference operator[](size_t idx) override
+	{
+		if (idx >= size())
+		{
+			throw IndexError(idx);
+		}
+		return MakeOwned()[idx];
+	}
+
+	virtual const_reference operator[](size_t idx) const override
+	{
+		if (idx >= size())
+		{
+			throw IndexError(idx);
+		}
+		return data()[idx];
+	}
+
+	virtual const_pointer data() const override
+	{
+		return m_isOwned ? m_data.data() : m_ptr;
+	}
+
+	// ========== adding/removing values ==========
+
+	virtual void push_back(const_reference b) override
+	{
+		MakeOwned().push_back(b);
+	}
+
+	virtual void pop_back() override
+	{
+		MakeOwned().pop_back();
+	}
+
+	using Base::Append;
+	virtual void Append(const_iterator begin, const_iterator end) override
+	{
+		ContainerType& ctn = MakeOwned();
+		ctn.insert(ctn.end(), begin, end);
+	}
+
+	virtual void Append(const_pointer begin, const_pointer end) override
+	{
+		// the range stays valid if it's part of the borrowed buffer
+		Internal::AppendContiguous(MakeOwned(), begin, end);
+	}
+
+	// ========== iterators ==========
+
+	using Base::begin;
+	using Base::end;
+
+	virtual iterator begin() override
+	{
+		return ToRdIt<false>(MakeOwned().begin());
+	}
+
+	virtual iterator end() override
+	{
+		return ToRdIt<false>(MakeOwned().end());
+	}
+
+	virtual const_iterator cbegin() const override
+	{
+		return ToRdIt<true>(data());
+	}
+
+	virtual const_iterator cend() const override
+	{
+		return ToRdIt<true>(data() + size());
+	}
+
+	virtual iterator rbegin() override
+	{
+		return ToRdIt<false>(MakeOwned().rbegin());
+	}
+
+	virtual iterator rend() override
+	{
+		return ToRdIt<false>(MakeOwned().rend());
+	}
+
+	virtual const_iterator crbegin() const override
+	{
+		return ToRdIt<true>(std::reverse_iterator<const_pointer>(
+			data() + size()));
+	}
+
+	virtual const_iterator crend() const override
+	{
+		return ToRdIt<true>(std::reverse_iterator<const_pointer>(data()));
+	}
+
+	// ========== Interface copy/Move ==========
+
+	using Base::Copy;
+	virtual std::unique_ptr<Base> Copy(const Base* /*unused*/) const override
+	{
+		return CopyImpl();
+	}
+
+	using Base::Move;
+	virtual std::unique_ptr<Base> Move(const Base* /*unused*/) override
+	{
+		return MoveImpl();
+	}
+
+	// ========== To string ==========
+
+	virtual std::string DebugString() const override
+	{
+		return InternalToString<std::string>();
+	}
+
+	virtual std::string ShortDebugString() const override
+	{
+		return DebugString();
+	}
+
+	virtual ToStringType ToString() const override
+	{
+		return InternalToString<ToStringType>();
+	}
+
+	virtual void DumpString(
+		OutIterator<typename ToStringType::value_type> outIt) const override
+	{
+		InternalDumpString<typename ToStringType::value_type>(outIt);
+	}
+
+private:
+
+	ContainerType& MakeOwned()
+	{
+		if (!m_isOwned)
+		{
+			m_data.assign(m_ptr, m_ptr + m_size);
+			m_isOwned = true;
+		}
+		return m_data;
+	}
+
+	template<typename _StrType>
+	_StrType InternalToString() const
+	{
+		_StrType res;
+
+		InternalDumpString<typename _StrType::value_type>(
+			std::back_inserter(res));
+
+		return res;
+	}
+
+	template<typename _CharType, typename _ItType>
+	void InternalDumpString(_ItType outit) const
+	{
+		*outit++ = '\"';
+
+		const_pointer ptr = data();
+		for (size_t i = 0; i < size(); ++i)
+		{
+			Internal::ByteToHEX<true, _CharType>(
+				outit,
+				static_cast<uint8_t>(ptr[i])
+			);
+		}
+
+		*outit++ = '\"';
+	}
+
+	std::unique_ptr<Self> CopyImpl() const
+	{
+		return Internal::make_unique<Self>(*this);
+	}
+
+	std::unique_ptr<Self> MoveImpl()
+	{
+		return Internal::make_unique<Self>(std::move(*this));
+	}
+
+	const_pointer m_ptr;
+	size_t m_size;
+	ContainerType m_data;
+	bool m_isOwned;
+
+}; // class BytesViewImpl
+
+} // namespace SimpleObjects
+
+// ========== Hash ==========
+namespace std
+{
+
+	template<typename _CtnType, typename _ToStringType>
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+	struct hash<SimpleObjects::BytesViewImpl<_CtnType, _ToStringType> >
+	{
+		using _ObjType = SimpleObjects::BytesViewImpl<_CtnType, _ToStringType>;
+#else
+	struct hash<SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE::BytesViewImpl<_CtnType, _ToStringType> >
+	{
+		using _ObjType = SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE::BytesViewImpl<_CtnType, _ToStringType>;
+#endif
+
+	public:
+
+#if __cplusplus < 201703L
+		typedef size_t       result_type;
+		typedef _ObjType     argument_type;
+#endif
+
+		size_t operator()(const _ObjType& cnt) const
+		{
+			return cnt.Hash();
+		}
+
+	}; // struct hash
+
+} // namespace std
@@ -9,13 +9,23 @@
 #include <unordered_map>
 #include <vector>
 #include <functional>
+#include <memory>
+#include <utility>
 
 #include "Null.hpp"
 #include "RealNum.hpp"
 #include "String.hpp"
 #include "List.hpp"
+#include "Tuple.hpp"
 #include "Dict.hpp"
+#include "FlatHashMap.hpp"
+#include "SmallHashMap.hpp"
+#include "BTreeMap.hpp"
+#include "ShapedDict.hpp"
 #include "Bytes.hpp"
+#include "BytesView.hpp"
+#include "StringView.hpp"
+#include "InternedString.hpp"
 
 #include "Object.hpp"
 #include "HashableObject.hpp"
@@ -25,6 +35,8 @@
 
 #include "ToStringImpl.hpp"
 
+#include "Internal/DictKeyOrder.hpp"
+
 #ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 namespace SimpleObjects
 #else
@@ -39,9 +51,48 @@ using ToStringType = std::string;
 template<typename _KeyType, typename _ValType>
 using MapType = std::unordered_map<_KeyType, _ValType>;
 
+template<typename _KeyType, typename _ValType>
+using FlatMapType = FlatHashMap<_KeyType, _ValType>;
+
+template<typename _KeyType, typename _ValType>
+using OrderedMapType = OrderedHashMap<_KeyType, _ValType>;
+
+template<typename _KeyType, typename _ValType>
+using SmallMapType = SmallHashMap<_KeyType, _ValType>;
+
+template<typename _KeyType, typename _ValType>
+using SortedMapType = BTreeMap<_KeyType, _ValType, Internal::DictKeyLess>;
+
 template<typename _ValType>
 using VecType = std::vector<_ValType>;
 
+// ========== Allocator-aware Type Controll ==========
+
+template<typename _ValType, typename _Alloc>
+using AllocRebind =
+	typename std::allocator_traits<_Alloc>::template rebind_alloc<_ValType>;
+
+template<typename _Alloc>
+struct MapTypeAlloc
+{
+	template<typename _KeyType, typename _ValType>
+	using type = std::unordered_map<
+		_KeyType,
+		_ValType,
+		std::hash<_KeyType>,
+		std::equal_to<_KeyType>,
+		AllocRebind<std::pair<const _KeyType, _ValType>, _Alloc> >;
+}; // struct MapTypeAlloc
+
+template<typename _ValType, typename _Alloc>
+using VecTypeAlloc = std::vector<_ValType, AllocRebind<_ValType, _Alloc> >;
+
+template<typename _CharType, typename _Alloc>
+using StrTypeAlloc = std::basic_string<
+	_CharType,
+	std::char_traits<_CharType>,
+	AllocRebind<_CharType, _Alloc> >;
+
 // ========== Convenient types of Null ==========
 
 using Null = NullImpl<ToStringType>;
@@ -76,6 +127,27 @@ using Double = RealNumT<double  >;
 
 using String = StringImpl<std::string, ToStringType>;
 
+template<typename _Alloc>
+using StringAlloc = StringImpl<StrTypeAlloc<char, _Alloc>, ToStringType>;
+
+template<typename _Alloc>
+inline StringAlloc<_Alloc> MakeString(const _Alloc& alloc)
+{
+	using _RetType = StringAlloc<_Alloc>;
+	return _RetType(typename _RetType::allocator_type(alloc));
+}
+
+template<typename _Alloc>
+inline StringAlloc<_Alloc> MakeString(const char* str, const _Alloc& alloc)
+{
+	using _RetType = StringAlloc<_Alloc>;
+	return _RetType(str, typename _RetType::allocator_type(alloc));
+}
+
+using StringView = StringViewImpl<std::string, ToStringType>;
+
+using InternedString = InternedStringImpl<std::string, ToStringType>;
+
 // ========== Convenient types of Object ==========
 
 using Object = ObjectImpl<ToStringType>;
@@ -91,6 +163,26 @@ using ListT = ListImpl<VecType<_ValType>, ToStringType>;
 
 using List = ListT<Object>;
 
+template<typename _ValType, typename _Alloc>
+using ListAllocT = ListImpl<VecTypeAlloc<_ValType, _Alloc>, ToStringType>;
+
+template<typename _Alloc>
+using ListAlloc = ListAllocT<Object, _Alloc>;
+
+template<typename _Alloc>
+inline ListAlloc<_Alloc> MakeList(const _Alloc& alloc)
+{
+	using _RetType = ListAlloc<_Alloc>;
+	return _RetType(typename _RetType::allocator_type(alloc));
+}
+
+// ========== Convenient types of Tuple ==========
+
+template<typename _ValType>
+using TupleT = TupleImpl<VecType<_ValType>, ToStringType>;
+
+using Tuple = TupleT<HashableObject>;
+
 // ========== Convenient types of Dict ==========
 
 template<typename _KeyType, typename _Valtype>
@@ -98,11 +190,65 @@ using DictT = DictImpl<_KeyType, _Valtype, MapType, ToStringType>;
 
 using Dict = DictT<HashableObject, Object>;
 
+template<typename _KeyType, typename _Valtype>
+using FlatDictT = DictImpl<_KeyType, _Valtype, FlatMapType, ToStringType>;
+
+using FlatDict = FlatDictT<HashableObject, Object>;
+
+template<typename _KeyType, typename _Valtype>
+using OrderedDictT = DictImpl<_KeyType, _Valtype, OrderedMapType, ToStringType>;
+
+using OrderedDict = OrderedDictT<HashableObject, Object>;
+
+template<typename _KeyType, typename _Valtype>
+using SmallDictT = DictImpl<_KeyType, _Valtype, SmallMapType, ToStringType>;
+
+using SmallDict = SmallDictT<HashableObject, Object>;
+
+template<typename _KeyType, typename _Valtype>
+using SortedDictT = DictImpl<_KeyType, _Valtype, SortedMapType, ToStringType>;
+
+using SortedDict = SortedDictT<HashableObject, Object>;
+
+template<typename _KeyType, typename _Valtype>
+using ShapedDictT = ShapedDictImpl<_KeyType, _Valtype, ToStringType>;
+
+using ShapedDict = ShapedDictT<HashableObject, Object>;
+
+template<typename _KeyType, typename _Valtype, typename _Alloc>
+using DictAllocT = DictImpl<
+	_KeyType,
+	_Valtype,
+	MapTypeAlloc<_Alloc>::template type,
+	ToStringType>;
+
+template<typename _Alloc>
+using DictAlloc = DictAllocT<HashableObject, Object, _Alloc>;
+
+template<typename _Alloc>
+inline DictAlloc<_Alloc> MakeDict(const _Alloc& alloc)
+{
+	using _RetType = DictAlloc<_Alloc>;
+	return _RetType(typename _RetType::allocator_type(alloc));
+}
+
 // ========== Convenient types of Bytes ==========
 
 using BytesBaseObj = BytesBaseObject<uint8_t, ToStringType>;
 using Bytes = BytesImpl<std::vector<uint8_t>, ToStringType>;
 
+template<typename _Alloc>
+using BytesAlloc = BytesImpl<VecTypeAlloc<uint8_t, _Alloc>, ToStringType>;
+
+template<typename _Alloc>
+inline BytesAlloc<_Alloc> MakeBytes(const _Alloc& alloc)
+{
+	using _RetType = BytesAlloc<_Alloc>;
+	return _RetType(typename _RetType::allocator_type(alloc));
+}
+
+using BytesView = BytesViewImpl<std::vector<uint8_t>, ToStringType>;
+
 // ========== Convenient types of base classes ==========
 
 using BaseObj = BaseObject<ToStringType>;
@@ -111,6 +257,7 @@ using HashableBaseObj = HashableBaseObject<ToStringType>;
 using RealNumBaseObj = RealNumBaseObject<ToStringType>;
 using StringBaseObj = StringBaseObject<char, ToStringType>;
 using ListBaseObj = ListBaseObject<BaseObj, ToStringType>;
+using TupleBaseObj = TupleBaseObject<HashableBaseObj, ToStringType>;
 using DictBaseObj = DictBaseObject<HashableBaseObj, BaseObj, ToStringType>;
 using StaticDictBaseObj = StaticDictBaseObject<
 	HashableBaseObj,
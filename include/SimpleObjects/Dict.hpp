@@ -54,6 +54,7 @@ public: // Static member:
 	typedef _ValType                               mapped_type;
 	typedef std::pair<key_type, mapped_type>       value_type;
 	typedef typename ContainerType::value_type     wrapped_value_type;
+	typedef typename ContainerType::allocator_type allocator_type;
 	typedef FrIterator<wrapped_value_type, false>  iterator;
 	typedef FrIterator<wrapped_value_type, true>   const_iterator;
 
@@ -63,6 +64,8 @@ public: // Static member:
 	typedef typename Base::mapped_iterator           base_mapped_iterator;
 	typedef typename Base::const_mapped_iterator     base_const_mapped_iterator;
 
+	using LookupKey = typename Base::LookupKey;
+
 	using _CtnConstIterator = typename ContainerType::const_iterator;
 	using _CtnIterator = typename ContainerType::iterator;
 	using _KeyIteratorWrap = CppStdFwIteratorWrap<
@@ -92,6 +95,10 @@ public:
 		m_data()
 	{}
 
+	explicit DictImpl(const allocator_type& alloc) :
+		m_data(alloc)
+	{}
+
 	DictImpl(std::initializer_list<value_type> l) :
 		m_data()
 	{
@@ -101,6 +108,23 @@ public:
 		}
 	}
 
+	/**
+	 * @brief Construct from a range of key-value pairs; with a sorted
+	 *        container (e.g., BTreeMap), pairs sorted by keys are appended
+	 *        without searching
+	 *
+	 */
+	template<typename _ItType>
+	DictImpl(_ItType begin, _ItType end) :
+		m_data()
+	{
+		for (; begin != end; ++begin)
+		{
+			m_data.emplace_hint(
+				m_data.cend(), DictKey::Make(begin->first), begin->second);
+		}
+	}
+
 	DictImpl(const Self& other) :
 		m_data(other.m_data)
 	{}
@@ -162,6 +186,15 @@ public:
 		{
 			return false;
 		}
+
+		const Self* rhsSame = dynamic_cast<const Self*>(&rhs);
+		if (rhsSame != nullptr)
+		{
+			// same concrete type, so the containers are compared directly,
+			// instead of looking up each key through the base class
+			return m_data == rhsSame->m_data;
+		}
+
 		auto xi = m_data.cbegin();
 		auto xe = m_data.cend();
 		auto ye = rhs.ValsCEnd();
@@ -252,6 +285,49 @@ public:
 		}
 	}
 
+	/**
+	 * @brief Access a value by a key of any hashable type (e.g., StringView),
+	 *        which is converted to key_type only if it has to be inserted
+	 *
+	 */
+	mapped_type& operator[](const base_key_type& key)
+	{
+		auto wrappedKey = DictKey::Borrow(&key);
+		auto it = m_data.find(wrappedKey);
+		if (it == m_data.end())
+		{
+			return m_data[DictKey::Make(key)];
+		}
+		else
+		{
+			return it->second;
+		}
+	}
+
+	const mapped_type& operator[](const base_key_type& key) const
+	{
+		try
+		{
+			auto wrappedKey = DictKey::Borrow(&key);
+			return m_data.at(wrappedKey);
+		}
+		catch (const std::out_of_range&)
+		{
+			throw KeyError(key.ShortDebugString(), KeyError::sk_keyName);
+		}
+	}
+
+	/**
+	 * @brief Look up a raw string or number; see Internal::DictLookupKey
+	 *
+	 */
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	const mapped_type& operator[](const _LookupType& key) const
+	{
+		return (*this)[static_cast<const base_key_type&>(LookupKey::Make(key))];
+	}
+
 	// ========== item searching ==========
 
 	const_iterator find(const key_type& key) const
@@ -272,6 +348,97 @@ public:
 		return m_data.find(wrappedKey) != m_data.cend();
 	}
 
+	// ===== Lookup by keys of any hashable type (e.g., StringView)
+
+	const_iterator find(const base_key_type& key) const
+	{
+		auto wrappedKey = DictKey::Borrow(&key);
+		return ToFrIt<true>(m_data.find(wrappedKey));
+	}
+
+	iterator find(const base_key_type& key)
+	{
+		auto wrappedKey = DictKey::Borrow(&key);
+		return ToFrIt<false>(m_data.find(wrappedKey));
+	}
+
+	bool HasKey(const base_key_type& key) const
+	{
+		auto wrappedKey = DictKey::Borrow(&key);
+		return m_data.find(wrappedKey) != m_data.cend();
+	}
+
+	// ===== Lookup by raw strings and numbers; see Internal::DictLookupKey
+
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	const_iterator find(const _LookupType& key) const
+	{
+		return find(static_cast<const base_key_type&>(LookupKey::Make(key)));
+	}
+
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	iterator find(const _LookupType& key)
+	{
+		return find(static_cast<const base_key_type&>(LookupKey::Make(key)));
+	}
+
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	bool HasKey(const _LookupType& key) const
+	{
+		return HasKey(static_cast<const base_key_type&>(LookupKey::Make(key)));
+	}
+
+	// ===== Range lookup; only available with sorted containers
+
+	/**
+	 * @brief Find the first pair whose key is not less than `key`
+	 *
+	 */
+	const_iterator LowerBound(const base_key_type& key) const
+	{
+		auto wrappedKey = DictKey::Borrow(&key);
+		return ToFrIt<true>(m_data.lower_bound(wrappedKey));
+	}
+
+	iterator LowerBound(const base_key_type& key)
+	{
+		auto wrappedKey = DictKey::Borrow(&key);
+		return ToFrIt<false>(m_data.lower_bound(wrappedKey));
+	}
+
+	/**
+	 * @brief Find the first pair whose key is greater than `key`
+	 *
+	 */
+	const_iterator UpperBound(const base_key_type& key) const
+	{
+		auto wrappedKey = DictKey::Borrow(&key);
+		return ToFrIt<true>(m_data.upper_bound(wrappedKey));
+	}
+
+	iterator UpperBound(const base_key_type& key)
+	{
+		auto wrappedKey = DictKey::Borrow(&key);
+		return ToFrIt<false>(m_data.upper_bound(wrappedKey));
+	}
+
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	const_iterator LowerBound(const _LookupType& key) const
+	{
+		return LowerBound(static_cast<const base_key_type&>(LookupKey::Make(key)));
+	}
+
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	const_iterator UpperBound(const _LookupType& key) const
+	{
+		return UpperBound(static_cast<const base_key_type&>(LookupKey::Make(key)));
+	}
+
 	// ========== adding/removing values ==========
 
 	std::pair<iterator, bool> InsertOnly(
@@ -403,34 +570,38 @@ public:
 
 	virtual base_key_iterator KeysBegin() const override
 	{
-		return base_key_iterator(_KeyIteratorWrap::Build(m_data.cbegin()));
+		return base_key_iterator::template Make<_KeyIteratorWrap>(
+			m_data.cbegin());
 	}
 
 	virtual base_key_iterator KeysEnd() const override
 	{
-		return base_key_iterator(_KeyIteratorWrap::Build(m_data.cend()));
+		return base_key_iterator::template Make<_KeyIteratorWrap>(
+			m_data.cend());
 	}
 
 	virtual base_const_mapped_iterator ValsCBegin() const override
 	{
-		return base_const_mapped_iterator(
-			_ValKIteratorWrap::Build(m_data.cbegin()));
+		return base_const_mapped_iterator::template Make<_ValKIteratorWrap>(
+			m_data.cbegin());
 	}
 
 	virtual base_const_mapped_iterator ValsCEnd() const override
 	{
-		return base_const_mapped_iterator(
-			_ValKIteratorWrap::Build(m_data.cend()));
+		return base_const_mapped_iterator::template Make<_ValKIteratorWrap>(
+			m_data.cend());
 	}
 
 	virtual base_mapped_iterator ValsBegin() override
 	{
-		return base_mapped_iterator(_ValIteratorWrap::Build(m_data.begin()));
+		return base_mapped_iterator::template Make<_ValIteratorWrap>(
+			m_data.begin());
 	}
 
 	virtual base_mapped_iterator ValsEnd() override
 	{
-		return base_mapped_iterator(_ValIteratorWrap::Build(m_data.end()));
+		return base_mapped_iterator::template Make<_ValIteratorWrap>(
+			m_data.end());
 	}
 
 	// ========== Interface copy/Move ==========
@@ -542,16 +713,16 @@ protected:
 		const base_key_type& key) const override
 	{
 		auto wrappedKey = DictKey::Borrow(&key);
-		return base_const_mapped_iterator(
-			_ValKIteratorWrap::Build(m_data.find(wrappedKey)));
+		return base_const_mapped_iterator::template Make<_ValKIteratorWrap>(
+			m_data.find(wrappedKey));
 	}
 
 	virtual base_mapped_iterator DictBaseFindVal(
 		const base_key_type& key) override
 	{
 		auto wrappedKey = DictKey::Borrow(&key);
-		return base_mapped_iterator(
-			_ValIteratorWrap::Build(m_data.find(wrappedKey)));
+		return base_mapped_iterator::template Make<_ValIteratorWrap>(
+			m_data.find(wrappedKey));
 	}
 
 	virtual base_mapped_iterator DictBaseFindValOrAddDefault(
@@ -562,19 +733,17 @@ protected:
 		if (it == m_data.end())
 		{
 			// Key is not present, we need to copy the key
-			return base_mapped_iterator(
-				_ValIteratorWrap::Build(
-					m_data.emplace(
-						DictKey::Make(key),
-						mapped_type()
-					).first
-				)
+			return base_mapped_iterator::template Make<_ValIteratorWrap>(
+				m_data.emplace(
+					DictKey::Make(key),
+					mapped_type()
+				).first
 			);
 		}
 		else
 		{
 			// key is present, we can just utilize the existing pair
-			return base_mapped_iterator(_ValIteratorWrap::Build(it));
+			return base_mapped_iterator::template Make<_ValIteratorWrap>(it);
 		}
 	}
 
@@ -612,6 +781,27 @@ protected:
 		m_data.erase(wrappedKey);
 	}
 
+	virtual void DictBaseForEach(
+		const std::function<void(const base_key_type&, base_mapped_type&)>& func
+	) override
+	{
+		for (auto& item : m_data)
+		{
+			func(item.first.GetVal(), item.second);
+		}
+	}
+
+	virtual void DictBaseForEach(
+		const std::function<
+			void(const base_key_type&, const base_mapped_type&)>& func
+	) const override
+	{
+		for (const auto& item : m_data)
+		{
+			func(item.first.GetVal(), item.second);
+		}
+	}
+
 private:
 
 	static const key_type& DynCastKey(const base_key_type& key)
@@ -5,8 +5,20 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <functional>
+#include <string>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif // __cplusplus >= 201703L
+#include <type_traits>
+#include <utility>
+
 #include "BaseObject.hpp"
 #include "HashableBaseObject.hpp"
+#include "RealNum.hpp"
+#include "StringView.hpp"
 
 #ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 namespace SimpleObjects
@@ -15,6 +27,72 @@ namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 #endif
 {
 
+namespace Internal
+{
+
+/**
+ * @brief Wrap a raw string or number in a temporary key object, which is
+ *        constructed on the stack, and borrows the string data, so that a
+ *        Dict can be searched without allocating any key object on the heap.
+ *        Signed integers are wrapped as Int64, unsigned integers as UInt64,
+ *        and floating-point numbers as Double, which are the types used by
+ *        the JSON parser.
+ *
+ */
+template<typename _ToStringType>
+struct DictLookupKey
+{
+	using StrKeyType = StringViewImpl<std::string, _ToStringType>;
+
+	template<typename _NumType>
+	using NumKeyType = RealNumImpl<
+		typename std::conditional<std::is_same<_NumType, bool>::value,
+			bool,
+		typename std::conditional<std::is_floating_point<_NumType>::value,
+			double,
+		typename std::conditional<std::is_signed<_NumType>::value,
+			int64_t,
+			uint64_t>::type>::type>::type,
+		_ToStringType>;
+
+	static StrKeyType Make(const char* key)
+	{
+		return StrKeyType(key);
+	}
+
+	static StrKeyType Make(const std::string& key)
+	{
+		return StrKeyType(key.data(), key.size());
+	}
+
+#if __cplusplus >= 201703L
+	static StrKeyType Make(std::string_view key)
+	{
+		return StrKeyType(key.data(), key.size());
+	}
+#endif // __cplusplus >= 201703L
+
+	template<typename _NumType,
+		typename std::enable_if<
+			std::is_arithmetic<_NumType>::value, int>::type = 0>
+	static NumKeyType<_NumType> Make(_NumType key)
+	{
+		using _KeyType = NumKeyType<_NumType>;
+		return _KeyType(static_cast<typename _KeyType::InternalType>(key));
+	}
+}; // struct DictLookupKey
+
+/**
+ * @brief The type of the temporary key object for the given raw type; it's
+ *        used to enable the lookup overloads only for the supported types
+ *
+ */
+template<typename _LookupType, typename _ToStringType>
+using DictLookupKeyType = decltype(DictLookupKey<_ToStringType>::Make(
+	std::declval<const _LookupType&>()));
+
+} // namespace Internal
+
 template<typename _KeyType, typename _ValType, typename _ToStringType>
 class DictBaseObject : public BaseObject<_ToStringType>
 {
@@ -38,6 +116,8 @@ public: // Static members
 	typedef FrIterator<std::tuple<key_iterator, const_mapped_iterator>, true>
 		                                              const_iterator;
 
+	using LookupKey = Internal::DictLookupKey<_ToStringType>;
+
 	static constexpr Self* sk_null = nullptr;
 
 public:
@@ -162,6 +242,37 @@ public:
 		return FindVal(key) != ValsCEnd();
 	}
 
+	// ===== Lookup by raw strings (i.e., `const char*`, `std::string`, and
+	//       `std::string_view`) and numbers; see Internal::DictLookupKey
+
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	const mapped_type& operator[](const _LookupType& key) const
+	{
+		return (*this)[static_cast<const key_type&>(LookupKey::Make(key))];
+	}
+
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	const_mapped_iterator FindVal(const _LookupType& key) const
+	{
+		return FindVal(static_cast<const key_type&>(LookupKey::Make(key)));
+	}
+
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	mapped_iterator FindVal(const _LookupType& key)
+	{
+		return FindVal(static_cast<const key_type&>(LookupKey::Make(key)));
+	}
+
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	bool HasKey(const _LookupType& key) const
+	{
+		return HasKey(static_cast<const key_type&>(LookupKey::Make(key)));
+	}
+
 	bool InsertOnly(const key_type& key, const mapped_type& val)
 	{
 		return DictBaseInsertOnly(key, val);
@@ -245,6 +356,25 @@ public:
 		return cend();
 	}
 
+	/**
+	 * @brief Call `func` on each key-value pair in the dict.
+	 *        The loop is run by the concrete dict class, so, unlike the
+	 *        iterators above, it doesn't make any virtual calls per item.
+	 *
+	 */
+	void ForEach(
+		const std::function<void(const key_type&, mapped_type&)>& func)
+	{
+		DictBaseForEach(func);
+	}
+
+	void ForEach(
+		const std::function<void(const key_type&, const mapped_type&)>& func
+	) const
+	{
+		DictBaseForEach(func);
+	}
+
 	// ========== Copy and Move ==========
 
 	virtual std::unique_ptr<Self> Copy(const Self* /*unused*/) const = 0;
@@ -284,6 +414,13 @@ protected:
 
 	virtual void DictBaseRemove(const key_type& key) = 0;
 
+	virtual void DictBaseForEach(
+		const std::function<void(const key_type&, mapped_type&)>& func) = 0;
+
+	virtual void DictBaseForEach(
+		const std::function<void(const key_type&, const mapped_type&)>& func
+	) const = 0;
+
 }; // class DictBaseObject
 
 } // namespace SimpleObjects
@@ -144,4 +144,38 @@ public:
 
 }; // class IndexError
 
+class ParseError : public Exception
+{
+public:
+
+	ParseError(const std::string& msg, size_t pos) :
+		Exception("Failed to parse at position \'" + std::to_string(pos) +
+			"\' - " + msg),
+		m_pos(pos)
+	{}
+
+	// LCOV_EXCL_START
+	/**
+	 * @brief Destroy the Parse Error object
+	 *
+	 */
+	virtual ~ParseError() = default;
+	// LCOV_EXCL_STOP
+
+	/**
+	 * @brief Get the position (in bytes, counted from the beginning of the
+	 *        input) where the error occurred
+	 *
+	 */
+	size_t GetPos() const noexcept
+	{
+		return m_pos;
+	}
+
+private:
+
+	size_t m_pos;
+
+}; // class ParseError
+
 } // namespace SimpleObjects
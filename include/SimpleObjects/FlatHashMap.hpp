@@ -0,0 +1,1171 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief An open-addressing hash map, which can be used as the container
+ *        type of DictImpl, in place of `std::unordered_map`.
+ *
+ *        The map is made of two parts:
+ *        1. An index table of 8-byte slots, probed linearly with the Robin
+ *           Hood rule, and cleaned up with backward shifting on erase; each
+ *           slot holds 32 bits of the hash value, so most mismatching keys
+ *           are rejected without touching the entries;
+ *        2. The entries (i.e., the key-value pairs), stored in chunks whose
+ *           sizes double one after another. Entries never move once they
+ *           are constructed, so growing the index table only rebuilds the
+ *           slots, without hashing any key again, and inserting never
+ *           invalidates references or iterators (except `end()`).
+ *
+ *        A typical lookup touches one cache line of the index table, and the
+ *        entry holding the key. Entries are iterated in the order they were
+ *        inserted, until an erase frees an entry, which is then reused by the
+ *        next insertion (unless `_KeepOrder` is set; see OrderedHashMap).
+ *
+ * @tparam _KeyType      The type of keys
+ * @tparam _ValType      The type of mapped values
+ * @tparam _HashType     The hasher of keys
+ * @tparam _KeyEqualType The equality predicate of keys
+ * @tparam _Alloc        The allocator of key-value pairs; it's rebound to
+ *                       allocate the slots and the chunks of entries
+ * @tparam _KeepOrder    Whether to keep the insertion order after erases
+ */
+template<
+	typename _KeyType,
+	typename _ValType,
+	typename _HashType = std::hash<_KeyType>,
+	typename _KeyEqualType = std::equal_to<_KeyType>,
+	typename _Alloc = std::allocator<std::pair<const _KeyType, _ValType> >,
+	bool _KeepOrder = false>
+class FlatHashMap
+{
+public: // static members
+
+	using Self = FlatHashMap<
+		_KeyType, _ValType, _HashType, _KeyEqualType, _Alloc, _KeepOrder>;
+
+	typedef _KeyType                                key_type;
+	typedef _ValType                                mapped_type;
+	typedef std::pair<const _KeyType, _ValType>     value_type;
+	typedef size_t                                  size_type;
+	typedef std::ptrdiff_t                          difference_type;
+	typedef _HashType                               hasher;
+	typedef _KeyEqualType                           key_equal;
+	typedef _Alloc                                  allocator_type;
+	typedef value_type&                             reference;
+	typedef const value_type&                       const_reference;
+	typedef value_type*                             pointer;
+	typedef const value_type*                       const_pointer;
+
+	template<bool _IsConst>
+	class IteratorImpl;
+
+	typedef IteratorImpl<false>                     iterator;
+	typedef IteratorImpl<true>                      const_iterator;
+
+	static constexpr size_t sk_minCapacity = 8;
+	static constexpr size_t sk_firstChunkSize = 8;
+	static constexpr size_t sk_npos = (std::numeric_limits<size_t>::max)();
+
+	template<bool _IsConst>
+	class IteratorImpl
+	{
+	public: // static members
+
+		template<bool>
+		friend class IteratorImpl;
+
+		using MapPtrType =
+			typename std::conditional<_IsConst, const Self*, Self*>::type;
+
+		typedef std::forward_iterator_tag           iterator_category;
+		typedef std::pair<const _KeyType, _ValType> value_type;
+		typedef std::ptrdiff_t                      difference_type;
+		typedef typename std::conditional<_IsConst,
+			const value_type*, value_type*>::type   pointer;
+		typedef typename std::conditional<_IsConst,
+			const value_type&, value_type&>::type   reference;
+
+	public:
+
+		IteratorImpl() :
+			m_map(nullptr),
+			m_idx(0)
+		{}
+
+		IteratorImpl(MapPtrType map, size_t idx) :
+			m_map(map),
+			m_idx(idx)
+		{}
+
+		template<bool _OtherIsConst,
+			typename std::enable_if<
+				_IsConst && !_OtherIsConst, int>::type = 0>
+		IteratorImpl(const IteratorImpl<_OtherIsConst>& other) :
+			m_map(other.m_map),
+			m_idx(other.m_idx)
+		{}
+
+		reference operator*() const
+		{
+			return m_map->EntryAt(m_idx).Value();
+		}
+
+		pointer operator->() const
+		{
+			return &(m_map->EntryAt(m_idx).Value());
+		}
+
+		IteratorImpl& operator++()
+		{
+			m_idx = m_map->NextAlive(m_idx + 1);
+			return *this;
+		}
+
+		IteratorImpl operator++(int)
+		{
+			IteratorImpl tmp(*this);
+			++(*this);
+			return tmp;
+		}
+
+		bool operator==(const IteratorImpl& rhs) const
+		{
+			return (m_map == rhs.m_map) && (m_idx == rhs.m_idx);
+		}
+
+		bool operator!=(const IteratorImpl& rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+		size_t GetIdx() const
+		{
+			return m_idx;
+		}
+
+	private:
+
+		MapPtrType m_map;
+		size_t m_idx;
+
+	}; // class IteratorImpl
+
+public:
+
+	FlatHashMap() :
+		FlatHashMap(allocator_type())
+	{}
+
+	explicit FlatHashMap(const allocator_type& alloc) :
+		m_alloc(alloc),
+		m_hasher(),
+		m_keyEq(),
+		m_slots(nullptr),
+		m_capacity(0),
+		m_chunks(nullptr),
+		m_numChunks(0),
+		m_numEntries(0),
+		m_size(0),
+		m_freeHead(0)
+	{}
+
+	FlatHashMap(
+		std::initializer_list<value_type> l,
+		const allocator_type& alloc = allocator_type()) :
+		FlatHashMap(alloc)
+	{
+		reserve(l.size());
+		for (const auto& item : l)
+		{
+			insert(item);
+		}
+	}
+
+	FlatHashMap(const Self& other) :
+		FlatHashMap(
+			other,
+			AllocTraits::select_on_container_copy_construction(other.m_alloc))
+	{}
+
+	FlatHashMap(const Self& other, const allocator_type& alloc) :
+		m_alloc(alloc),
+		m_hasher(other.m_hasher),
+		m_keyEq(other.m_keyEq),
+		m_slots(nullptr),
+		m_capacity(0),
+		m_chunks(nullptr),
+		m_numChunks(0),
+		m_numEntries(0),
+		m_size(0),
+		m_freeHead(0)
+	{
+		CopyFrom(other);
+	}
+
+	FlatHashMap(Self&& other) noexcept :
+		m_alloc(other.m_alloc),
+		m_hasher(std::move(other.m_hasher)),
+		m_keyEq(std::move(other.m_keyEq)),
+		m_slots(other.m_slots),
+		m_capacity(other.m_capacity),
+		m_chunks(other.m_chunks),
+		m_numChunks(other.m_numChunks),
+		m_numEntries(other.m_numEntries),
+		m_size(other.m_size),
+		m_freeHead(other.m_freeHead)
+	{
+		other.Forget();
+	}
+
+	~FlatHashMap()
+	{
+		Release();
+	}
+
+	Self& operator=(const Self& rhs)
+	{
+		if (this != &rhs)
+		{
+			Release();
+			AssignAlloc(m_alloc, rhs.m_alloc,
+				typename AllocTraits::propagate_on_container_copy_assignment());
+			m_hasher = rhs.m_hasher;
+			m_keyEq = rhs.m_keyEq;
+			CopyFrom(rhs);
+		}
+		return *this;
+	}
+
+	Self& operator=(Self&& rhs)
+	{
+		if (this != &rhs)
+		{
+			Release();
+			m_hasher = std::move(rhs.m_hasher);
+			m_keyEq = std::move(rhs.m_keyEq);
+			if (AllocTraits::propagate_on_container_move_assignment::value ||
+				(m_alloc == rhs.m_alloc))
+			{
+				AssignAlloc(m_alloc, rhs.m_alloc,
+					typename AllocTraits::propagate_on_container_move_assignment());
+				m_slots = rhs.m_slots;
+				m_capacity = rhs.m_capacity;
+				m_chunks = rhs.m_chunks;
+				m_numChunks = rhs.m_numChunks;
+				m_numEntries = rhs.m_numEntries;
+				m_size = rhs.m_size;
+				m_freeHead = rhs.m_freeHead;
+				rhs.Forget();
+			}
+			else
+			{
+				// the memory can't be taken over by a different allocator
+				CopyFrom(rhs);
+			}
+		}
+		return *this;
+	}
+
+	allocator_type get_allocator() const
+	{
+		return m_alloc;
+	}
+
+	hasher hash_function() const
+	{
+		return m_hasher;
+	}
+
+	key_equal key_eq() const
+	{
+		return m_keyEq;
+	}
+
+	// ========== capacity ==========
+
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	size_t size() const
+	{
+		return m_size;
+	}
+
+	/**
+	 * @brief Get the number of slots in the index table
+	 *
+	 */
+	size_t bucket_count() const
+	{
+		return m_capacity;
+	}
+
+	/**
+	 * @brief Make room for `n` key-value pairs, so that no rehash happens
+	 *        until the size exceeds `n`
+	 *
+	 */
+	void reserve(size_t n)
+	{
+		size_t cap = sk_minCapacity;
+		while (cap * 7 < n * 8)
+		{
+			cap *= 2;
+		}
+		if (cap > m_capacity)
+		{
+			Rehash(cap);
+		}
+	}
+
+	// ========== iterators ==========
+
+	iterator begin()
+	{
+		return iterator(this, NextAlive(0));
+	}
+
+	iterator end()
+	{
+		return iterator(this, m_numEntries);
+	}
+
+	const_iterator begin() const
+	{
+		return cbegin();
+	}
+
+	const_iterator end() const
+	{
+		return cend();
+	}
+
+	const_iterator cbegin() const
+	{
+		return const_iterator(this, NextAlive(0));
+	}
+
+	const_iterator cend() const
+	{
+		return const_iterator(this, m_numEntries);
+	}
+
+	// ========== lookup ==========
+
+	iterator find(const key_type& key)
+	{
+		const size_t idx = FindIdx(key);
+		return idx == sk_npos ? end() : iterator(this, idx);
+	}
+
+	const_iterator find(const key_type& key) const
+	{
+		const size_t idx = FindIdx(key);
+		return idx == sk_npos ? cend() : const_iterator(this, idx);
+	}
+
+	size_t count(const key_type& key) const
+	{
+		return FindIdx(key) == sk_npos ? 0 : 1;
+	}
+
+	mapped_type& at(const key_type& key)
+	{
+		const size_t idx = FindIdx(key);
+		if (idx == sk_npos)
+		{
+			throw std::out_of_range("FlatHashMap::at - key not found");
+		}
+		return EntryAt(idx).Value().second;
+	}
+
+	const mapped_type& at(const key_type& key) const
+	{
+		const size_t idx = FindIdx(key);
+		if (idx == sk_npos)
+		{
+			throw std::out_of_range("FlatHashMap::at - key not found");
+		}
+		return EntryAt(idx).Value().second;
+	}
+
+	mapped_type& operator[](const key_type& key)
+	{
+		return EmplaceImpl(key).first->second;
+	}
+
+	mapped_type& operator[](key_type&& key)
+	{
+		return EmplaceImpl(std::forward<key_type>(key)).first->second;
+	}
+
+	// ========== modifiers ==========
+
+	/**
+	 * @brief Insert a key-value pair, with the mapped value constructed from
+	 *        `args`, if the key is not in the map yet.
+	 *        Different from `std::unordered_map::emplace`, nothing is
+	 *        constructed when the key already exists.
+	 *
+	 * @return A pair of the iterator to the entry with the given key, and
+	 *         whether the insertion took place
+	 */
+	template<typename... _Args>
+	std::pair<iterator, bool> emplace(const key_type& key, _Args&&... args)
+	{
+		return EmplaceImpl(key, std::forward<_Args>(args)...);
+	}
+
+	template<typename... _Args>
+	std::pair<iterator, bool> emplace(key_type&& key, _Args&&... args)
+	{
+		return EmplaceImpl(
+			std::forward<key_type>(key), std::forward<_Args>(args)...);
+	}
+
+	/**
+	 * @brief Same as `emplace`; the hint is ignored
+	 *
+	 */
+	template<typename _KArgType, typename... _Args>
+	iterator emplace_hint(const_iterator, _KArgType&& key, _Args&&... args)
+	{
+		return EmplaceImpl(
+			std::forward<_KArgType>(key),
+			std::forward<_Args>(args)...).first;
+	}
+
+	std::pair<iterator, bool> insert(const value_type& val)
+	{
+		return EmplaceImpl(val.first, val.second);
+	}
+
+	template<typename _PairType>
+	std::pair<iterator, bool> insert(_PairType&& val)
+	{
+		return EmplaceImpl(
+			std::forward<_PairType>(val).first,
+			std::forward<_PairType>(val).second);
+	}
+
+	size_t erase(const key_type& key)
+	{
+		const size_t pos = FindSlot(key, ToFrag(m_hasher(key)));
+		if (pos == sk_npos)
+		{
+			return 0;
+		}
+		EraseSlot(pos);
+		return 1;
+	}
+
+	iterator erase(const_iterator it)
+	{
+		const size_t idx = it.GetIdx();
+		EraseSlot(FindSlotOfEntry(idx));
+		return iterator(this, NextAlive(idx + 1));
+	}
+
+	iterator erase(iterator it)
+	{
+		return erase(const_iterator(it));
+	}
+
+	/**
+	 * @brief Remove all key-value pairs, while keeping the memory allocated
+	 *
+	 */
+	void clear()
+	{
+		DestroyValues();
+		ClearSlots();
+		m_numEntries = 0;
+		m_size = 0;
+		m_freeHead = 0;
+	}
+
+	void swap(Self& other)
+	{
+		using std::swap;
+		SwapAlloc(m_alloc, other.m_alloc,
+			typename AllocTraits::propagate_on_container_swap());
+		swap(m_hasher, other.m_hasher);
+		swap(m_keyEq, other.m_keyEq);
+		swap(m_slots, other.m_slots);
+		swap(m_capacity, other.m_capacity);
+		swap(m_chunks, other.m_chunks);
+		swap(m_numChunks, other.m_numChunks);
+		swap(m_numEntries, other.m_numEntries);
+		swap(m_size, other.m_size);
+		swap(m_freeHead, other.m_freeHead);
+	}
+
+	// ========== operators ==========
+
+	/**
+	 * @brief Two maps are equal if they have the same set of keys, and the
+	 *        same value for each key, regardless of the order
+	 *
+	 */
+	bool operator==(const Self& rhs) const
+	{
+		if (m_size != rhs.m_size)
+		{
+			return false;
+		}
+		for (const auto& item : *this)
+		{
+			const size_t idx = rhs.FindIdx(item.first);
+			if ((idx == sk_npos) ||
+				!(rhs.EntryAt(idx).Value().second == item.second))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool operator!=(const Self& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+private: // static members
+
+	using AllocTraits = std::allocator_traits<allocator_type>;
+
+	/**
+	 * @brief A slot of the index table; `m_idx` is the index of the entry
+	 *        plus one, so that zero marks an empty slot
+	 *
+	 */
+	struct Slot
+	{
+		Slot() :
+			m_frag(0),
+			m_idx(0)
+		{}
+
+		Slot(uint32_t frag, uint32_t idx) :
+			m_frag(frag),
+			m_idx(idx)
+		{}
+
+		uint32_t m_frag;
+		uint32_t m_idx;
+	}; // struct Slot
+
+	/**
+	 * @brief The storage of a key-value pair.
+	 *        When the entry is free, `m_frag` is reused to link to the next
+	 *        free entry (i.e., its index plus one).
+	 *
+	 */
+	struct Entry
+	{
+		uint32_t m_frag;
+		bool m_alive;
+		alignas(value_type) unsigned char m_val[sizeof(value_type)];
+
+		value_type* Ptr()
+		{
+			return reinterpret_cast<value_type*>(m_val);
+		}
+
+		value_type& Value()
+		{
+			return *Ptr();
+		}
+
+		const value_type& Value() const
+		{
+			return *reinterpret_cast<const value_type*>(m_val);
+		}
+	}; // struct Entry
+
+	using SlotAlloc =
+		typename AllocTraits::template rebind_alloc<Slot>;
+	using SlotAllocTraits =
+		typename AllocTraits::template rebind_traits<Slot>;
+	using EntryAlloc =
+		typename AllocTraits::template rebind_alloc<Entry>;
+	using EntryAllocTraits =
+		typename AllocTraits::template rebind_traits<Entry>;
+	using ChunkAlloc =
+		typename AllocTraits::template rebind_alloc<Entry*>;
+	using ChunkAllocTraits =
+		typename AllocTraits::template rebind_traits<Entry*>;
+
+	/**
+	 * @brief Take 32 bits out of the hash value, after a multiplicative mix,
+	 *        so that hashers returning the key itself (e.g., the ones of
+	 *        integers) still spread over the index table
+	 *
+	 */
+	static uint32_t ToFrag(size_t hashVal)
+	{
+		return static_cast<uint32_t>(
+			(static_cast<uint64_t>(hashVal) * 0x9e3779b97f4a7c15ULL) >> 32);
+	}
+
+	static size_t Dist(const Slot& slot, size_t pos, size_t mask)
+	{
+		return (pos - (slot.m_frag & mask)) & mask;
+	}
+
+	static size_t BitWidth(size_t val)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return (sizeof(unsigned long long) * 8) -
+			static_cast<size_t>(
+				__builtin_clzll(static_cast<unsigned long long>(val)));
+#else
+		size_t res = 0;
+		for (; val != 0; val >>= 1)
+		{
+			++res;
+		}
+		return res;
+#endif
+	}
+
+	/**
+	 * @brief The number of entries held by the first `numChunks` chunks
+	 *
+	 */
+	static size_t ChunkedCapacity(size_t numChunks)
+	{
+		return sk_firstChunkSize * ((static_cast<size_t>(1) << numChunks) - 1);
+	}
+
+	/**
+	 * @brief The length of the array of chunk pointers, which grows in
+	 *        powers of 2
+	 *
+	 */
+	static size_t ChunkArrayLen(size_t numChunks)
+	{
+		size_t len = numChunks > 0 ? 1 : 0;
+		while (len < numChunks)
+		{
+			len *= 2;
+		}
+		return len;
+	}
+
+	static void AssignAlloc(
+		allocator_type& dst, const allocator_type& src, std::true_type)
+	{
+		dst = src;
+	}
+
+	static void AssignAlloc(
+		allocator_type&, const allocator_type&, std::false_type)
+	{}
+
+	static void SwapAlloc(allocator_type& a, allocator_type& b, std::true_type)
+	{
+		using std::swap;
+		swap(a, b);
+	}
+
+	static void SwapAlloc(allocator_type&, allocator_type&, std::false_type)
+	{}
+
+private:
+
+	Entry& EntryAt(size_t idx)
+	{
+		const size_t chunk = BitWidth((idx / sk_firstChunkSize) + 1) - 1;
+		return m_chunks[chunk][idx - ChunkedCapacity(chunk)];
+	}
+
+	const Entry& EntryAt(size_t idx) const
+	{
+		const size_t chunk = BitWidth((idx / sk_firstChunkSize) + 1) - 1;
+		return m_chunks[chunk][idx - ChunkedCapacity(chunk)];
+	}
+
+	size_t NextAlive(size_t idx) const
+	{
+		while ((idx < m_numEntries) && !EntryAt(idx).m_alive)
+		{
+			++idx;
+		}
+		return idx;
+	}
+
+	size_t FindSlot(const key_type& key, uint32_t frag) const
+	{
+		if (m_size == 0)
+		{
+			return sk_npos;
+		}
+
+		const size_t mask = m_capacity - 1;
+		size_t pos = frag & mask;
+		for (size_t dist = 0; ; ++dist)
+		{
+			const Slot& slot = m_slots[pos];
+			if ((slot.m_idx == 0) || (Dist(slot, pos, mask) < dist))
+			{
+				// any slot holding the key would have taken this place
+				return sk_npos;
+			}
+			if ((slot.m_frag == frag) &&
+				m_keyEq(EntryAt(slot.m_idx - 1).Value().first, key))
+			{
+				return pos;
+			}
+			pos = (pos + 1) & mask;
+		}
+	}
+
+	size_t FindSlotOfEntry(size_t idx) const
+	{
+		const size_t mask = m_capacity - 1;
+		size_t pos = EntryAt(idx).m_frag & mask;
+		while (m_slots[pos].m_idx != idx + 1)
+		{
+			pos = (pos + 1) & mask;
+		}
+		return pos;
+	}
+
+	size_t FindIdx(const key_type& key) const
+	{
+		const size_t pos = FindSlot(key, ToFrag(m_hasher(key)));
+		return pos == sk_npos ? sk_npos : (m_slots[pos].m_idx - 1);
+	}
+
+	template<typename _KArgType, typename... _Args>
+	std::pair<iterator, bool> EmplaceImpl(_KArgType&& key, _Args&&... args)
+	{
+		const uint32_t frag = ToFrag(m_hasher(key));
+		const size_t pos = FindSlot(key, frag);
+		if (pos != sk_npos)
+		{
+			return std::make_pair(
+				iterator(this, m_slots[pos].m_idx - 1), false);
+		}
+
+		if ((m_size + 1) * 8 > m_capacity * 7)
+		{
+			Rehash(m_capacity == 0 ? sk_minCapacity : (m_capacity * 2));
+		}
+
+		const size_t idx = AcquireEntry();
+		Entry& entry = EntryAt(idx);
+		try
+		{
+			AllocTraits::construct(m_alloc, entry.Ptr(),
+				std::piecewise_construct,
+				std::forward_as_tuple(std::forward<_KArgType>(key)),
+				std::forward_as_tuple(std::forward<_Args>(args)...));
+		}
+		catch(...)
+		{
+			ReleaseEntry(idx);
+			throw;
+		}
+		entry.m_frag = frag;
+		entry.m_alive = true;
+		++m_size;
+
+		PlaceSlot(Slot(frag, static_cast<uint32_t>(idx + 1)));
+		return std::make_pair(iterator(this, idx), true);
+	}
+
+	/**
+	 * @brief Put a slot into the index table; on the way, the slot takes the
+	 *        place of any slot that is closer to its home position, which is
+	 *        then carried forward instead
+	 *
+	 */
+	void PlaceSlot(Slot slot)
+	{
+		const size_t mask = m_capacity - 1;
+		size_t pos = slot.m_frag & mask;
+		for (size_t dist = 0; ; ++dist)
+		{
+			Slot& cur = m_slots[pos];
+			if (cur.m_idx == 0)
+			{
+				cur = slot;
+				return;
+			}
+			const size_t curDist = Dist(cur, pos, mask);
+			if (curDist < dist)
+			{
+				std::swap(cur, slot);
+				dist = curDist;
+			}
+			pos = (pos + 1) & mask;
+		}
+	}
+
+	void EraseSlot(size_t pos)
+	{
+		const size_t idx = m_slots[pos].m_idx - 1;
+
+		// shift the following slots back, so no tombstone is needed
+		const size_t mask = m_capacity - 1;
+		size_t next = (pos + 1) & mask;
+		while ((m_slots[next].m_idx != 0) &&
+			(Dist(m_slots[next], next, mask) != 0))
+		{
+			m_slots[pos] = m_slots[next];
+			pos = next;
+			next = (next + 1) & mask;
+		}
+		m_slots[pos] = Slot();
+
+		AllocTraits::destroy(m_alloc, EntryAt(idx).Ptr());
+		ReleaseEntry(idx);
+		--m_size;
+	}
+
+	void Rehash(size_t capacity)
+	{
+		SlotAlloc slotAlloc(m_alloc);
+		Slot* slots = SlotAllocTraits::allocate(slotAlloc, capacity);
+		for (size_t i = 0; i < capacity; ++i)
+		{
+			SlotAllocTraits::construct(slotAlloc, slots + i);
+		}
+
+		Slot* oldSlots = m_slots;
+		const size_t oldCapacity = m_capacity;
+		m_slots = slots;
+		m_capacity = capacity;
+		PlaceAllSlots();
+
+		if (oldSlots != nullptr)
+		{
+			SlotAllocTraits::deallocate(slotAlloc, oldSlots, oldCapacity);
+		}
+	}
+
+	/**
+	 * @brief Put the slots of all live entries into the index table, which
+	 *        must be empty
+	 *
+	 */
+	void PlaceAllSlots()
+	{
+		for (size_t i = 0; i < m_numEntries; ++i)
+		{
+			const Entry& entry = EntryAt(i);
+			if (entry.m_alive)
+			{
+				PlaceSlot(Slot(entry.m_frag, static_cast<uint32_t>(i + 1)));
+			}
+		}
+	}
+
+	/**
+	 * @brief Move the live entries to the front, in order, to reclaim the
+	 *        entries erased from an order-keeping map.
+	 *        Since keys are const, they are copied rather than moved.
+	 *
+	 */
+	void Compact()
+	{
+		try
+		{
+			size_t dst = 0;
+			for (size_t src = 0; src < m_numEntries; ++src)
+			{
+				Entry& srcEntry = EntryAt(src);
+				if (!srcEntry.m_alive)
+				{
+					continue;
+				}
+				if (src != dst)
+				{
+					Entry& dstEntry = EntryAt(dst);
+					AllocTraits::construct(m_alloc, dstEntry.Ptr(),
+						std::move(srcEntry.Value()));
+					dstEntry.m_frag = srcEntry.m_frag;
+					dstEntry.m_alive = true;
+					AllocTraits::destroy(m_alloc, srcEntry.Ptr());
+					srcEntry.m_alive = false;
+				}
+				++dst;
+			}
+			m_numEntries = dst;
+		}
+		catch(...)
+		{
+			// the live entries are still valid, but some of them have moved
+			ClearSlots();
+			PlaceAllSlots();
+			throw;
+		}
+		ClearSlots();
+		PlaceAllSlots();
+	}
+
+	void ClearSlots()
+	{
+		for (size_t i = 0; i < m_capacity; ++i)
+		{
+			m_slots[i] = Slot();
+		}
+	}
+
+	size_t AcquireEntry()
+	{
+		if (m_freeHead != 0)
+		{
+			const size_t idx = m_freeHead - 1;
+			m_freeHead = EntryAt(idx).m_frag;
+			return idx;
+		}
+
+		if (m_numEntries >= (std::numeric_limits<uint32_t>::max)() - 1)
+		{
+			throw std::length_error("FlatHashMap - too many entries");
+		}
+		if (_KeepOrder)
+		{
+			// the holes at the end can be reclaimed right away
+			while ((m_numEntries > 0) && !EntryAt(m_numEntries - 1).m_alive)
+			{
+				--m_numEntries;
+			}
+			if ((m_numEntries == ChunkedCapacity(m_numChunks)) &&
+				((m_numEntries - m_size) * 2 >= m_numEntries))
+			{
+				// at least half of the entries are erased; reclaim them,
+				// instead of allocating a new chunk
+				Compact();
+			}
+		}
+		if (m_numEntries == ChunkedCapacity(m_numChunks))
+		{
+			AddChunk();
+		}
+		EntryAt(m_numEntries).m_alive = false;
+		return m_numEntries++;
+	}
+
+	void ReleaseEntry(size_t idx)
+	{
+		Entry& entry = EntryAt(idx);
+		entry.m_alive = false;
+		// an order-keeping map leaves the entry as a hole (see AcquireEntry)
+		if (!_KeepOrder)
+		{
+			entry.m_frag = m_freeHead;
+			m_freeHead = static_cast<uint32_t>(idx + 1);
+		}
+	}
+
+	void AddChunk()
+	{
+		EntryAlloc entryAlloc(m_alloc);
+		Entry* chunk = EntryAllocTraits::allocate(
+			entryAlloc, sk_firstChunkSize << m_numChunks);
+
+		const size_t arrLen = ChunkArrayLen(m_numChunks);
+		if (m_numChunks == arrLen)
+		{
+			ChunkAlloc chunkAlloc(m_alloc);
+			Entry** chunks = nullptr;
+			try
+			{
+				chunks = ChunkAllocTraits::allocate(
+					chunkAlloc, arrLen > 0 ? (arrLen * 2) : 1);
+			}
+			catch(...)
+			{
+				EntryAllocTraits::deallocate(
+					entryAlloc, chunk, sk_firstChunkSize << m_numChunks);
+				throw;
+			}
+			for (size_t i = 0; i < m_numChunks; ++i)
+			{
+				chunks[i] = m_chunks[i];
+			}
+			if (m_chunks != nullptr)
+			{
+				ChunkAllocTraits::deallocate(chunkAlloc, m_chunks, arrLen);
+			}
+			m_chunks = chunks;
+		}
+
+		m_chunks[m_numChunks++] = chunk;
+	}
+
+	/**
+	 * @brief Copy the entries and the index table of `other` as they are, so
+	 *        that no key is hashed again; this map must be empty
+	 *
+	 */
+	void CopyFrom(const Self& other)
+	{
+		try
+		{
+			if (other.m_capacity > 0)
+			{
+				Rehash(other.m_capacity);
+				for (size_t i = 0; i < m_capacity; ++i)
+				{
+					m_slots[i] = other.m_slots[i];
+				}
+			}
+			for (size_t i = 0; i < other.m_numEntries; ++i)
+			{
+				if (m_numEntries == ChunkedCapacity(m_numChunks))
+				{
+					AddChunk();
+				}
+				const Entry& src = other.EntryAt(i);
+				Entry& dst = EntryAt(i);
+				dst.m_frag = src.m_frag;
+				dst.m_alive = false;
+				if (src.m_alive)
+				{
+					AllocTraits::construct(m_alloc, dst.Ptr(), src.Value());
+					dst.m_alive = true;
+				}
+				++m_numEntries;
+			}
+			m_size = other.m_size;
+			m_freeHead = other.m_freeHead;
+		}
+		catch(...)
+		{
+			Release();
+			throw;
+		}
+	}
+
+	void DestroyValues()
+	{
+		for (size_t i = 0; i < m_numEntries; ++i)
+		{
+			Entry& entry = EntryAt(i);
+			if (entry.m_alive)
+			{
+				AllocTraits::destroy(m_alloc, entry.Ptr());
+				entry.m_alive = false;
+			}
+		}
+	}
+
+	void Release()
+	{
+		DestroyValues();
+
+		EntryAlloc entryAlloc(m_alloc);
+		for (size_t i = 0; i < m_numChunks; ++i)
+		{
+			EntryAllocTraits::deallocate(
+				entryAlloc, m_chunks[i], sk_firstChunkSize << i);
+		}
+		if (m_chunks != nullptr)
+		{
+			ChunkAlloc chunkAlloc(m_alloc);
+			ChunkAllocTraits::deallocate(
+				chunkAlloc, m_chunks, ChunkArrayLen(m_numChunks));
+		}
+		if (m_slots != nullptr)
+		{
+			SlotAlloc slotAlloc(m_alloc);
+			SlotAllocTraits::deallocate(slotAlloc, m_slots, m_capacity);
+		}
+
+		Forget();
+	}
+
+	/**
+	 * @brief Drop the references to the memory, which has been released or
+	 *        taken over by another map
+	 *
+	 */
+	void Forget()
+	{
+		m_slots = nullptr;
+		m_capacity = 0;
+		m_chunks = nullptr;
+		m_numChunks = 0;
+		m_numEntries = 0;
+		m_size = 0;
+		m_freeHead = 0;
+	}
+
+	allocator_type m_alloc;
+	hasher m_hasher;
+	key_equal m_keyEq;
+	Slot* m_slots;
+	size_t m_capacity;
+	Entry** m_chunks;
+	size_t m_numChunks;
+	size_t m_numEntries;
+	size_t m_size;
+	uint32_t m_freeHead;
+
+}; // class FlatHashMap
+
+template<typename _KeyType, typename _ValType,
+	typename _HashType, typename _KeyEqualType, typename _Alloc, bool _KeepOrder>
+constexpr size_t FlatHashMap<_KeyType, _ValType,
+	_HashType, _KeyEqualType, _Alloc, _KeepOrder>::sk_minCapacity;
+
+template<typename _KeyType, typename _ValType,
+	typename _HashType, typename _KeyEqualType, typename _Alloc, bool _KeepOrder>
+constexpr size_t FlatHashMap<_KeyType, _ValType,
+	_HashType, _KeyEqualType, _Alloc, _KeepOrder>::sk_firstChunkSize;
+
+template<typename _KeyType, typename _ValType,
+	typename _HashType, typename _KeyEqualType, typename _Alloc, bool _KeepOrder>
+constexpr size_t FlatHashMap<_KeyType, _ValType,
+	_HashType, _KeyEqualType, _Alloc, _KeepOrder>::sk_npos;
+
+/**
+ * @brief A FlatHashMap that always iterates its entries in the order they
+ *        were inserted, like the compact dict of CPython.
+ *        Erased entries are left as holes, which are skipped by iterators,
+ *        and reclaimed when a new chunk of entries would otherwise be
+ *        needed; thus, unlike FlatHashMap, insertions may move entries, and
+ *        invalidate references and iterators to them.
+ *
+ */
+template<
+	typename _KeyType,
+	typename _ValType,
+	typename _HashType = std::hash<_KeyType>,
+	typename _KeyEqualType = std::equal_to<_KeyType>,
+	typename _Alloc = std::allocator<std::pair<const _KeyType, _ValType> > >
+using OrderedHashMap = FlatHashMap<
+	_KeyType, _ValType, _HashType, _KeyEqualType, _Alloc, true>;
+
+} // namespace SimpleObjects
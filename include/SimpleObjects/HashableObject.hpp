@@ -8,8 +8,13 @@
 #include "HashableBaseObject.hpp"
 
 #include <memory>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
 
 #include "Null.hpp"
+#include "Internal/ObjTag.hpp"
+#include "Internal/SmallObjPtr.hpp"
 
 #ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 namespace SimpleObjects
@@ -32,6 +37,11 @@ public: // Static members
 		"Expecting Base::Base to be BaseObject class");
 
 	using BasePtr = std::unique_ptr<Base>;
+	using ObjPtr = Internal::SmallObjPtr<Base, SIMPLEOBJECTS_OBJECT_INLINE_SIZE>;
+
+	template<typename _ObjType>
+	using IsInlineObj = typename ObjPtr::template CanInline<
+		typename std::decay<_ObjType>::type>;
 
 	using NullBase      = typename Base::NullBase;
 	using RealNumBase   = typename Base::RealNumBase;
@@ -40,6 +50,7 @@ public: // Static members
 	using DictBase      = typename Base::DictBase;
 	using StatDictBase  = typename Base::StatDictBase;
 	using BytesBase     = typename Base::BytesBase;
+	using TupleBase     = typename Base::TupleBase;
 	using HashableBase  = typename Base::HashableBase;
 
 public:
@@ -48,48 +59,88 @@ public:
 	{}
 
 	HashableObjectImpl(const Self& other) :
-		HashableObjectImpl(*other.m_ptr)
+		m_ptr(other.m_ptr),
+		m_tag(other.m_tag)
 	{}
 
 	HashableObjectImpl(Self&& other) :
-		m_ptr(std::forward<BasePtr>(other.m_ptr))
-	{}
+		m_ptr(std::move(other.m_ptr)),
+		m_tag(other.m_tag)
+	{
+		other.m_tag = MakeTag(other.m_ptr);
+	}
 
 	HashableObjectImpl(const Base& other) :
-		m_ptr(other.Copy(Base::sk_null))
+		m_ptr(CopyPtr(other)),
+		m_tag(MakeTag(m_ptr))
 	{}
 
 	HashableObjectImpl(Base&& other) :
-		m_ptr(other.Move(Base::sk_null))
+		m_ptr(MovePtr(std::forward<Base>(other))),
+		m_tag(MakeTag(m_ptr))
 	{}
 
 	HashableObjectImpl(BasePtr other) :
-		m_ptr(std::move(other))
+		m_ptr(std::move(other)),
+		m_tag(MakeTag(m_ptr))
+	{}
+
+	/**
+	 * @brief Construct from an object whose concrete type is known at
+	 *        compile time, so that it can be stored in place if it's small
+	 *        enough, without any heap allocation
+	 *
+	 */
+	template<typename _ObjType,
+		typename std::enable_if<
+			IsInlineObj<_ObjType>::value, int
+		>::type = 0>
+	HashableObjectImpl(_ObjType&& other) :
+		m_ptr(ObjPtr::template MakeFrom<typename std::decay<_ObjType>::type>(
+			std::forward<_ObjType>(other))),
+		m_tag(MakeTag(m_ptr))
 	{}
 
 	virtual ~HashableObjectImpl() = default;
 
 	Self& operator=(const Self& rhs)
 	{
-		*this = *rhs.m_ptr;
+		m_ptr = rhs.m_ptr;
+		m_tag = rhs.m_tag;
 		return *this;
 	}
 
 	Self& operator=(Self&& rhs)
 	{
-		m_ptr = std::forward<BasePtr>(rhs.m_ptr);
+		m_ptr = std::move(rhs.m_ptr);
+		m_tag = rhs.m_tag;
+		rhs.m_tag = MakeTag(rhs.m_ptr);
 		return *this;
 	}
 
 	Self& operator=(const Base& rhs)
 	{
-		m_ptr = rhs.Copy(Base::sk_null);
+		m_ptr = CopyPtr(rhs);
+		m_tag = MakeTag(m_ptr);
 		return *this;
 	}
 
 	Self& operator=(Base&& rhs)
 	{
-		m_ptr = rhs.Move(Base::sk_null);
+		m_ptr = MovePtr(std::forward<Base>(rhs));
+		m_tag = MakeTag(m_ptr);
+		return *this;
+	}
+
+	template<typename _ObjType,
+		typename std::enable_if<
+			IsInlineObj<_ObjType>::value, int
+		>::type = 0>
+	Self& operator=(_ObjType&& rhs)
+	{
+		m_ptr = ObjPtr::template MakeFrom<typename std::decay<_ObjType>::type>(
+			std::forward<_ObjType>(rhs));
+		m_tag = MakeTag(m_ptr);
 		return *this;
 	}
 
@@ -134,7 +185,7 @@ public:
 
 	virtual ObjCategory GetCategory() const override
 	{
-		return m_ptr->GetCategory();
+		return m_tag.m_cat;
 	}
 
 	virtual const char* GetCategoryName() const override
@@ -194,47 +245,71 @@ public:
 
 	virtual bool IsNull() const override
 	{
-		return m_ptr->IsNull();
+		return m_tag.m_cat == ObjCategory::Null;
 	}
 
 	virtual bool IsTrue() const override
 	{
-		return m_ptr->IsTrue();
+		return m_tag.IsRealNumImpl() ?
+			Internal::RealNumTagVisit<bool, ToStringType>(
+				m_tag.m_numType, *m_ptr, Internal::RealNumIsTrueOp()) :
+			m_ptr->IsTrue();
 	}
 
 	virtual uint8_t AsCppUInt8() const override
 	{
-		return m_ptr->AsCppUInt8();
+		return m_tag.IsRealNumImpl() ?
+			Internal::RealNumTagVisit<uint8_t, ToStringType>(
+				m_tag.m_numType, *m_ptr, Internal::RealNumCastOp<uint8_t>()) :
+			m_ptr->AsCppUInt8();
 	}
 
 	virtual int8_t AsCppInt8() const override
 	{
-		return m_ptr->AsCppInt8();
+		return m_tag.IsRealNumImpl() ?
+			Internal::RealNumTagVisit<int8_t, ToStringType>(
+				m_tag.m_numType, *m_ptr, Internal::RealNumCastOp<int8_t>()) :
+			m_ptr->AsCppInt8();
 	}
 
 	virtual uint32_t AsCppUInt32() const override
 	{
-		return m_ptr->AsCppUInt32();
+		return m_tag.IsRealNumImpl() ?
+			Internal::RealNumTagVisit<uint32_t, ToStringType>(
+				m_tag.m_numType, *m_ptr, Internal::RealNumCastOp<uint32_t>()) :
+			m_ptr->AsCppUInt32();
 	}
 
 	virtual int32_t AsCppInt32() const override
 	{
-		return m_ptr->AsCppInt32();
+		return m_tag.IsRealNumImpl() ?
+			Internal::RealNumTagVisit<int32_t, ToStringType>(
+				m_tag.m_numType, *m_ptr, Internal::RealNumCastOp<int32_t>()) :
+			m_ptr->AsCppInt32();
 	}
 
 	virtual uint64_t AsCppUInt64() const override
 	{
-		return m_ptr->AsCppUInt64();
+		return m_tag.IsRealNumImpl() ?
+			Internal::RealNumTagVisit<uint64_t, ToStringType>(
+				m_tag.m_numType, *m_ptr, Internal::RealNumCastOp<uint64_t>()) :
+			m_ptr->AsCppUInt64();
 	}
 
 	virtual int64_t AsCppInt64() const override
 	{
-		return m_ptr->AsCppInt64();
+		return m_tag.IsRealNumImpl() ?
+			Internal::RealNumTagVisit<int64_t, ToStringType>(
+				m_tag.m_numType, *m_ptr, Internal::RealNumCastOp<int64_t>()) :
+			m_ptr->AsCppInt64();
 	}
 
 	virtual double AsCppDouble() const override
 	{
-		return m_ptr->AsCppDouble();
+		return m_tag.IsRealNumImpl() ?
+			Internal::RealNumTagVisit<double, ToStringType>(
+				m_tag.m_numType, *m_ptr, Internal::RealNumCastOp<double>()) :
+			m_ptr->AsCppDouble();
 	}
 
 	virtual NullBase& AsNull() override
@@ -307,6 +382,16 @@ public:
 		return m_ptr->AsBytes();
 	}
 
+	virtual TupleBase& AsTuple() override
+	{
+		return m_ptr->AsTuple();
+	}
+
+	virtual const TupleBase& AsTuple() const override
+	{
+		return m_ptr->AsTuple();
+	}
+
 	virtual HashableBase& AsHashable() override
 	{
 		return m_ptr->AsHashable();
@@ -383,7 +468,33 @@ public:
 
 private:
 
-	BasePtr m_ptr;
+	static ObjPtr CopyPtr(const Base& other)
+	{
+		const Self* otherObj = dynamic_cast<const Self*>(&other);
+		if (otherObj != nullptr)
+		{
+			return otherObj->m_ptr;
+		}
+		return ObjPtr(other.Copy(Base::sk_null));
+	}
+
+	static ObjPtr MovePtr(Base&& other)
+	{
+		Self* otherObj = dynamic_cast<Self*>(&other);
+		if (otherObj != nullptr)
+		{
+			return std::move(otherObj->m_ptr);
+		}
+		return ObjPtr(other.Move(Base::sk_null));
+	}
+
+	static Internal::ObjTag MakeTag(const ObjPtr& ptr)
+	{
+		return Internal::ObjTag::Make(ptr.get());
+	}
+
+	ObjPtr m_ptr;
+	Internal::ObjTag m_tag;
 
 }; // class HashableObjectImpl
 
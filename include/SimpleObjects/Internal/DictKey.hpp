@@ -6,10 +6,9 @@
 #pragma once
 
 #include <functional>
-#include <memory>
+#include <new>
 #include <type_traits>
-
-#include "make_unique.hpp"
+#include <utility>
 
 #ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 namespace SimpleObjects
@@ -20,6 +19,14 @@ namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 namespace Internal
 {
 
+/**
+ * @brief The key stored in the containers of Dict; it either owns a key,
+ *        which is stored inside this object (so the key of a key-value pair
+ *        sits right in the container node, without a heap allocation of its
+ *        own), or borrows a key owned by someone else, which is used to look
+ *        up keys in the container without copying them.
+ *
+ */
 template<typename _ValType, typename _BasePtrType>
 class DictKeyImpl
 {
@@ -49,54 +56,59 @@ public: // static members
 	template<typename... _T>
 	static Self Make(_T&&... val)
 	{
-		return DictKeyImpl(std::forward<_T>(val)...);
+		return DictKeyImpl(OwnTag(), std::forward<_T>(val)...);
 	}
 
 public:
 
 	DictKeyImpl(DictKeyImpl&& other) :
-		m_val(std::forward<std::unique_ptr<_ValType> >(other.m_val)),
-		m_valPtr(
-			m_val.get() != nullptr ?
-			m_val.get() :
-			other.m_valPtr),
-		m_basePtr(
-			m_val.get() != nullptr ?
-			m_val.get() :
-			other.m_basePtr)
+		m_isOwner(false),
+		m_valPtr(other.m_valPtr),
+		m_basePtr(other.m_basePtr)
 	{
-		other.m_valPtr = nullptr;
-		other.m_basePtr = nullptr;
+		if (other.m_isOwner)
+		{
+			Construct(std::move(other.ValRef()));
+		}
+		else
+		{
+			other.m_valPtr = nullptr;
+			other.m_basePtr = nullptr;
+		}
 	}
 
 	DictKeyImpl(const DictKeyImpl& other) :
-		m_val(
-			other.m_val.get() != nullptr ?
-			Internal::make_unique<_ValType>(*(other.m_val)) :
-			nullptr),
-		m_valPtr(
-			m_val.get() != nullptr ?
-			m_val.get() :
-			other.m_valPtr),
-		m_basePtr(
-			m_val.get() != nullptr ?
-			m_val.get() :
-			other.m_basePtr)
-	{}
+		m_isOwner(false),
+		m_valPtr(other.m_valPtr),
+		m_basePtr(other.m_basePtr)
+	{
+		if (other.m_isOwner)
+		{
+			Construct(other.ValRef());
+		}
+	}
 
 	Self& operator=(const Self& rhs)
 	{
 		if (this != &rhs)
 		{
-			m_val = rhs.m_val.get() != nullptr ?
-				Internal::make_unique<_ValType>(*(rhs.m_val)) :
-				nullptr;
-			m_valPtr = m_val.get() != nullptr ?
-				m_val.get() :
-				rhs.m_valPtr;
-			m_basePtr = m_val.get() != nullptr ?
-				m_val.get() :
-				rhs.m_basePtr;
+			if (m_isOwner && rhs.m_isOwner)
+			{
+				ValRef() = rhs.ValRef();
+			}
+			else
+			{
+				Reset();
+				if (rhs.m_isOwner)
+				{
+					Construct(rhs.ValRef());
+				}
+				else
+				{
+					m_valPtr = rhs.m_valPtr;
+					m_basePtr = rhs.m_basePtr;
+				}
+			}
 		}
 		return *this;
 	}
@@ -105,30 +117,42 @@ public:
 	{
 		if (this != &rhs)
 		{
-			m_val = std::forward<std::unique_ptr<_ValType> >(rhs.m_val);
-			m_valPtr = m_val.get() != nullptr ?
-				m_val.get() :
-				rhs.m_valPtr;
-			m_basePtr = m_val.get() != nullptr ?
-				m_val.get() :
-				rhs.m_basePtr;
-
-			rhs.m_valPtr = nullptr;
-			rhs.m_basePtr = nullptr;
+			if (m_isOwner && rhs.m_isOwner)
+			{
+				ValRef() = std::move(rhs.ValRef());
+			}
+			else
+			{
+				Reset();
+				if (rhs.m_isOwner)
+				{
+					Construct(std::move(rhs.ValRef()));
+				}
+				else
+				{
+					m_valPtr = rhs.m_valPtr;
+					m_basePtr = rhs.m_basePtr;
+					rhs.m_valPtr = nullptr;
+					rhs.m_basePtr = nullptr;
+				}
+			}
 		}
 		return *this;
 	}
 
-	~DictKeyImpl() = default;
+	~DictKeyImpl()
+	{
+		Reset();
+	}
 
 	conference GetVal()
 	{
-		return *m_val;
+		return ValRef();
 	}
 
 	const_conference GetVal() const
 	{
-		return *m_val;
+		return ValRef();
 	}
 
 	const _BasePtrType* GetBasePtr() const
@@ -136,6 +160,11 @@ public:
 		return m_basePtr;
 	}
 
+	bool IsOwner() const
+	{
+		return m_isOwner;
+	}
+
 	std::size_t Hash() const
 	{
 		return m_basePtr->Hash();
@@ -155,29 +184,66 @@ public:
 				(*m_basePtr < *(rhs.m_basePtr));
 	}
 
+private: // static members
+
+	struct OwnTag {};
+
 private:
 
 	template<typename... _T>
-	explicit DictKeyImpl(_T&&... val) :
-		m_val(Internal::make_unique<_ValType>(
-			std::forward<_T>(val)...)),
-		m_valPtr(m_val.get()),
-		m_basePtr(m_val.get())
-	{}
+	explicit DictKeyImpl(OwnTag, _T&&... val) :
+		m_isOwner(false),
+		m_valPtr(nullptr),
+		m_basePtr(nullptr)
+	{
+		Construct(std::forward<_T>(val)...);
+	}
 
 	explicit DictKeyImpl(const _BasePtrType* basePtr) :
-		m_val(),
+		m_isOwner(false),
 		m_valPtr(nullptr),
 		m_basePtr(basePtr)
 	{}
 
 	explicit DictKeyImpl(const _ValType* valPtr) :
-		m_val(),
+		m_isOwner(false),
 		m_valPtr(valPtr),
 		m_basePtr(valPtr)
 	{}
 
-	std::unique_ptr<_ValType> m_val;
+	_ValType& ValRef()
+	{
+		return *reinterpret_cast<_ValType*>(m_val);
+	}
+
+	const _ValType& ValRef() const
+	{
+		return *reinterpret_cast<const _ValType*>(m_val);
+	}
+
+	template<typename... _T>
+	void Construct(_T&&... val)
+	{
+		_ValType* ptr = ::new (static_cast<void*>(m_val))
+			_ValType(std::forward<_T>(val)...);
+		m_isOwner = true;
+		m_valPtr = ptr;
+		m_basePtr = ptr;
+	}
+
+	void Reset()
+	{
+		if (m_isOwner)
+		{
+			ValRef().~_ValType();
+			m_isOwner = false;
+		}
+		m_valPtr = nullptr;
+		m_basePtr = nullptr;
+	}
+
+	alignas(_ValType) unsigned char m_val[sizeof(_ValType)];
+	bool m_isOwner;
 	const _ValType* m_valPtr;
 	const _BasePtrType* m_basePtr;
 
@@ -0,0 +1,108 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "../BasicDefs.hpp"
+#include "../Compare.hpp"
+#include "../Exception.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Internal
+{
+
+/**
+ * @brief The rank of a category in the order of keys; numbers of all
+ *        categories (i.e., bool, integer, and real) share the same rank,
+ *        since they are compared with each other by values
+ *
+ */
+inline int ObjCategoryKeyRank(ObjCategory cat)
+{
+	switch (cat)
+	{
+	case ObjCategory::Bool:
+	case ObjCategory::Real:
+		return static_cast<int>(ObjCategory::Integer);
+	default:
+		return static_cast<int>(cat);
+	}
+}
+
+/**
+ * @brief Three-way compare two hashable objects, in a total order that can
+ *        be used to sort keys of a Dict.
+ *        Objects are compared by `BaseObjectCompare` first; objects that
+ *        are not comparable with each other are ordered by their categories
+ *        (in the order of `ObjCategory`), and tuples are compared item by
+ *        item, in the same way.
+ *
+ * @return negative if `a` is less than `b`, zero if they are equal, or
+ *         positive if `a` is greater than `b`
+ */
+template<typename _HashableType>
+inline int ObjectKeyCompare(const _HashableType& a, const _HashableType& b)
+{
+	switch (a.BaseObjectCompare(b))
+	{
+	case ObjectOrder::Less:
+		return -1;
+	case ObjectOrder::Greater:
+		return 1;
+	case ObjectOrder::Equal:
+	case ObjectOrder::EqualUnordered:
+		return 0;
+	default:
+		break;
+	}
+
+	const int rankA = ObjCategoryKeyRank(a.GetCategory());
+	const int rankB = ObjCategoryKeyRank(b.GetCategory());
+	if (rankA != rankB)
+	{
+		return rankA < rankB ? -1 : 1;
+	}
+
+	if (a.GetCategory() == ObjCategory::Tuple)
+	{
+		const auto& tupA = a.AsTuple();
+		const auto& tupB = b.AsTuple();
+		auto itA = tupA.cbegin();
+		auto itB = tupB.cbegin();
+		for (; (itA != tupA.cend()) && (itB != tupB.cend()); ++itA, ++itB)
+		{
+			const int cmpRes = ObjectKeyCompare(*itA, *itB);
+			if (cmpRes != 0)
+			{
+				return cmpRes;
+			}
+		}
+		return (itA != tupA.cend()) - (itB != tupB.cend());
+	}
+
+	throw UnsupportedOperation("<", a.GetCategoryName(), b.GetCategoryName());
+}
+
+/**
+ * @brief The strict weak ordering of Dict keys (i.e., DictKeyImpl), based
+ *        on ObjectKeyCompare
+ *
+ */
+struct DictKeyLess
+{
+	template<typename _DictKeyType>
+	bool operator()(const _DictKeyType& a, const _DictKeyType& b) const
+	{
+		return ObjectKeyCompare(*a.GetBasePtr(), *b.GetBasePtr()) < 0;
+	}
+}; // struct DictKeyLess
+
+} // namespace Internal
+} // namespace SimpleObjects
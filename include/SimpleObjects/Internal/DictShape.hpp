@@ -0,0 +1,178 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../FlatHashMap.hpp"
+#include "DictKey.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Internal
+{
+
+/**
+ * @brief The shape of a Dict, which is an immutable, ordered set of keys,
+ *        where each key is assigned to a slot (i.e., its position in the
+ *        set). Shapes are shared by all the Dicts with the same keys, which
+ *        only need to store their values in the order of the slots.
+ *        All shapes are derived from the empty shape, by adding keys one by
+ *        one; the shape derived from a given shape by adding a given key is
+ *        cached, so that Dicts built by adding the same keys in the same
+ *        order end up with the same shape. A shape keeps the one it's
+ *        derived from alive, and it's destroyed once no Dict or derived
+ *        shape refers to it.
+ *        Each shape stores a copy of its keys, so it's meant for Dicts with
+ *        a small number of keys, such as the records from the same schema.
+ *        It's thread-safe.
+ *
+ * @tparam _KeyType     The type of the keys
+ * @tparam _BaseKeyType The base type of the keys, which can be used for
+ *                      lookups
+ */
+template<typename _KeyType, typename _BaseKeyType>
+class DictShape
+{
+public: // static members
+
+	using Self = DictShape<_KeyType, _BaseKeyType>;
+	using ShapePtr = std::shared_ptr<const Self>;
+	using DictKey = DictKeyImpl<_KeyType, _BaseKeyType>;
+	using KeyContainer = std::vector<_KeyType>;
+	using const_iterator = typename KeyContainer::const_iterator;
+
+	/**
+	 * @brief Get the shape without any key
+	 *
+	 */
+	static const ShapePtr& GetEmpty()
+	{
+		// it's never destroyed, so that it's still valid during the static
+		// destruction
+		static const ShapePtr* inst = new ShapePtr(new Self());
+		return *inst;
+	}
+
+	/**
+	 * @brief Get the shape with the keys of the given shape, followed by the
+	 *        given key, which must not be in the given shape
+	 *
+	 * @tparam _KType The type of the key, either `_KeyType` or
+	 *                `_BaseKeyType`
+	 */
+	template<typename _KType>
+	static ShapePtr Add(const ShapePtr& shape, const _KType& key)
+	{
+		std::lock_guard<std::mutex> lock(shape->m_mutex);
+
+		auto it = shape->m_transitions.find(DictKey::Borrow(&key));
+		if (it != shape->m_transitions.end())
+		{
+			ShapePtr next = it->second.lock();
+			if (next)
+			{
+				return next;
+			}
+			// the cached shape has been destroyed
+			next = ShapePtr(new Self(shape, key));
+			it->second = next;
+			return next;
+		}
+
+		ShapePtr next(new Self(shape, key));
+		shape->m_transitions.emplace(DictKey::Make(key), next);
+		return next;
+	}
+
+public:
+
+	DictShape(const Self& other) = delete;
+
+	Self& operator=(const Self& rhs) = delete;
+
+	size_t size() const
+	{
+		return m_keys.size();
+	}
+
+	const_iterator begin() const
+	{
+		return m_keys.cbegin();
+	}
+
+	const_iterator end() const
+	{
+		return m_keys.cend();
+	}
+
+	const _KeyType& GetKey(size_t slot) const
+	{
+		return m_keys[slot];
+	}
+
+	/**
+	 * @brief Find the slot of the given key
+	 *
+	 * @return The slot of the key, or `size()` if it's not in this shape
+	 */
+	template<typename _KType>
+	size_t Find(const _KType& key) const
+	{
+		auto it = m_index.find(DictKey::Borrow(&key));
+		return it != m_index.end() ? it->second : size();
+	}
+
+private:
+
+	DictShape() :
+		m_parent(),
+		m_keys(),
+		m_index(),
+		m_mutex(),
+		m_transitions()
+	{}
+
+	template<typename _KType>
+	DictShape(const ShapePtr& parent, const _KType& key) :
+		m_parent(parent),
+		m_keys(),
+		m_index(),
+		m_mutex(),
+		m_transitions()
+	{
+		m_keys.reserve(parent->size() + 1);
+		m_keys.insert(
+			m_keys.end(), parent->m_keys.begin(), parent->m_keys.end());
+		m_keys.emplace_back(key);
+
+		// the keys won't be moved anymore, so they can be borrowed
+		m_index.reserve(m_keys.size());
+		for (size_t i = 0; i < m_keys.size(); ++i)
+		{
+			m_index.emplace(DictKey::Borrow(&m_keys[i]), i);
+		}
+	}
+
+	// keeps the parent, and thus the transition to this shape cached by it,
+	// alive
+	ShapePtr m_parent;
+	KeyContainer m_keys;
+	FlatHashMap<DictKey, size_t> m_index;
+
+	mutable std::mutex m_mutex;
+	mutable FlatHashMap<DictKey, std::weak_ptr<const Self> > m_transitions;
+
+}; // class DictShape
+
+} // namespace Internal
+} // namespace SimpleObjects
@@ -0,0 +1,190 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+// -- SimpleObjects --
+// NOTE: the hash kernel in this file follows the design of wyhash
+// (https://github.com/wangyi-fudan/wyhash, released into the public domain),
+// which consumes 48 bytes per round with three independent 16-byte lanes,
+// and mixes each lane with a 64x64->128 bit multiplication.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif // defined(_MSC_VER) && defined(_M_X64)
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Internal
+{
+
+struct FastHashConst
+{
+	static constexpr uint64_t sk_p0 = 0xa0761d6478bd642fULL;
+	static constexpr uint64_t sk_p1 = 0xe7037ed1a0b428dbULL;
+	static constexpr uint64_t sk_p2 = 0x8ebc6af09c88c6e3ULL;
+	static constexpr uint64_t sk_p3 = 0x589965cc75374cc3ULL;
+}; // struct FastHashConst
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 FastHashUInt128;
+#endif // defined(__SIZEOF_INT128__)
+
+/**
+ * @brief Multiply two 64-bit integers, and store the lower and higher 64
+ *        bits of the 128-bit result in `a` and `b`, respectively
+ *
+ */
+inline void FastHashMul(uint64_t& a, uint64_t& b)
+{
+#if defined(__SIZEOF_INT128__)
+	FastHashUInt128 r = a;
+	r *= b;
+	a = static_cast<uint64_t>(r);
+	b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	a = _umul128(a, b, &b);
+#else
+	uint64_t ha = a >> 32, hb = b >> 32;
+	uint64_t la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	uint64_t t = rl + (rm0 << 32);
+	uint64_t c = (t < rl) ? 1 : 0;
+	uint64_t lo = t + (rm1 << 32);
+	c += (lo < t) ? 1 : 0;
+	uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+	a = lo;
+	b = hi;
+#endif
+}
+
+inline uint64_t FastHashMix(uint64_t a, uint64_t b)
+{
+	FastHashMul(a, b);
+	return a ^ b;
+}
+
+/**
+ * @brief Read 8 bytes from an address that might not be aligned.
+ *        Bytes are read in the native byte order, so the hash value of the
+ *        same data might be different on platforms with different byte
+ *        orders
+ *
+ */
+inline uint64_t FastHashRead8(const uint8_t* p)
+{
+	uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+inline uint64_t FastHashRead4(const uint8_t* p)
+{
+	uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+/**
+ * @brief Read 1 to 3 bytes
+ *
+ */
+inline uint64_t FastHashRead3(const uint8_t* p, size_t k)
+{
+	return (static_cast<uint64_t>(p[0]) << 16) |
+		(static_cast<uint64_t>(p[k >> 1]) << 8) |
+		p[k - 1];
+}
+
+/**
+ * @brief Hash a contiguous block of memory.
+ *        Inputs up to 16 bytes are hashed without any loop; longer inputs
+ *        are consumed 48 bytes per round, and then 16 bytes per round.
+ *
+ * @param data The pointer to the data
+ * @param len  The length of the data, in bytes
+ * @param seed The seed of the hash
+ * @return The hash value
+ */
+inline uint64_t FastHash64(const void* data, size_t len, uint64_t seed = 0)
+{
+	using C = FastHashConst;
+
+	const uint8_t* p = static_cast<const uint8_t*>(data);
+	seed ^= FastHashMix(seed ^ C::sk_p0, C::sk_p1);
+
+	uint64_t a = 0;
+	uint64_t b = 0;
+	if (len <= 16)
+	{
+		if (len >= 4)
+		{
+			const size_t off = (len >> 3) << 2;
+			a = (FastHashRead4(p) << 32) | FastHashRead4(p + off);
+			b = (FastHashRead4(p + len - 4) << 32) |
+				FastHashRead4(p + len - 4 - off);
+		}
+		else if (len > 0)
+		{
+			a = FastHashRead3(p, len);
+		}
+	}
+	else
+	{
+		size_t i = len;
+		if (i > 48)
+		{
+			uint64_t see1 = seed;
+			uint64_t see2 = seed;
+			do
+			{
+				seed = FastHashMix(
+					FastHashRead8(p) ^ C::sk_p1,
+					FastHashRead8(p + 8) ^ seed);
+				see1 = FastHashMix(
+					FastHashRead8(p + 16) ^ C::sk_p2,
+					FastHashRead8(p + 24) ^ see1);
+				see2 = FastHashMix(
+					FastHashRead8(p + 32) ^ C::sk_p3,
+					FastHashRead8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16)
+		{
+			seed = FastHashMix(
+				FastHashRead8(p) ^ C::sk_p1,
+				FastHashRead8(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+		// the last 16 bytes, which may overlap with the bytes consumed above
+		a = FastHashRead8(p + i - 16);
+		b = FastHashRead8(p + i - 8);
+	}
+
+	a ^= C::sk_p1;
+	b ^= seed;
+	FastHashMul(a, b);
+	return FastHashMix(a ^ C::sk_p0 ^ len, b ^ C::sk_p1);
+}
+
+inline size_t FastHash(const void* data, size_t len, uint64_t seed = 0)
+{
+	return static_cast<size_t>(FastHash64(data, len, seed));
+}
+
+} //namespace Internal
+} // namespace SimpleObjects
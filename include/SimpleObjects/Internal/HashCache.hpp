@@ -0,0 +1,115 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+
+#include <atomic>
+
+/**
+ * @brief Whether Bytes and String remember their hash values once computed.
+ *        The cached value is dropped by any function that may modify the
+ *        content, including the ones returning non-const references and
+ *        iterators; thus, such references and iterators must not be used to
+ *        modify the content after the hash is computed.
+ *        It can be disabled by defining this macro as 0 before including
+ *        any header of this library.
+ */
+#ifndef SIMPLEOBJECTS_HASH_CACHE
+#define SIMPLEOBJECTS_HASH_CACHE 1
+#endif // !SIMPLEOBJECTS_HASH_CACHE
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Internal
+{
+
+template<bool _Enabled>
+class HashCacheImpl;
+
+/**
+ * @brief A lazily computed hash value.
+ *        Zero is used to mark the value as absent, so a content that hashes
+ *        to zero is simply hashed every time. The value is stored in an
+ *        atomic, so concurrent `Get` calls on the same const object are
+ *        safe, and the worst case is that the hash is computed more than
+ *        once.
+ *
+ */
+template<>
+class HashCacheImpl<true>
+{
+public: // static members
+
+	using Self = HashCacheImpl<true>;
+
+public:
+
+	HashCacheImpl() :
+		m_hash(0)
+	{}
+
+	HashCacheImpl(const Self& other) :
+		m_hash(other.m_hash.load(std::memory_order_relaxed))
+	{}
+
+	~HashCacheImpl() = default;
+
+	Self& operator=(const Self& rhs)
+	{
+		m_hash.store(
+			rhs.m_hash.load(std::memory_order_relaxed),
+			std::memory_order_relaxed);
+		return *this;
+	}
+
+	template<typename _HashFunc>
+	size_t Get(_HashFunc hashFunc) const
+	{
+		size_t res = m_hash.load(std::memory_order_relaxed);
+		if (res == 0)
+		{
+			res = hashFunc();
+			m_hash.store(res, std::memory_order_relaxed);
+		}
+		return res;
+	}
+
+	void Reset()
+	{
+		m_hash.store(0, std::memory_order_relaxed);
+	}
+
+private:
+
+	mutable std::atomic<size_t> m_hash;
+
+}; // class HashCacheImpl<true>
+
+template<>
+class HashCacheImpl<false>
+{
+public:
+
+	template<typename _HashFunc>
+	size_t Get(_HashFunc hashFunc) const
+	{
+		return hashFunc();
+	}
+
+	void Reset()
+	{}
+
+}; // class HashCacheImpl<false>
+
+using HashCache = HashCacheImpl<SIMPLEOBJECTS_HASH_CACHE != 0>;
+
+} //namespace Internal
+} // namespace SimpleObjects
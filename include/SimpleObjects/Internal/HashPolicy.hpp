@@ -0,0 +1,146 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif // __cplusplus >= 201703L
+
+#include "FastHash.hpp"
+#include "hash.hpp"
+
+/**
+ * @brief The hash policy used to hash the content of Bytes and String.
+ *        It can be defined as `StdHashPolicy` to get the hash values
+ *        computed by the standard library, as in the earlier versions, or
+ *        as `SeededFastHashPolicy` for Dicts whose keys come from untrusted
+ *        input (e.g., JSON objects), so that the hash values can't be
+ *        predicted to cause collisions.
+ *        The default `FastHashPolicy` is deterministic across runs.
+ *
+ */
+#ifndef SIMPLEOBJECTS_HASH_POLICY
+#define SIMPLEOBJECTS_HASH_POLICY FastHashPolicy
+#endif // !SIMPLEOBJECTS_HASH_POLICY
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Internal
+{
+
+/**
+ * @brief Hash bytes and strings with FastHash, so that the same content
+ *        always has the same hash value, no matter it is stored in a Bytes
+ *        or a String
+ *
+ */
+struct FastHashPolicy
+{
+	static size_t HashBytes(const uint8_t* data, size_t size)
+	{
+		return FastHash(data, size);
+	}
+
+	template<typename _CharType, typename _TraitsType>
+	static size_t HashStr(const _CharType* str, size_t len)
+	{
+		return FastHash(str, len * sizeof(_CharType));
+	}
+}; // struct FastHashPolicy
+
+/**
+ * @brief Generate a random seed; the output of `std::random_device` is
+ *        mixed with the clock and an address, in case that the random
+ *        device is deterministic on some platforms
+ *
+ */
+inline uint64_t GenHashSeed()
+{
+	uint64_t seed = static_cast<uint64_t>(
+		std::chrono::high_resolution_clock::now().time_since_epoch().count());
+	seed ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&seed));
+	try
+	{
+		std::random_device rd;
+		seed ^= (static_cast<uint64_t>(rd()) << 32) ^ rd();
+	}
+	catch (...)
+	{
+		// random device is not available; go with the clock and the address
+	}
+	return FastHash64(&seed, sizeof(seed));
+}
+
+/**
+ * @brief The random seed shared by the whole process; it's generated once,
+ *        on the first call
+ *
+ */
+inline uint64_t ProcessHashSeed()
+{
+	static const uint64_t sk_seed = GenHashSeed();
+	return sk_seed;
+}
+
+/**
+ * @brief Same as FastHashPolicy, except that the hash is keyed with the
+ *        random seed of the process, so that the hash values of the same
+ *        content are different from one run to another
+ *
+ */
+struct SeededFastHashPolicy
+{
+	static size_t HashBytes(const uint8_t* data, size_t size)
+	{
+		return FastHash(data, size, ProcessHashSeed());
+	}
+
+	template<typename _CharType, typename _TraitsType>
+	static size_t HashStr(const _CharType* str, size_t len)
+	{
+		return FastHash(str, len * sizeof(_CharType), ProcessHashSeed());
+	}
+}; // struct SeededFastHashPolicy
+
+/**
+ * @brief Hash bytes with `hash_range`, and strings with `std::hash`
+ *
+ */
+struct StdHashPolicy
+{
+	static size_t HashBytes(const uint8_t* data, size_t size)
+	{
+		return hash_range(data, data + size);
+	}
+
+	template<typename _CharType, typename _TraitsType>
+	static size_t HashStr(const _CharType* str, size_t len)
+	{
+#if __cplusplus >= 201703L
+		using StrViewType = std::basic_string_view<_CharType, _TraitsType>;
+		return std::hash<StrViewType>()(StrViewType(str, len));
+#else
+		using StdStrType = std::basic_string<_CharType, _TraitsType>;
+		return std::hash<StdStrType>()(StdStrType(str, len));
+#endif // __cplusplus >= 201703L
+	}
+}; // struct StdHashPolicy
+
+using DefaultHashPolicy = SIMPLEOBJECTS_HASH_POLICY;
+
+} //namespace Internal
+} // namespace SimpleObjects
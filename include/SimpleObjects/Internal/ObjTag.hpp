@@ -0,0 +1,143 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstdint>
+
+#include "../BasicDefs.hpp"
+#include "../RealNum.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Internal
+{
+
+/**
+ * @brief A tag describing the concrete type of an object, which is cached by
+ *        the object wrappers (i.e., ObjectImpl and HashableObjectImpl), so
+ *        that category checks and scalar reads can be done with a switch,
+ *        instead of virtual calls to the wrapped object.
+ *        Since the wrapped object can't change its type in place
+ *        (i.e., `Set` only accepts the same type), the tag only needs to be
+ *        updated when the wrapped object is replaced.
+ */
+struct ObjTag
+{
+	template<typename _BaseObjType>
+	static ObjTag Make(const _BaseObjType* obj)
+	{
+		if (obj == nullptr)
+		{
+			return ObjTag{ ObjCategory::Null, RealNumType::Other };
+		}
+
+		ObjCategory cat = obj->GetCategory();
+		switch (cat)
+		{
+		case ObjCategory::Bool:
+		case ObjCategory::Integer:
+		case ObjCategory::Real:
+			return ObjTag{ cat, obj->AsRealNum().GetNumType() };
+		default:
+			return ObjTag{ cat, RealNumType::Other };
+		}
+	}
+
+	/**
+	 * @brief Check if the tagged object is an instance of RealNumImpl, since
+	 *        the RealNumType values (except `Other`) are reserved for
+	 *        RealNumImpl only
+	 *
+	 */
+	bool IsRealNumImpl() const
+	{
+		return m_numType != RealNumType::Other;
+	}
+
+	ObjCategory m_cat;
+	RealNumType m_numType;
+}; // struct ObjTag
+
+/**
+ * @brief Apply the given operation on the value of the RealNumImpl object,
+ *        whose concrete type is specified by the given RealNumType;
+ *        the given object must be an instance of the RealNumImpl class
+ *
+ * @param numType The RealNumType of the given object
+ * @param obj     The object, which is a RealNumImpl, referred by its base type
+ * @param op      The operation that will be called with the internal value
+ * @return The return value of the operation
+ */
+template<typename _RetType, typename _ToStringType,
+	typename _BaseObjType, typename _Op>
+inline _RetType RealNumTagVisit(
+	RealNumType numType, const _BaseObjType& obj, _Op op)
+{
+	using _Bool   = RealNumImpl<bool    , _ToStringType>;
+	using _Int8   = RealNumImpl<int8_t  , _ToStringType>;
+	using _Int16  = RealNumImpl<int16_t , _ToStringType>;
+	using _Int32  = RealNumImpl<int32_t , _ToStringType>;
+	using _Int64  = RealNumImpl<int64_t , _ToStringType>;
+	using _UInt8  = RealNumImpl<uint8_t , _ToStringType>;
+	using _UInt16 = RealNumImpl<uint16_t, _ToStringType>;
+	using _UInt32 = RealNumImpl<uint32_t, _ToStringType>;
+	using _UInt64 = RealNumImpl<uint64_t, _ToStringType>;
+	using _Float  = RealNumImpl<float   , _ToStringType>;
+	using _Double = RealNumImpl<double  , _ToStringType>;
+
+	switch (numType)
+	{
+	case RealNumType::Bool:
+		return op(static_cast<const _Bool  &>(obj).GetVal());
+	case RealNumType::Int8:
+		return op(static_cast<const _Int8  &>(obj).GetVal());
+	case RealNumType::Int16:
+		return op(static_cast<const _Int16 &>(obj).GetVal());
+	case RealNumType::Int32:
+		return op(static_cast<const _Int32 &>(obj).GetVal());
+	case RealNumType::Int64:
+		return op(static_cast<const _Int64 &>(obj).GetVal());
+	case RealNumType::UInt8:
+		return op(static_cast<const _UInt8 &>(obj).GetVal());
+	case RealNumType::UInt16:
+		return op(static_cast<const _UInt16&>(obj).GetVal());
+	case RealNumType::UInt32:
+		return op(static_cast<const _UInt32&>(obj).GetVal());
+	case RealNumType::UInt64:
+		return op(static_cast<const _UInt64&>(obj).GetVal());
+	case RealNumType::Float:
+		return op(static_cast<const _Float &>(obj).GetVal());
+	case RealNumType::Double:
+	default:
+		return op(static_cast<const _Double&>(obj).GetVal());
+	}
+}
+
+template<typename _DstValType>
+struct RealNumCastOp
+{
+	template<typename _SrcValType>
+	_DstValType operator()(const _SrcValType& val) const
+	{
+		return RealNumCast<_DstValType>(val);
+	}
+}; // struct RealNumCastOp
+
+struct RealNumIsTrueOp
+{
+	template<typename _SrcValType>
+	bool operator()(const _SrcValType& val) const
+	{
+		return static_cast<bool>(val);
+	}
+}; // struct RealNumIsTrueOp
+
+} // namespace Internal
+} // namespace SimpleObjects
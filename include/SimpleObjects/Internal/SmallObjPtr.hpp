@@ -0,0 +1,331 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#ifndef SIMPLEOBJECTS_OBJECT_INLINE_SIZE
+/**
+ * @brief The size (in bytes) of the buffer embedded in the object wrappers
+ *        (i.e., ObjectImpl and HashableObjectImpl). Objects that fit in this
+ *        buffer are stored in place, instead of being allocated on the heap.
+ *        It can be customized by defining this macro before including any
+ *        header of this library.
+ */
+#define SIMPLEOBJECTS_OBJECT_INLINE_SIZE (sizeof(void*) * 6)
+#endif // !SIMPLEOBJECTS_OBJECT_INLINE_SIZE
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+namespace Internal
+{
+
+/**
+ * @brief The default way for SmallObjPtr to clone an object stored on the
+ *        heap, which uses the `Copy`/`Move` functions of the object classes
+ *
+ */
+struct SmallObjCloner
+{
+	template<typename _BaseType>
+	static std::unique_ptr<_BaseType> Copy(const _BaseType& obj)
+	{
+		return obj.Copy(static_cast<const _BaseType*>(nullptr));
+	}
+
+	template<typename _BaseType>
+	static std::unique_ptr<_BaseType> Move(_BaseType& obj)
+	{
+		return obj.Move(static_cast<const _BaseType*>(nullptr));
+	}
+}; // struct SmallObjCloner
+
+/**
+ * @brief A unique pointer to a polymorphic object, which stores the pointee
+ *        in an embedded buffer when it is small enough, so that no heap
+ *        allocation is needed for it.
+ *        Objects that do not fit, or whose concrete type is unknown at the
+ *        time of construction, are stored on the heap, and they are copied
+ *        with the `Copy` function provided by the `_Cloner`.
+ *
+ * @tparam _BaseType The base type of the objects being pointed to; it must
+ *                   have a virtual destructor
+ * @tparam _Size     The size of the embedded buffer
+ * @tparam _Cloner   The type providing static `Copy` and `Move` functions
+ *                   that clone an object of `_BaseType` onto the heap
+ */
+template<typename _BaseType, size_t _Size, typename _Cloner = SmallObjCloner>
+class SmallObjPtr
+{
+public: // static members
+
+	using Self = SmallObjPtr<_BaseType, _Size, _Cloner>;
+	using BaseType = _BaseType;
+	using BasePtr = std::unique_ptr<_BaseType>;
+
+	static_assert(std::has_virtual_destructor<_BaseType>::value,
+		"The base type must have a virtual destructor");
+
+	static constexpr size_t sk_size = _Size;
+	static constexpr size_t sk_align =
+		(alignof(void*) > alignof(uint64_t)) ?
+			(alignof(void*) > alignof(double) ?
+				alignof(void*) : alignof(double)) :
+			(alignof(uint64_t) > alignof(double) ?
+				alignof(uint64_t) : alignof(double));
+
+	/**
+	 * @brief Check if the given concrete type can be stored in the embedded
+	 *        buffer
+	 *
+	 * @tparam _T The concrete type to be checked
+	 */
+	template<typename _T>
+	struct CanInline : std::integral_constant<bool,
+		std::is_base_of<_BaseType, _T>::value &&
+		!std::is_abstract<_T>::value &&
+		(sizeof(_T) <= sk_size) &&
+		(alignof(_T) <= sk_align)>
+	{}; // struct CanInline
+
+	/**
+	 * @brief Construct an object of the given concrete type, in the embedded
+	 *        buffer if it fits, or on the heap otherwise
+	 *
+	 * @tparam _T The concrete type of the object to be constructed
+	 * @param args The arguments passed to the constructor
+	 * @return The pointer to the newly constructed object
+	 */
+	template<typename _T, typename... _Args>
+	static Self Make(_Args&&... args)
+	{
+		Self res;
+		res.template Emplace<_T>(
+			std::integral_constant<bool, CanInline<_T>::value>(),
+			std::forward<_Args>(args)...);
+		return res;
+	}
+
+	/**
+	 * @brief Copy or move the given object into a new pointer.
+	 *        Different from `Make`, `obj` may be an instance of a class
+	 *        derived from `_T`, in which case, the object is copied/moved
+	 *        through its virtual `Copy`/`Move` function, so that it won't be
+	 *        sliced.
+	 *
+	 * @tparam _T The expected concrete type of the given object
+	 * @param obj The object to be copied (if it's a lvalue) or
+	 *            moved (if it's a rvalue)
+	 * @return The pointer to the new object
+	 */
+	template<typename _T, typename _ArgType>
+	static Self MakeFrom(_ArgType&& obj)
+	{
+		if (typeid(obj) == typeid(_T))
+		{
+			return Make<_T>(std::forward<_ArgType>(obj));
+		}
+		return Self(Clone(std::forward<_ArgType>(obj)));
+	}
+
+public:
+
+	SmallObjPtr() noexcept :
+		m_ptr(nullptr),
+		m_ops(nullptr)
+	{}
+
+	explicit SmallObjPtr(BasePtr ptr) noexcept :
+		m_ptr(ptr.release()),
+		m_ops(nullptr)
+	{}
+
+	SmallObjPtr(const Self& other) :
+		SmallObjPtr()
+	{
+		CopyFrom(other);
+	}
+
+	SmallObjPtr(Self&& other) :
+		SmallObjPtr()
+	{
+		MoveFrom(other);
+	}
+
+	~SmallObjPtr()
+	{
+		reset();
+	}
+
+	Self& operator=(const Self& rhs)
+	{
+		if (this != &rhs)
+		{
+			// copy first, in case `rhs` is owned by the object we are
+			// going to destroy
+			Self tmp(rhs);
+			reset();
+			MoveFrom(tmp);
+		}
+		return *this;
+	}
+
+	Self& operator=(Self&& rhs)
+	{
+		if (this != &rhs)
+		{
+			reset();
+			MoveFrom(rhs);
+		}
+		return *this;
+	}
+
+	_BaseType* get() const noexcept
+	{
+		return m_ptr;
+	}
+
+	_BaseType& operator*() const
+	{
+		return *m_ptr;
+	}
+
+	_BaseType* operator->() const noexcept
+	{
+		return m_ptr;
+	}
+
+	explicit operator bool() const noexcept
+	{
+		return m_ptr != nullptr;
+	}
+
+	/**
+	 * @brief Check if the pointee is stored in the embedded buffer
+	 *
+	 */
+	bool IsInline() const noexcept
+	{
+		return m_ops != nullptr;
+	}
+
+	void reset() noexcept
+	{
+		if (m_ops != nullptr)
+		{
+			m_ptr->~_BaseType();
+		}
+		else
+		{
+			delete m_ptr;
+		}
+		m_ptr = nullptr;
+		m_ops = nullptr;
+	}
+
+private: // helper types and functions
+
+	struct InlineOps
+	{
+		_BaseType* (*m_copy)(const _BaseType&, void*);
+		_BaseType* (*m_move)(_BaseType&, void*);
+	}; // struct InlineOps
+
+	template<typename _T>
+	struct InlineOpsImpl
+	{
+		static _BaseType* CopyTo(const _BaseType& src, void* dest)
+		{
+			return ::new (dest) _T(static_cast<const _T&>(src));
+		}
+
+		static _BaseType* MoveTo(_BaseType& src, void* dest)
+		{
+			return ::new (dest) _T(std::move(static_cast<_T&>(src)));
+		}
+
+		static const InlineOps* Get()
+		{
+			static constexpr InlineOps sk_ops = { &CopyTo, &MoveTo };
+			return &sk_ops;
+		}
+	}; // struct InlineOpsImpl
+
+	static BasePtr Clone(const _BaseType& obj)
+	{
+		return _Cloner::Copy(obj);
+	}
+
+	static BasePtr Clone(_BaseType&& obj)
+	{
+		return _Cloner::Move(obj);
+	}
+
+	template<typename _T, typename... _Args>
+	void Emplace(std::true_type, _Args&&... args)
+	{
+		m_ptr = ::new (static_cast<void*>(m_buf))
+			_T(std::forward<_Args>(args)...);
+		m_ops = InlineOpsImpl<_T>::Get();
+	}
+
+	template<typename _T, typename... _Args>
+	void Emplace(std::false_type, _Args&&... args)
+	{
+		m_ptr = new _T(std::forward<_Args>(args)...);
+	}
+
+	void CopyFrom(const Self& other)
+	{
+		if (other.m_ops != nullptr)
+		{
+			m_ptr = other.m_ops->m_copy(*other.m_ptr, m_buf);
+			m_ops = other.m_ops;
+		}
+		else if (other.m_ptr != nullptr)
+		{
+			m_ptr = Clone(*other.m_ptr).release();
+		}
+	}
+
+	void MoveFrom(Self& other)
+	{
+		if (other.m_ops != nullptr)
+		{
+			m_ptr = other.m_ops->m_move(*other.m_ptr, m_buf);
+			m_ops = other.m_ops;
+			// moved-from pointer is always empty, no matter where the
+			// pointee was stored
+			other.reset();
+		}
+		else
+		{
+			m_ptr = other.m_ptr;
+			other.m_ptr = nullptr;
+		}
+	}
+
+private:
+
+	alignas(sk_align) unsigned char m_buf[_Size];
+	_BaseType* m_ptr;
+	const InlineOps* m_ops;
+
+}; // class SmallObjPtr
+
+} // namespace Internal
+} // namespace SimpleObjects
@@ -0,0 +1,651 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "StringBaseObject.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Internal/make_unique.hpp"
+
+#include "Compare.hpp"
+#include "String.hpp"
+#include "ToString.hpp"
+#include "Utils.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+namespace Internal
+{
+
+/**
+ * @brief The process-wide table of interned strings, which stores each
+ *        distinct string exactly once, together with its hash value.
+ *        Entries are never removed, so references to them stay valid for
+ *        the lifetime of the process; thus, it's meant for strings from a
+ *        bounded set, such as the keys of Dicts.
+ *        It's thread-safe.
+ *
+ * @tparam _CharType The type of the characters
+ */
+template<typename _CharType>
+class StrInternTable
+{
+public: // static members
+
+	using Self = StrInternTable<_CharType>;
+	using value_type = _CharType;
+	using StrType = std::basic_string<value_type>;
+	using traits_type = typename StrType::traits_type;
+
+	struct Entry
+	{
+		Entry(const value_type* str, size_t len, size_t hash) :
+			m_str(str, len),
+			m_hash(hash)
+		{}
+
+		StrType m_str;
+		size_t m_hash;
+	}; // struct Entry
+
+	static Self& GetInstance()
+	{
+		// it's never destroyed, so that interned strings held by other
+		// static objects are still valid during the static destruction
+		static Self* inst = new Self();
+		return *inst;
+	}
+
+public:
+
+	StrInternTable(const Self& other) = delete;
+
+	Self& operator=(const Self& rhs) = delete;
+
+	/**
+	 * @brief Get the entry of the given string, which is added to the table
+	 *        if it's not there yet
+	 *
+	 */
+	const Entry& Intern(const value_type* str, size_t len)
+	{
+		const size_t hash = StrContainerHash<StrType>::Hash(str, len);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto range = m_entries.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			const StrType& entryStr = it->second->m_str;
+			if ((entryStr.size() == len) &&
+				(traits_type::compare(entryStr.data(), str, len) == 0))
+			{
+				return *(it->second);
+			}
+		}
+
+		std::unique_ptr<Entry> entry = make_unique<Entry>(str, len, hash);
+		const Entry& res = *entry;
+		m_entries.emplace(hash, std::move(entry));
+		return res;
+	}
+
+	/**
+	 * @brief The number of distinct strings interned so far
+	 *
+	 */
+	size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_entries.size();
+	}
+
+private:
+
+	StrInternTable() :
+		m_mutex(),
+		m_entries()
+	{}
+
+	mutable std::mutex m_mutex;
+	std::unordered_multimap<size_t, std::unique_ptr<Entry> > m_entries;
+
+}; // class StrInternTable
+
+} // namespace Internal
+
+/**
+ * @brief A string object that refers to an entry in the process-wide intern
+ *        table (i.e., Internal::StrInternTable), where each distinct string
+ *        is stored only once, with its hash value precomputed.
+ *        Thus, copying it doesn't allocate, hashing it is free, and two
+ *        interned strings are compared by the addresses of their entries.
+ *        It's meant to be used as the keys of Dicts, whose values repeat a
+ *        lot over different Dicts.
+ *        The data is copied into a container owned by this object, only
+ *        when it's going to be mutated (i.e., copy-on-write), after which,
+ *        it's no longer interned.
+ *        It's equal to, and has the same hash value as, a StringImpl with
+ *        the same content.
+ *
+ * @tparam _CtnType The type of the container used once the data is owned
+ */
+template<typename _CtnType, typename _ToStringType>
+class InternedStringImpl :
+	public StringBaseObject<
+		typename _CtnType::value_type,
+		_ToStringType>
+{
+public: // Static member:
+
+	using ContainerType = _CtnType;
+	using ToStringType = _ToStringType;
+	using Self = InternedStringImpl<ContainerType, ToStringType>;
+	using Base = StringBaseObject<
+		typename ContainerType::value_type, ToStringType>;
+	using BaseBase = typename Base::Base;
+	using BaseBaseBase = typename BaseBase::Base;
+
+	static_assert(std::is_same<BaseBase, HashableBaseObject<_ToStringType> >::value,
+		"Expecting Base::Base to be HashableBaseObject class");
+	static_assert(std::is_same<BaseBaseBase, BaseObject<_ToStringType> >::value,
+		"Expecting Base::Base::Base to be BaseObject class");
+
+	typedef typename ContainerType::traits_type          traits_type;
+	typedef typename ContainerType::value_type           value_type;
+	typedef typename ContainerType::size_type            size_type;
+	typedef typename ContainerType::difference_type      difference_type;
+	typedef typename ContainerType::reference            reference;
+	typedef typename ContainerType::const_reference      const_reference;
+	typedef typename ContainerType::pointer              pointer;
+	typedef typename ContainerType::const_pointer        const_pointer;
+	typedef typename Base::iterator                      iterator;
+	typedef typename Base::const_iterator                const_iterator;
+	typedef typename Base::iterator                      reverse_iterator;
+	typedef typename Base::const_iterator                const_reverse_iterator;
+
+	using InternTable = Internal::StrInternTable<value_type>;
+	using InternEntry = typename InternTable::Entry;
+
+	static constexpr ObjCategory sk_cat()
+	{
+		return ObjCategory::String;
+	}
+
+	static_assert(std::is_same<value_type, char>::value,
+		"Current implementation only supports char strings.");
+
+public:
+
+	InternedStringImpl() :
+		InternedStringImpl(nullptr, 0)
+	{}
+
+	InternedStringImpl(const_pointer str, size_t len) :
+		m_entry(&InternTable::GetInstance().Intern(str, len)),
+		m_owned()
+	{}
+
+	InternedStringImpl(const_pointer str) :
+		InternedStringImpl(str, traits_type::length(str))
+	{}
+
+	/**
+	 * @brief Construct an interned string with the data of the given string
+	 *        object
+	 *
+	 */
+	explicit InternedStringImpl(const Base& other) :
+		InternedStringImpl(other.data(), other.size())
+	{}
+
+	InternedStringImpl(const Self& other) :
+		m_entry(other.m_entry),
+		m_owned(other.m_owned ?
+			Internal::make_unique<ContainerType>(*other.m_owned) :
+			nullptr)
+	{}
+
+	InternedStringImpl(Self&& other) :
+		m_entry(other.m_entry),
+		m_owned(std::move(other.m_owned))
+	{}
+
+	virtual ~InternedStringImpl() = default;
+
+	Self& operator=(const Self& rhs)
+	{
+		if (this != &rhs)
+		{
+			m_entry = rhs.m_entry;
+			m_owned = rhs.m_owned ?
+				Internal::make_unique<ContainerType>(*rhs.m_owned) :
+				nullptr;
+		}
+		return *this;
+	}
+
+	Self& operator=(Self&& rhs)
+	{
+		if (this != &rhs)
+		{
+			m_entry = rhs.m_entry;
+			m_owned = std::move(rhs.m_owned);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Check if this string still refers to the intern table, i.e.,
+	 *        it hasn't been mutated
+	 *
+	 */
+	bool IsInterned() const
+	{
+		return m_owned == nullptr;
+	}
+
+	// ========== operators ==========
+
+	// ===== StringBase class
+
+	virtual bool StringBaseEqual(size_t pos1, size_t count1,
+		const_pointer begin, const_pointer end) const override
+	{
+		auto ptrDiff = end - begin;
+		if (!Internal::RealNumCompare<decltype(ptrDiff), size_t>::Equal(
+				ptrDiff, count1))
+		{
+			return false;
+		}
+		// interned strings with the same content share the same data
+		return (data() + pos1 == begin) ||
+			std::equal(data() + pos1, data() + pos1 + count1, begin);
+	}
+
+	virtual int StringBaseCompare(size_t pos1, size_t count1,
+		const_pointer begin, const_pointer end) const override
+	{
+		return Internal::LexicographicalCompareThreeWay(
+			data() + pos1, data() + pos1 + count1,
+			begin, end);
+	}
+
+	virtual const void* GetInternedId() const override
+	{
+		return IsInterned() ? m_entry : nullptr;
+	}
+
+	bool operator==(const Self& rhs) const
+	{
+		return (IsInterned() && rhs.IsInterned()) ?
+			(m_entry == rhs.m_entry) :
+			Base::operator==(rhs);
+	}
+
+	using Base::operator==;
+#ifdef __cpp_lib_three_way_comparison
+	using Base::operator<=>;
+
+	std::strong_ordering operator<=>(const Self& rhs) const
+	{
+		return Base::operator<=>(rhs);
+	}
+
+	// Since C++20, comparing with a StringImpl through the base class
+	// is ambiguous with the reversed candidates, so exact matches are given
+	template<typename _OtherCtnType>
+	bool operator==(const StringImpl<_OtherCtnType, ToStringType>& rhs) const
+	{
+		return Base::operator==(rhs);
+	}
+
+	template<typename _OtherCtnType>
+	std::strong_ordering operator<=>(
+		const StringImpl<_OtherCtnType, ToStringType>& rhs) const
+	{
+		return Base::operator<=>(rhs);
+	}
+#else
+	using Base::operator!=;
+	using Base::operator<;
+	using Base::operator>;
+	using Base::operator<=;
+	using Base::operator>=;
+#endif
+
+	// ===== ObjectBase class
+
+	virtual bool BaseObjectIsEqual(const BaseBaseBase& rhs) const override
+	{
+		if (IsInterned() && (rhs.GetCategory() == ObjCategory::String))
+		{
+			const void* rhsId = rhs.AsString().GetInternedId();
+			if (rhsId != nullptr)
+			{
+				// each distinct string has exactly one entry in the table
+				return rhsId == m_entry;
+			}
+		}
+		return Base::BaseObjectIsEqual(rhs);
+	}
+
+	// ========== Overrides StringBaseObject ==========
+
+	// ========== capacity ==========
+
+	virtual size_t size() const override
+	{
+		return IsInterned() ? m_entry->m_str.size() : m_owned->size();
+	}
+
+	virtual void resize(size_t len) override
+	{
+		MakeOwned().resize(len);
+	}
+
+	virtual void reserve(size_t len) override
+	{
+		MakeOwned().reserve(len);
+	}
+
+	// ========== value access ==========
+
+	virtual reference operator[](size_t idx) override
+	{
+		if (idx >= size())
+		{
+			throw IndexError(idx);
+		}
+		return MakeOwned()[idx];
+	}
+
+	virtual const_reference operator[](size_t idx) const override
+	{
+		if (idx >= size())
+		{
+			throw IndexError(idx);
+		}
+		return data()[idx];
+	}
+
+	const_pointer data() const override
+	{
+		return IsInterned() ? m_entry->m_str.data() : m_owned->data();
+	}
+
+	const_pointer c_str() const override
+	{
+		return IsInterned() ? m_entry->m_str.c_str() : m_owned->c_str();
+	}
+
+	// ========== adding/removing values ==========
+
+	virtual void push_back(const value_type& ch) override
+	{
+		MakeOwned().push_back(ch);
+	}
+
+	virtual void pop_back() override
+	{
+		MakeOwned().pop_back();
+	}
+
+	using Base::Append;
+	virtual void Append(const_iterator begin, const_iterator end) override
+	{
+		std::copy(begin, end, std::back_inserter(MakeOwned()));
+	}
+
+	virtual void Append(const_pointer begin, const_pointer end) override
+	{
+		MakeOwned().append(begin, static_cast<size_t>(end - begin));
+	}
+
+	// ========== item searching ==========
+
+	using Base::StartsWith;
+	virtual bool StartsWith(
+		const_iterator begin, const_iterator end) const override
+	{
+		return Internal::FindAt(cbegin(), cend(), begin, end);
+	}
+
+	using Base::EndsWith;
+	virtual bool EndsWith(
+		const_iterator begin, const_iterator end) const override
+	{
+		return Internal::FindAt(crbegin(), crend(),
+			std::reverse_iterator<const_iterator >(end),
+			std::reverse_iterator<const_iterator >(begin));
+	}
+
+	using Base::Contains;
+	virtual const_iterator Contains(
+		const_iterator begin, const_iterator end) const override
+	{
+		auto res = cbegin();
+		for(; res != cend(); ++res)
+		{
+			if (Internal::FindAt(res, cend(), begin, end))
+			{
+				return res;
+			}
+		}
+		return res;
+	}
+
+	// ========== iterators ==========
+
+	using Base::begin;
+	using Base::end;
+
+	virtual iterator begin() override
+	{
+		return ToRdIt<false>(MakeOwned().begin());
+	}
+
+	virtual iterator end() override
+	{
+		return ToRdIt<false>(MakeOwned().end());
+	}
+
+	virtual const_iterator cbegin() const override
+	{
+		return ToRdIt<true>(data());
+	}
+
+	virtual const_iterator cend() const override
+	{
+		return ToRdIt<true>(data() + size());
+	}
+
+	virtual reverse_iterator rbegin() override
+	{
+		return ToRdIt<false>(MakeOwned().rbegin());
+	}
+
+	virtual reverse_iterator rend() override
+	{
+		return ToRdIt<false>(MakeOwned().rend());
+	}
+
+	virtual const_reverse_iterator crbegin() const override
+	{
+		return ToRdIt<true>(std::reverse_iterator<const_pointer>(
+			data() + size()));
+	}
+
+	virtual const_reverse_iterator crend() const override
+	{
+		return ToRdIt<true>(std::reverse_iterator<const_pointer>(data()));
+	}
+
+	// ========== Overrides HashableBaseObject ==========
+
+	virtual std::size_t Hash() const override
+	{
+		return IsInterned() ?
+			m_entry->m_hash :
+			Internal::StrContainerHash<ContainerType>::Hash(*m_owned);
+	}
+
+	// ========== Overrides BaseObject ==========
+
+	virtual ObjCategory GetCategory() const override
+	{
+		return sk_cat();
+	}
+
+	using BaseBaseBase::Set;
+
+	virtual void Set(const BaseBaseBase& other) override
+	{
+		try
+		{
+			const Self& casted = dynamic_cast<const Self&>(other);
+			*this = casted;
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("String", this->GetCategoryName());
+		}
+	}
+
+	virtual void Set(BaseBaseBase&& other) override
+	{
+		try
+		{
+			Self&& casted = dynamic_cast<Self&&>(other);
+			*this = std::forward<Self>(casted);
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("String", this->GetCategoryName());
+		}
+	}
+
+	virtual bool IsTrue() const override
+	{
+		return size() > 0;
+	}
+
+	// ========== Interface copy/Move ==========
+
+	using Base::Copy;
+	virtual std::unique_ptr<Base> Copy(const Base* /*unused*/) const override
+	{
+		return CopyImpl();
+	}
+
+	using Base::Move;
+	virtual std::unique_ptr<Base> Move(const Base* /*unused*/) override
+	{
+		return MoveImpl();
+	}
+
+	// ========== To string ==========
+
+	virtual std::string DebugString() const override
+	{
+		return "\"" +
+			Internal::ToString<std::string>(data(), data() + size()) +
+			"\"";
+	}
+
+	virtual std::string ShortDebugString() const override
+	{
+		return DebugString();
+	}
+
+	virtual ToStringType ToString() const override
+	{
+		return Internal::ToString<ToStringType>("\"") +
+			Internal::ToString<ToStringType>(data(), data() + size()) +
+			Internal::ToString<ToStringType>("\"");
+	}
+
+	virtual void DumpString(OutIterator<typename ToStringType::value_type> outIt) const override
+	{
+		*outIt++='\"';
+		std::copy(data(), data() + size(), outIt);
+		*outIt++='\"';
+	}
+
+private:
+
+	/**
+	 * @brief Copy the interned data into the container owned by this
+	 *        object, if it's not done yet
+	 *
+	 */
+	ContainerType& MakeOwned()
+	{
+		if (IsInterned())
+		{
+			m_owned = Internal::make_unique<ContainerType>(
+				m_entry->m_str.data(), m_entry->m_str.size());
+		}
+		return *m_owned;
+	}
+
+	std::unique_ptr<Self> CopyImpl() const
+	{
+		return Internal::make_unique<Self>(*this);
+	}
+
+	std::unique_ptr<Self> MoveImpl()
+	{
+		return Internal::make_unique<Self>(std::move(*this));
+	}
+
+	const InternEntry* m_entry;
+	std::unique_ptr<ContainerType> m_owned;
+
+}; // class InternedStringImpl
+
+} // namespace SimpleObjects
+
+// ========== Hash ==========
+namespace std
+{
+
+	template<typename _CtnType, typename _ToStringType>
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+	struct hash<SimpleObjects::InternedStringImpl<_CtnType, _ToStringType> >
+	{
+		using _ObjType = SimpleObjects::InternedStringImpl<_CtnType, _ToStringType>;
+#else
+	struct hash<SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE::InternedStringImpl<_CtnType, _ToStringType> >
+	{
+		using _ObjType = SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE::InternedStringImpl<_CtnType, _ToStringType>;
+#endif
+
+	public:
+
+#if __cplusplus < 201703L
+		typedef size_t       result_type;
+		typedef _ObjType     argument_type;
+#endif
+
+		size_t operator()(const _ObjType& cnt) const
+		{
+			return cnt.Hash();
+		}
+	}; // struct hash
+
+} // namespace std
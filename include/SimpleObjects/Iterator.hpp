@@ -12,8 +12,21 @@
 #include "IteratorZip.hpp"
 
 #include "Internal/IteratorTransform.hpp"
+#include "Internal/SmallObjPtr.hpp"
 #include "Internal/make_unique.hpp"
 
+#ifndef SIMPLEOBJECTS_ITERATOR_INLINE_SIZE
+/**
+ * @brief The size (in bytes) of the buffer embedded in the iterator wrappers
+ *        (e.g., FrIterator and RdIterator). Wrapped iterators that fit in
+ *        this buffer are stored in place, so creating and copying iterators
+ *        doesn't need any heap allocation.
+ *        It can be customized by defining this macro before including any
+ *        header of this library.
+ */
+#define SIMPLEOBJECTS_ITERATOR_INLINE_SIZE (sizeof(void*) * 8)
+#endif // !SIMPLEOBJECTS_ITERATOR_INLINE_SIZE
+
 #ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 namespace SimpleObjects
 #else
@@ -21,6 +34,35 @@ namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 #endif
 {
 
+namespace Internal
+{
+
+/**
+ * @brief Clones iterators that are stored on the heap, with the `Copy`
+ *        functions of the iterator interfaces
+ *
+ */
+struct ItCloner
+{
+	template<typename _ItIfType>
+	static std::unique_ptr<_ItIfType> Copy(const _ItIfType& it)
+	{
+		return it.Copy(it);
+	}
+
+	template<typename _ItIfType>
+	static std::unique_ptr<_ItIfType> Move(_ItIfType& it)
+	{
+		return it.Copy(it);
+	}
+}; // struct ItCloner
+
+template<typename _ItIfType>
+using ItInlinePtr =
+	SmallObjPtr<_ItIfType, SIMPLEOBJECTS_ITERATOR_INLINE_SIZE, ItCloner>;
+
+} // namespace Internal
+
 //========================================
 //||
 //||  Wrappers for iterators interfaces pointers
@@ -40,6 +82,7 @@ class OutIterator
 public: // Static members:
 	using WrappedIt = OutputIteratorIf<_TargetType>;
 	using WrappedItPtr = typename WrappedIt::SelfPtr;
+	using WrappedItStorage = Internal::ItInlinePtr<WrappedIt>;
 
 	typedef typename WrappedIt::difference_type         difference_type;
 	typedef typename WrappedIt::value_type              value_type;
@@ -55,12 +98,30 @@ public:
 		m_it(std::forward<WrappedItPtr>(it))
 	{}
 
+	explicit OutIterator(WrappedItStorage&& it) :
+		m_it(std::forward<WrappedItStorage>(it))
+	{}
+
+	/**
+	 * @brief Construct an iterator wrapping the iterator implementation of
+	 *        the given type, which is constructed in place, if it fits in
+	 *        the embedded buffer
+	 *
+	 * @tparam _ItWrapType The type of the iterator implementation
+	 */
+	template<typename _ItWrapType, typename... _Args>
+	static OutIterator Make(_Args&&... args)
+	{
+		return OutIterator(WrappedItStorage::template Make<_ItWrapType>(
+			std::forward<_Args>(args)...));
+	}
+
 	OutIterator(const OutIterator& otherIt) :
-		m_it(otherIt.m_it->Copy(*(otherIt.m_it)))
+		m_it(otherIt.m_it)
 	{}
 
 	OutIterator(OutIterator&& otherIt):
-		m_it(std::forward<WrappedItPtr>(otherIt.m_it))
+		m_it(std::forward<WrappedItStorage>(otherIt.m_it))
 	{}
 
 	virtual ~OutIterator() = default;
@@ -69,7 +130,7 @@ public:
 	{
 		if (this != &rhs)
 		{
-			m_it = rhs.m_it->Copy(*(rhs.m_it));
+			m_it = rhs.m_it;
 		}
 		return *this;
 	}
@@ -119,7 +180,7 @@ public:
 	}
 
 private:
-	WrappedItPtr m_it;
+	WrappedItStorage m_it;
 
 }; // class OutIterator
 
@@ -136,6 +197,7 @@ class InIterator
 public: // Static members:
 	using WrappedIt = InputIteratorIf<_TargetType, true>;
 	using WrappedItPtr = typename WrappedIt::SelfPtr;
+	using WrappedItStorage = Internal::ItInlinePtr<WrappedIt>;
 
 	typedef typename WrappedIt::difference_type         difference_type;
 	typedef typename WrappedIt::value_type              value_type;
@@ -151,12 +213,30 @@ public:
 		m_it(std::forward<WrappedItPtr>(it))
 	{}
 
+	explicit InIterator(WrappedItStorage&& it) :
+		m_it(std::forward<WrappedItStorage>(it))
+	{}
+
+	/**
+	 * @brief Construct an iterator wrapping the iterator implementation of
+	 *        the given type, which is constructed in place, if it fits in
+	 *        the embedded buffer
+	 *
+	 * @tparam _ItWrapType The type of the iterator implementation
+	 */
+	template<typename _ItWrapType, typename... _Args>
+	static InIterator Make(_Args&&... args)
+	{
+		return InIterator(WrappedItStorage::template Make<_ItWrapType>(
+			std::forward<_Args>(args)...));
+	}
+
 	InIterator(const InIterator& otherIt) :
-		m_it(otherIt.m_it->Copy(*(otherIt.m_it)))
+		m_it(otherIt.m_it)
 	{}
 
 	InIterator(InIterator&& otherIt):
-		m_it(std::forward<WrappedItPtr>(otherIt.m_it))
+		m_it(std::forward<WrappedItStorage>(otherIt.m_it))
 	{}
 
 	virtual ~InIterator() = default;
@@ -165,7 +245,7 @@ public:
 	{
 		if (this != &rhs)
 		{
-			m_it = rhs.m_it->Copy(*(rhs.m_it));
+			m_it = rhs.m_it;
 		}
 		return *this;
 	}
@@ -213,7 +293,7 @@ public:
 	}
 
 private:
-	WrappedItPtr m_it;
+	WrappedItStorage m_it;
 
 }; // class InIterator
 
@@ -231,6 +311,7 @@ class FrIterator
 public: // Static members:
 	using WrappedIt = ForwardIteratorIf<_TargetType, _IsConst>;
 	using WrappedItPtr = typename WrappedIt::SelfPtr;
+	using WrappedItStorage = Internal::ItInlinePtr<WrappedIt>;
 
 	typedef typename WrappedIt::difference_type         difference_type;
 	typedef typename WrappedIt::value_type              value_type;
@@ -246,12 +327,30 @@ public:
 		m_it(std::forward<WrappedItPtr>(it))
 	{}
 
+	explicit FrIterator(WrappedItStorage&& it) :
+		m_it(std::forward<WrappedItStorage>(it))
+	{}
+
+	/**
+	 * @brief Construct an iterator wrapping the iterator implementation of
+	 *        the given type, which is constructed in place, if it fits in
+	 *        the embedded buffer
+	 *
+	 * @tparam _ItWrapType The type of the iterator implementation
+	 */
+	template<typename _ItWrapType, typename... _Args>
+	static FrIterator Make(_Args&&... args)
+	{
+		return FrIterator(WrappedItStorage::template Make<_ItWrapType>(
+			std::forward<_Args>(args)...));
+	}
+
 	FrIterator(const FrIterator& otherIt) :
-		m_it(otherIt.m_it->Copy(*(otherIt.m_it)))
+		m_it(otherIt.m_it)
 	{}
 
 	FrIterator(FrIterator&& otherIt):
-		m_it(std::forward<WrappedItPtr>(otherIt.m_it))
+		m_it(std::forward<WrappedItStorage>(otherIt.m_it))
 	{}
 
 	virtual ~FrIterator() = default;
@@ -260,7 +359,7 @@ public:
 	{
 		if (this != &rhs)
 		{
-			m_it = rhs.m_it->Copy(*(rhs.m_it));
+			m_it = rhs.m_it;
 		}
 		return *this;
 	}
@@ -315,7 +414,7 @@ public:
 	}
 
 private:
-	WrappedItPtr m_it;
+	WrappedItStorage m_it;
 
 }; // class FrIterator
 
@@ -333,6 +432,7 @@ class BiIterator
 public: // Static members:
 	using WrappedIt = BidirectionalIteratorIf<_TargetType, _IsConst>;
 	using WrappedItPtr = typename WrappedIt::SelfPtr;
+	using WrappedItStorage = Internal::ItInlinePtr<WrappedIt>;
 
 	typedef typename WrappedIt::difference_type         difference_type;
 	typedef typename WrappedIt::value_type              value_type;
@@ -348,12 +448,30 @@ public:
 		m_it(std::forward<WrappedItPtr>(it))
 	{}
 
+	explicit BiIterator(WrappedItStorage&& it) :
+		m_it(std::forward<WrappedItStorage>(it))
+	{}
+
+	/**
+	 * @brief Construct an iterator wrapping the iterator implementation of
+	 *        the given type, which is constructed in place, if it fits in
+	 *        the embedded buffer
+	 *
+	 * @tparam _ItWrapType The type of the iterator implementation
+	 */
+	template<typename _ItWrapType, typename... _Args>
+	static BiIterator Make(_Args&&... args)
+	{
+		return BiIterator(WrappedItStorage::template Make<_ItWrapType>(
+			std::forward<_Args>(args)...));
+	}
+
 	BiIterator(const BiIterator& otherIt) :
-		m_it(otherIt.m_it->Copy(*(otherIt.m_it)))
+		m_it(otherIt.m_it)
 	{}
 
 	BiIterator(BiIterator&& otherIt):
-		m_it(std::forward<WrappedItPtr>(otherIt.m_it))
+		m_it(std::forward<WrappedItStorage>(otherIt.m_it))
 	{}
 
 	virtual ~BiIterator() = default;
@@ -362,7 +480,7 @@ public:
 	{
 		if (this != &rhs)
 		{
-			m_it = rhs.m_it->Copy(*(rhs.m_it));
+			m_it = rhs.m_it;
 		}
 		return *this;
 	}
@@ -428,7 +546,7 @@ public:
 	}
 
 private:
-	WrappedItPtr m_it;
+	WrappedItStorage m_it;
 
 }; // class BiIterator
 
@@ -448,6 +566,7 @@ public: // Static members:
 
 	using WrappedIt = RandomAccessIteratorIf<_TargetType, _IsConst>;
 	using WrappedItPtr = typename WrappedIt::SelfPtr;
+	using WrappedItStorage = Internal::ItInlinePtr<WrappedIt>;
 
 	typedef typename WrappedIt::difference_type         difference_type;
 	typedef typename WrappedIt::value_type              value_type;
@@ -465,12 +584,30 @@ public:
 		m_it(std::forward<WrappedItPtr>(it))
 	{}
 
+	explicit RdIterator(WrappedItStorage&& it) :
+		m_it(std::forward<WrappedItStorage>(it))
+	{}
+
+	/**
+	 * @brief Construct an iterator wrapping the iterator implementation of
+	 *        the given type, which is constructed in place, if it fits in
+	 *        the embedded buffer
+	 *
+	 * @tparam _ItWrapType The type of the iterator implementation
+	 */
+	template<typename _ItWrapType, typename... _Args>
+	static RdIterator Make(_Args&&... args)
+	{
+		return RdIterator(WrappedItStorage::template Make<_ItWrapType>(
+			std::forward<_Args>(args)...));
+	}
+
 	RdIterator(const RdIterator& otherIt) :
-		m_it(otherIt.m_it->Copy(*(otherIt.m_it)))
+		m_it(otherIt.m_it)
 	{}
 
 	RdIterator(RdIterator&& otherIt):
-		m_it(std::forward<WrappedItPtr>(otherIt.m_it))
+		m_it(std::forward<WrappedItStorage>(otherIt.m_it))
 	{}
 
 	virtual ~RdIterator() = default;
@@ -479,7 +616,7 @@ public:
 	{
 		if (this != &rhs)
 		{
-			m_it = rhs.m_it->Copy(*(rhs.m_it));
+			m_it = rhs.m_it;
 		}
 		return *this;
 	}
@@ -607,7 +744,7 @@ public:
 	}
 
 private:
-	WrappedItPtr m_it;
+	WrappedItStorage m_it;
 
 }; // class RdIterator
 
@@ -616,7 +753,7 @@ template<typename _ValType,
 inline OutIterator<_ValType> ToOutIt(_OriItType it)
 {
 	using ItWrap = CppStdOutIteratorWrap<_OriItType, _ValType>;
-	return OutIterator<_ValType>(ItWrap::Build(it));
+	return OutIterator<_ValType>::template Make<ItWrap>(it);
 }
 
 template<typename _OriItType,
@@ -625,7 +762,7 @@ inline InIterator<_ValType> ToInIt(_OriItType it)
 {
 	using ItWrap = CppStdInIteratorWrap<
 		_OriItType, _ValType, true, Internal::ItTransformDirect>;
-	return InIterator<_ValType>(ItWrap::Build(it));
+	return InIterator<_ValType>::template Make<ItWrap>(it);
 }
 
 template<bool _IsConst,
@@ -635,7 +772,7 @@ inline FrIterator<_ValType, _IsConst> ToFrIt(_OriItType it)
 {
 	using ItWrap = CppStdFwIteratorWrap<
 		_OriItType, _ValType, _IsConst, Internal::ItTransformDirect>;
-	return FrIterator<_ValType, _IsConst>(ItWrap::Build(it));
+	return FrIterator<_ValType, _IsConst>::template Make<ItWrap>(it);
 }
 
 template<bool _IsConst,
@@ -645,7 +782,7 @@ inline BiIterator<_ValType, _IsConst> ToBiIt(_OriItType it)
 {
 	using ItWrap = CppStdBiIteratorWrap<
 		_OriItType, _ValType, _IsConst, Internal::ItTransformDirect>;
-	return BiIterator<_ValType, _IsConst>(ItWrap::Build(it));
+	return BiIterator<_ValType, _IsConst>::template Make<ItWrap>(it);
 }
 
 template<bool _IsConst,
@@ -655,7 +792,7 @@ inline RdIterator<_ValType, _IsConst> ToRdIt(_OriItType it)
 {
 	using ItWrap = CppStdRdIteratorWrap<
 		_OriItType, _ValType, _IsConst, Internal::ItTransformDirect>;
-	return RdIterator<_ValType, _IsConst>(ItWrap::Build(it));
+	return RdIterator<_ValType, _IsConst>::template Make<ItWrap>(it);
 }
 
 template<bool _IsConst, typename ..._ItTypes>
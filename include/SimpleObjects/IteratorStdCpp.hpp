@@ -413,7 +413,7 @@ public:
 
 	CppStdRdIteratorWrap(CppStdRdIteratorWrap&& other) :
 		_BaseIf::RandomAccessIteratorIf(),
-		_Base::CppStdBiIteratorWrap(std::forward<_BaseIf>(other))
+		_Base::CppStdBiIteratorWrap(std::forward<_Base>(other))
 	{}
 
 	virtual ~CppStdRdIteratorWrap() = default;
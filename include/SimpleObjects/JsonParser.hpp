@@ -0,0 +1,781 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <deque>
+#include <istream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "DefaultTypes.hpp"
+#include "Exception.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A JSON parser that builds the object tree directly.
+ *        The input can be given all at once (i.e., `Parse`), or chunk by
+ *        chunk (i.e., `Feed` followed by `Finish`), in which case, tokens
+ *        spanning over multiple chunks are handled by the parser.
+ *        Nested values are tracked with an explicit stack, instead of
+ *        recursion, so the nesting depth is only bounded by the memory.
+ *
+ *        Integers are parsed into Int64, or UInt64 if it's too large for
+ *        Int64; other numbers, and integers out of the range of both
+ *        types, are parsed into Double.
+ *        If there are duplicate keys in a JSON object, only the first one
+ *        will be kept.
+ *        Optionally, keys of JSON objects can be parsed into InternedString,
+ *        so that the keys repeating over documents are stored only once,
+ *        and are hashed and compared cheaply.
+ *
+ */
+class JsonParser
+{
+public: // static members
+
+	using Self = JsonParser;
+
+	static constexpr size_t sk_streamChunkSize = 4096;
+
+	/**
+	 * @brief Parse the given JSON text
+	 *
+	 * @param data The pointer to the beginning of the text
+	 * @param size The size of the text in bytes
+	 * @return The parsed object
+	 */
+	static Object Parse(const char* data, size_t size)
+	{
+		Self parser;
+		parser.Feed(data, size);
+		return parser.Finish();
+	}
+
+	static Object Parse(const std::string& str)
+	{
+		return Parse(str.data(), str.size());
+	}
+
+	/**
+	 * @brief Parse the JSON text read from the given stream, until the end
+	 *        of the stream is reached
+	 *
+	 */
+	static Object Parse(std::istream& stream)
+	{
+		Self parser;
+		char buf[sk_streamChunkSize];
+		do
+		{
+			stream.read(buf, sizeof(buf));
+			parser.Feed(buf, static_cast<size_t>(stream.gcount()));
+		} while (stream);
+		return parser.Finish();
+	}
+
+public:
+
+	JsonParser() :
+		JsonParser(false)
+	{}
+
+	/**
+	 * @brief Construct a new JSON parser
+	 *
+	 * @param internKeys Whether or not the keys of JSON objects are parsed
+	 *                   into InternedString, instead of String
+	 */
+	explicit JsonParser(bool internKeys) :
+		m_internKeys(internKeys),
+		m_state(State::Value),
+		m_frames(),
+		m_valStack(),
+		m_keyStack(),
+		m_pending(),
+		m_pendingScan(0),
+		m_offset(0),
+		m_base(nullptr)
+	{}
+
+	JsonParser(const Self& other) = delete;
+
+	JsonParser(Self&& other) = default;
+
+	virtual ~JsonParser() = default;
+
+	Self& operator=(const Self& rhs) = delete;
+
+	Self& operator=(Self&& rhs) = default;
+
+	/**
+	 * @brief Feed the next chunk of the JSON text to the parser.
+	 *        Values are built as soon as they are complete; only the
+	 *        incomplete token at the end of the chunk (if any) is buffered.
+	 *        Once a ParseError is thrown, the parser must be `Reset` before
+	 *        it can be used again.
+	 *
+	 * @param data The pointer to the beginning of the chunk
+	 * @param size The size of the chunk in bytes
+	 */
+	void Feed(const char* data, size_t size)
+	{
+		if (m_pending.empty())
+		{
+			size_t consumed = ParseSome(data, data + size, false);
+			m_pending.assign(data + consumed, data + size);
+		}
+		else
+		{
+			m_pending.append(data, size);
+			const char* begin = m_pending.data();
+			size_t consumed = ParseSome(begin, begin + m_pending.size(), false);
+			m_pending.erase(0, consumed);
+		}
+	}
+
+	void Feed(const std::string& str)
+	{
+		Feed(str.data(), str.size());
+	}
+
+	bool IsInterningKeys() const
+	{
+		return m_internKeys;
+	}
+
+	/**
+	 * @brief Indicate the end of the input, and retrieve the parsed object.
+	 *        After this call, the parser is reset and is ready for the next
+	 *        input.
+	 *
+	 * @exception ParseError If the input is not a complete JSON value
+	 * @return The parsed object
+	 */
+	Object Finish()
+	{
+		const char* begin = m_pending.data();
+		ParseSome(begin, begin + m_pending.size(), true);
+		m_pending.clear();
+
+		if (m_state != State::Done)
+		{
+			throw ParseError("Unexpected end of input", m_offset);
+		}
+
+		Object res = std::move(m_valStack.back());
+		Reset();
+		return res;
+	}
+
+	/**
+	 * @brief Discard all the parsed values and buffered input, so that the
+	 *        parser can be used for a new input
+	 *
+	 */
+	void Reset()
+	{
+		m_state = State::Value;
+		m_frames.clear();
+		m_valStack.clear();
+		m_keyStack.clear();
+		m_pending.clear();
+		m_pendingScan = 0;
+		m_offset = 0;
+		m_base = nullptr;
+	}
+
+private: // helper types and functions
+
+	enum class State
+	{
+		Value,
+		ValueOrEnd,
+		Key,
+		KeyOrEnd,
+		Colon,
+		CommaOrEnd,
+		Done,
+	}; // enum class State
+
+	/**
+	 * @brief A JSON array or object that is still being parsed; its values
+	 *        (and keys) are the ones above the given bases in the stacks
+	 *
+	 */
+	struct Frame
+	{
+		bool m_isDict;
+		size_t m_valBase;
+		size_t m_keyBase;
+	}; // struct Frame
+
+	static bool IsSpace(char ch)
+	{
+		return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+	}
+
+	static bool IsDigit(char ch)
+	{
+		return '0' <= ch && ch <= '9';
+	}
+
+	static const char* SkipDigits(const char* p, const char* end)
+	{
+		while (p < end && IsDigit(*p))
+		{
+			++p;
+		}
+		return p;
+	}
+
+	static int HexVal(char ch)
+	{
+		if ('0' <= ch && ch <= '9')
+		{
+			return ch - '0';
+		}
+		else if ('a' <= ch && ch <= 'f')
+		{
+			return ch - 'a' + 10;
+		}
+		else if ('A' <= ch && ch <= 'F')
+		{
+			return ch - 'A' + 10;
+		}
+		return -1;
+	}
+
+	static void AppendUtf8(std::string& out, uint32_t cp)
+	{
+		if (cp < 0x80)
+		{
+			out.push_back(static_cast<char>(cp));
+		}
+		else if (cp < 0x800)
+		{
+			out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+			out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		}
+		else if (cp < 0x10000)
+		{
+			out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+			out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		}
+		else
+		{
+			out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+			out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+			out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		}
+	}
+
+	[[noreturn]] void ThrowError(const std::string& msg, const char* pos) const
+	{
+		throw ParseError(msg, m_offset + static_cast<size_t>(pos - m_base));
+	}
+
+	/**
+	 * @brief Parse as many tokens as possible from the given range
+	 *
+	 * @param begin   The beginning of the range
+	 * @param end     The end of the range
+	 * @param isFinal Whether or not this is the end of the input
+	 * @return The number of bytes consumed; the remaining bytes are the
+	 *         beginning of a token that is not complete yet
+	 */
+	size_t ParseSome(const char* begin, const char* end, bool isFinal)
+	{
+		m_base = begin;
+		size_t resume = m_pendingScan;
+		m_pendingScan = 0;
+
+		const char* p = begin;
+		while (true)
+		{
+			while (p < end && IsSpace(*p))
+			{
+				++p;
+			}
+			if (p == end)
+			{
+				break;
+			}
+
+			const char* next = ParseToken(
+				p, end, isFinal, (p == begin ? resume : 0));
+			if (next == nullptr)
+			{
+				// the token is not complete yet
+				break;
+			}
+			p = next;
+		}
+
+		size_t consumed = static_cast<size_t>(p - begin);
+		m_offset += consumed;
+		return consumed;
+	}
+
+	/**
+	 * @brief Parse the token starting at `p`
+	 *
+	 * @return The end of the token, or nullptr if the token is incomplete
+	 */
+	const char* ParseToken(
+		const char* p, const char* end, bool isFinal, size_t resume)
+	{
+		switch (m_state)
+		{
+		case State::Done:
+			ThrowError("Extra data after the JSON value", p);
+
+		case State::Colon:
+			if (*p != ':')
+			{
+				ThrowError("Expecting \':\'", p);
+			}
+			m_state = State::Value;
+			return p + 1;
+
+		case State::CommaOrEnd:
+			if (*p == ',')
+			{
+				m_state = m_frames.back().m_isDict ? State::Key : State::Value;
+				return p + 1;
+			}
+			else if (*p == (m_frames.back().m_isDict ? '}' : ']'))
+			{
+				CloseFrame();
+				return p + 1;
+			}
+			ThrowError("Expecting \',\' or the end of the container", p);
+
+		case State::KeyOrEnd:
+			if (*p == '}')
+			{
+				CloseFrame();
+				return p + 1;
+			}
+			// fall through
+		case State::Key:
+			if (*p != '\"')
+			{
+				ThrowError("Expecting a string as the key", p);
+			}
+			return ParseString(p, end, isFinal, resume, true);
+
+		case State::ValueOrEnd:
+			if (*p == ']')
+			{
+				CloseFrame();
+				return p + 1;
+			}
+			// fall through
+		case State::Value:
+		default:
+			return ParseValue(p, end, isFinal, resume);
+		}
+	}
+
+	const char* ParseValue(
+		const char* p, const char* end, bool isFinal, size_t resume)
+	{
+		switch (*p)
+		{
+		case '{':
+			m_frames.push_back(Frame{ true, m_valStack.size(), m_keyStack.size() });
+			m_state = State::KeyOrEnd;
+			return p + 1;
+		case '[':
+			m_frames.push_back(Frame{ false, m_valStack.size(), m_keyStack.size() });
+			m_state = State::ValueOrEnd;
+			return p + 1;
+		case '\"':
+			return ParseString(p, end, isFinal, resume, false);
+		case 't':
+			return ParseLiteral(p, end, isFinal, "true", Object(Bool(true)));
+		case 'f':
+			return ParseLiteral(p, end, isFinal, "false", Object(Bool(false)));
+		case 'n':
+			return ParseLiteral(p, end, isFinal, "null", Object(Null()));
+		default:
+			if (*p == '-' || IsDigit(*p))
+			{
+				return ParseNumber(p, end, isFinal);
+			}
+			ThrowError("Unexpected character", p);
+		}
+	}
+
+	const char* ParseLiteral(
+		const char* p, const char* end, bool isFinal,
+		const char* literal, Object&& val)
+	{
+		size_t len = std::strlen(literal);
+		size_t avail = std::min(len, static_cast<size_t>(end - p));
+		if (std::memcmp(p, literal, avail) != 0)
+		{
+			ThrowError("Invalid literal", p);
+		}
+		if (avail < len)
+		{
+			if (isFinal)
+			{
+				ThrowError("Unexpected end of input", end);
+			}
+			return nullptr;
+		}
+		PushValue(std::forward<Object>(val));
+		return p + len;
+	}
+
+	const char* ParseNumber(const char* p, const char* end, bool isFinal)
+	{
+		const char* q = p;
+		bool isNeg = (*q == '-');
+		if (isNeg)
+		{
+			++q;
+		}
+
+		// integer part
+		const char* intBegin = q;
+		if (q < end && *q == '0')
+		{
+			++q;
+		}
+		else
+		{
+			q = SkipDigits(q, end);
+		}
+		const char* intEnd = q;
+		bool isInt = true;
+
+		if (intBegin == intEnd && q < end)
+		{
+			ThrowError("Invalid number", q);
+		}
+
+		// fraction part
+		if (q < end && *q == '.')
+		{
+			isInt = false;
+			const char* fracBegin = ++q;
+			q = SkipDigits(q, end);
+			if (q == fracBegin && q < end)
+			{
+				ThrowError("Invalid number", q);
+			}
+		}
+
+		// exponent part
+		if (q < end && (*q == 'e' || *q == 'E'))
+		{
+			isInt = false;
+			++q;
+			if (q < end && (*q == '+' || *q == '-'))
+			{
+				++q;
+			}
+			const char* expBegin = q;
+			q = SkipDigits(q, end);
+			if (q == expBegin && q < end)
+			{
+				ThrowError("Invalid number", q);
+			}
+		}
+
+		if (q == end)
+		{
+			// the number may continue in the next chunk
+			if (!isFinal)
+			{
+				return nullptr;
+			}
+			// otherwise, check if the number ends with a complete part
+			if (!IsDigit(*(q - 1)))
+			{
+				ThrowError("Unexpected end of input", q);
+			}
+		}
+
+		if (isInt)
+		{
+			constexpr uint64_t maxVal = std::numeric_limits<uint64_t>::max();
+			uint64_t val = 0;
+			bool isOverflow = false;
+			for (const char* d = intBegin; d < intEnd && !isOverflow; ++d)
+			{
+				uint64_t digit = static_cast<uint64_t>(*d - '0');
+				isOverflow = val > ((maxVal - digit) / 10);
+				val = (val * 10) + digit;
+			}
+
+			constexpr uint64_t maxPosInt64 = static_cast<uint64_t>(
+				std::numeric_limits<int64_t>::max());
+			if (!isOverflow && !isNeg)
+			{
+				if (val <= maxPosInt64)
+				{
+					PushValue(Object(Int64(static_cast<int64_t>(val))));
+				}
+				else
+				{
+					PushValue(Object(UInt64(val)));
+				}
+				return q;
+			}
+			else if (!isOverflow && val <= maxPosInt64 + 1)
+			{
+				// -(2^63) can't be negated in int64_t, so it's
+				// calculated as -(2^63 - 1) - 1
+				int64_t negVal = (val == maxPosInt64 + 1) ?
+					(-static_cast<int64_t>(maxPosInt64) - 1) :
+					-static_cast<int64_t>(val);
+				PushValue(Object(Int64(negVal)));
+				return q;
+			}
+			// otherwise, it can only be represented in floating point
+		}
+
+		std::string numStr(p, q);
+		PushValue(Object(Double(std::strtod(numStr.c_str(), nullptr))));
+		return q;
+	}
+
+	/**
+	 * @brief Parse the string starting at `p`, which points to the opening
+	 *        quote
+	 *
+	 * @param resume The offset (from `p`) where the scan for the closing
+	 *               quote should continue, which is recorded when the string
+	 *               was incomplete in the previous chunk; 0 to scan from the
+	 *               beginning
+	 * @param isKey  Whether or not this string is a key of a JSON object
+	 * @return The end of the string, or nullptr if it's incomplete
+	 */
+	const char* ParseString(
+		const char* p, const char* end, bool isFinal, size_t resume, bool isKey)
+	{
+		const char* q = p + (resume > 1 ? resume : 1);
+		while (q < end && *q != '\"')
+		{
+			if (static_cast<unsigned char>(*q) < 0x20)
+			{
+				ThrowError("Control character in string", q);
+			}
+			else if (*q == '\\')
+			{
+				if (q + 1 == end)
+				{
+					break;
+				}
+				++q;
+			}
+			++q;
+		}
+
+		if (q >= end || *q != '\"')
+		{
+			if (isFinal)
+			{
+				ThrowError("Unexpected end of input", end);
+			}
+			m_pendingScan = static_cast<size_t>(q - p);
+			return nullptr;
+		}
+
+		// `q` points to the closing quote
+		if (isKey && m_internKeys && (std::find(p + 1, q, '\\') == q))
+		{
+			// no escape sequence, so the key can be interned in place
+			m_keyStack.push_back(InternedString(
+				p + 1, static_cast<size_t>(q - p - 1)));
+			m_state = State::Colon;
+			return q + 1;
+		}
+
+		std::string str;
+		str.reserve(static_cast<size_t>(q - p - 1));
+		const char* s = p + 1;
+		while (s < q)
+		{
+			const char* esc = std::find(s, q, '\\');
+			str.append(s, esc);
+			if (esc == q)
+			{
+				break;
+			}
+			s = DecodeEscape(esc, q, str);
+		}
+
+		if (isKey)
+		{
+			if (m_internKeys)
+			{
+				m_keyStack.push_back(InternedString(str.data(), str.size()));
+			}
+			else
+			{
+				m_keyStack.push_back(String(std::move(str)));
+			}
+			m_state = State::Colon;
+		}
+		else
+		{
+			PushValue(Object(String(std::move(str))));
+		}
+		return q + 1;
+	}
+
+	/**
+	 * @brief Decode the escape sequence starting at `esc`, which points to
+	 *        the backslash
+	 *
+	 * @return The end of the escape sequence
+	 */
+	const char* DecodeEscape(const char* esc, const char* end, std::string& out)
+	{
+		switch (esc[1])
+		{
+		case '\"': out.push_back('\"'); return esc + 2;
+		case '\\': out.push_back('\\'); return esc + 2;
+		case '/':  out.push_back('/');  return esc + 2;
+		case 'b':  out.push_back('\b'); return esc + 2;
+		case 'f':  out.push_back('\f'); return esc + 2;
+		case 'n':  out.push_back('\n'); return esc + 2;
+		case 'r':  out.push_back('\r'); return esc + 2;
+		case 't':  out.push_back('\t'); return esc + 2;
+		case 'u':
+			break;
+		default:
+			ThrowError("Invalid escape sequence", esc);
+		}
+
+		uint32_t cp = DecodeHex4(esc, end);
+		const char* next = esc + 6;
+		if (0xDC00 <= cp && cp <= 0xDFFF)
+		{
+			ThrowError("Unpaired surrogate", esc);
+		}
+		else if (0xD800 <= cp && cp <= 0xDBFF)
+		{
+			// high surrogate, which must be followed by a low surrogate
+			if (end - next < 6 || next[0] != '\\' || next[1] != 'u')
+			{
+				ThrowError("Unpaired surrogate", esc);
+			}
+			uint32_t low = DecodeHex4(next, end);
+			if (low < 0xDC00 || 0xDFFF < low)
+			{
+				ThrowError("Unpaired surrogate", esc);
+			}
+			cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+			next += 6;
+		}
+		AppendUtf8(out, cp);
+		return next;
+	}
+
+	/**
+	 * @brief Decode the 4 hex digits of the `\uXXXX` escape sequence
+	 *        starting at `esc`
+	 *
+	 */
+	uint32_t DecodeHex4(const char* esc, const char* end) const
+	{
+		if (end - esc < 6)
+		{
+			ThrowError("Invalid unicode escape sequence", esc);
+		}
+		uint32_t res = 0;
+		for (size_t i = 2; i < 6; ++i)
+		{
+			int val = HexVal(esc[i]);
+			if (val < 0)
+			{
+				ThrowError("Invalid unicode escape sequence", esc);
+			}
+			res = (res << 4) | static_cast<uint32_t>(val);
+		}
+		return res;
+	}
+
+	void PushValue(Object&& val)
+	{
+		m_valStack.push_back(std::forward<Object>(val));
+		m_state = m_frames.empty() ? State::Done : State::CommaOrEnd;
+	}
+
+	/**
+	 * @brief Build the List or Dict for the innermost frame, by moving its
+	 *        values (and keys) out of the stacks
+	 *
+	 */
+	void CloseFrame()
+	{
+		Frame frame = m_frames.back();
+		m_frames.pop_back();
+
+		auto valBegin = m_valStack.begin() + frame.m_valBase;
+		if (frame.m_isDict)
+		{
+			Dict dict;
+			auto keyBegin = m_keyStack.begin() + frame.m_keyBase;
+			auto valIt = valBegin;
+			for (auto keyIt = keyBegin; keyIt != m_keyStack.end(); ++keyIt)
+			{
+				dict.InsertOnly(std::move(*keyIt), std::move(*valIt));
+				++valIt;
+			}
+			m_keyStack.erase(keyBegin, m_keyStack.end());
+			m_valStack.erase(valBegin, m_valStack.end());
+			PushValue(Object(std::move(dict)));
+		}
+		else
+		{
+			List list;
+			list.reserve(m_valStack.size() - frame.m_valBase);
+			for (auto valIt = valBegin; valIt != m_valStack.end(); ++valIt)
+			{
+				list.push_back(std::move(*valIt));
+			}
+			m_valStack.erase(valBegin, m_valStack.end());
+			PushValue(Object(std::move(list)));
+		}
+	}
+
+private:
+
+	bool m_internKeys;
+	State m_state;
+	std::vector<Frame> m_frames;
+	// deque is used, since Object's move constructor is not noexcept,
+	// which would make vector copy (i.e., deep copy) values on growth
+	std::deque<Object> m_valStack;
+	std::deque<HashableObject> m_keyStack;
+	std::string m_pending;
+	size_t m_pendingScan;
+	size_t m_offset;
+	const char* m_base;
+
+}; // class JsonParser
+
+} // namespace SimpleObjects
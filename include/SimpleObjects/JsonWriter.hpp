@@ -0,0 +1,531 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <string>
+#include <type_traits>
+
+#include "DefaultTypes.hpp"
+#include "Exception.hpp"
+#include "Internal/ObjTag.hpp"
+#include "Internal/rj_dtoa.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A JSON writer that serializes an object tree into a single
+ *        contiguous buffer, in one walk over the tree.
+ *        Each token reserves its exact size in the buffer before it's
+ *        written, and numbers are formatted in place, so no temporary string
+ *        is allocated per value.
+ *        The buffer grows geometrically; the result can also be appended to
+ *        an existing string, so its capacity can be reused across writes.
+ *
+ *        Dict keys must be strings, and Bytes can't be represented in JSON;
+ *        TypeError is thrown in both cases. Non-finite real numbers are not
+ *        supported by JSON either, and they are rejected in the same way.
+ *
+ */
+class JsonWriter
+{
+public: // static members
+
+	using Self = JsonWriter;
+
+	static constexpr size_t sk_defaultIndent = 4;
+
+	/**
+	 * @brief Serialize the given object into compact JSON
+	 *
+	 */
+	static std::string Dump(const BaseObj& obj)
+	{
+		Self writer;
+		return writer.Write(obj);
+	}
+
+	/**
+	 * @brief Serialize the given object into JSON, with each value in its
+	 *        own line, and nested values indented by the given number of
+	 *        spaces
+	 *
+	 */
+	static std::string DumpPretty(
+		const BaseObj& obj, size_t indent = sk_defaultIndent)
+	{
+		Self writer(indent);
+		return writer.Write(obj);
+	}
+
+public:
+
+	/**
+	 * @brief Construct a new JSON writer
+	 *
+	 * @param indent The number of spaces for each level of indentation;
+	 *               0 to write compact JSON
+	 */
+	explicit JsonWriter(size_t indent = 0) :
+		m_indent(indent),
+		m_out(nullptr),
+		m_len(0),
+		m_numBuf()
+	{}
+
+	JsonWriter(const Self& other) = delete;
+
+	JsonWriter(Self&& other) = default;
+
+	virtual ~JsonWriter() = default;
+
+	Self& operator=(const Self& rhs) = delete;
+
+	Self& operator=(Self&& rhs) = default;
+
+	/**
+	 * @brief Serialize the given object, and append the result to `out`;
+	 *        `out` is left unchanged if an exception is thrown
+	 *
+	 */
+	void Write(const BaseObj& obj, std::string& out)
+	{
+		const size_t initLen = out.size();
+		m_out = &out;
+		m_len = initLen;
+		try
+		{
+			WriteValue(obj, 0);
+		}
+		catch (...)
+		{
+			// leave the output as it was
+			out.resize(initLen);
+			m_out = nullptr;
+			throw;
+		}
+		out.resize(m_len);
+		m_out = nullptr;
+	}
+
+	std::string Write(const BaseObj& obj)
+	{
+		std::string res;
+		Write(obj, res);
+		return res;
+	}
+
+private: // helper types and functions
+
+	struct NumWriter
+	{
+		Self* m_writer;
+
+		template<typename _ValType>
+		void operator()(const _ValType& val) const
+		{
+			m_writer->WriteNum(val);
+		}
+	}; // struct NumWriter
+
+	/**
+	 * @brief The number of bytes each character takes after being escaped
+	 *
+	 */
+	static const uint8_t* GetEscapeLenLut()
+	{
+		struct Lut
+		{
+			Lut()
+			{
+				for (size_t i = 0; i < 256; ++i)
+				{
+					m_data[i] = (i < 0x20) ? 6 : 1;
+				}
+				m_data[static_cast<uint8_t>('\"')] = 2;
+				m_data[static_cast<uint8_t>('\\')] = 2;
+				m_data[static_cast<uint8_t>('\b')] = 2;
+				m_data[static_cast<uint8_t>('\f')] = 2;
+				m_data[static_cast<uint8_t>('\n')] = 2;
+				m_data[static_cast<uint8_t>('\r')] = 2;
+				m_data[static_cast<uint8_t>('\t')] = 2;
+			}
+
+			uint8_t m_data[256];
+		}; // struct Lut
+
+		static const Lut sk_lut;
+		return sk_lut.m_data;
+	}
+
+	/**
+	 * @brief Make sure there are at least `n` bytes available at the end of
+	 *        the output buffer
+	 *
+	 * @return The pointer to the first available byte
+	 */
+	char* Extend(size_t n)
+	{
+		size_t required = m_len + n;
+		if (m_out->size() < required)
+		{
+			// use up the reserved capacity first, before growing it
+			size_t newSize = m_out->capacity();
+			if (newSize < required)
+			{
+				newSize = m_out->size() * 2;
+				newSize = newSize < 256 ? 256 : newSize;
+				newSize = newSize < required ? required : newSize;
+			}
+			m_out->resize(newSize);
+		}
+		return &(*m_out)[m_len];
+	}
+
+	void WriteRaw(const char* str, size_t len)
+	{
+		std::memcpy(Extend(len), str, len);
+		m_len += len;
+	}
+
+	void WriteChar(char ch)
+	{
+		*Extend(1) = ch;
+		++m_len;
+	}
+
+	void WriteNewLine(size_t depth)
+	{
+		if (m_indent == 0)
+		{
+			return;
+		}
+		size_t len = 1 + (depth * m_indent);
+		char* dest = Extend(len);
+		dest[0] = '\n';
+		std::memset(dest + 1, ' ', len - 1);
+		m_len += len;
+	}
+
+	template<typename _ValType>
+	static bool IsNegative(_ValType val, std::true_type)
+	{
+		return val < 0;
+	}
+
+	template<typename _ValType>
+	static bool IsNegative(_ValType, std::false_type)
+	{
+		return false;
+	}
+
+	void WriteNum(bool val)
+	{
+		if (val)
+		{
+			WriteRaw("true", 4);
+		}
+		else
+		{
+			WriteRaw("false", 5);
+		}
+	}
+
+	template<typename _ValType,
+		typename std::enable_if<
+			std::is_integral<_ValType>::value &&
+			!std::is_same<_ValType, bool>::value, int
+		>::type = 0>
+	void WriteNum(_ValType val)
+	{
+		// 20 digits for uint64_t max, and 1 more for the sign
+		static constexpr size_t sk_maxLen = 21;
+
+		bool isNeg = IsNegative(val, std::is_signed<_ValType>());
+		// negate in the unsigned domain, so the minimum value is fine
+		uint64_t absVal = isNeg ?
+			(0 - static_cast<uint64_t>(val)) :
+			static_cast<uint64_t>(val);
+
+		char tmp[sk_maxLen];
+		char* begin = tmp + sk_maxLen;
+		const char* lut = Internal::GetDigitsLut();
+		while (absVal >= 100)
+		{
+			const char* d = lut + ((absVal % 100) * 2);
+			absVal /= 100;
+			*--begin = d[1];
+			*--begin = d[0];
+		}
+		if (absVal >= 10)
+		{
+			const char* d = lut + (absVal * 2);
+			*--begin = d[1];
+			*--begin = d[0];
+		}
+		else
+		{
+			*--begin = static_cast<char>('0' + absVal);
+		}
+		if (isNeg)
+		{
+			*--begin = '-';
+		}
+
+		WriteRaw(begin, static_cast<size_t>((tmp + sk_maxLen) - begin));
+	}
+
+	template<typename _ValType,
+		typename std::enable_if<
+			std::is_floating_point<_ValType>::value, int
+		>::type = 0>
+	void WriteNum(_ValType val)
+	{
+		double dVal = static_cast<double>(val);
+		if (!std::isfinite(dVal))
+		{
+			throw TypeError("finite real number", "non-finite real number");
+		}
+
+		// Same output as Internal::ToString, but the digits are generated
+		// into a buffer owned by the writer, so it won't allocate memory
+		// once the buffer is large enough
+		Internal::Double d(dVal);
+		if (d.IsZero())
+		{
+			if (d.Sign())
+			{
+				WriteRaw("-0.0", 4);
+			}
+			else
+			{
+				WriteRaw("0.0", 3);
+			}
+			return;
+		}
+
+		m_numBuf.clear();
+		if (dVal < 0)
+		{
+			m_numBuf.push_back('-');
+			dVal = -dVal;
+		}
+		int k = 0;
+		Internal::Grisu2(m_numBuf, k, dVal);
+		Internal::Prettify(m_numBuf, k, 324);
+		WriteRaw(m_numBuf.data(), m_numBuf.size());
+	}
+
+	void WriteString(const char* str, size_t len)
+	{
+		const uint8_t* lenLut = GetEscapeLenLut();
+
+		// compute the exact length first, so it's reserved at once
+		size_t outLen = 2;
+		for (size_t i = 0; i < len; ++i)
+		{
+			outLen += lenLut[static_cast<uint8_t>(str[i])];
+		}
+
+		char* dest = Extend(outLen);
+		*dest++ = '\"';
+		if (outLen == len + 2)
+		{
+			// nothing needs to be escaped
+			std::memcpy(dest, str, len);
+			dest += len;
+		}
+		else
+		{
+			static constexpr char sk_hex[] = "0123456789abcdef";
+			for (size_t i = 0; i < len; ++i)
+			{
+				char ch = str[i];
+				switch (ch)
+				{
+				case '\"': *dest++ = '\\'; *dest++ = '\"'; break;
+				case '\\': *dest++ = '\\'; *dest++ = '\\'; break;
+				case '\b': *dest++ = '\\'; *dest++ = 'b'; break;
+				case '\f': *dest++ = '\\'; *dest++ = 'f'; break;
+				case '\n': *dest++ = '\\'; *dest++ = 'n'; break;
+				case '\r': *dest++ = '\\'; *dest++ = 'r'; break;
+				case '\t': *dest++ = '\\'; *dest++ = 't'; break;
+				default:
+					if (static_cast<uint8_t>(ch) < 0x20)
+					{
+						*dest++ = '\\';
+						*dest++ = 'u';
+						*dest++ = '0';
+						*dest++ = '0';
+						*dest++ = sk_hex[static_cast<uint8_t>(ch) >> 4];
+						*dest++ = sk_hex[static_cast<uint8_t>(ch) & 0x0F];
+					}
+					else
+					{
+						*dest++ = ch;
+					}
+					break;
+				}
+			}
+		}
+		*dest = '\"';
+		m_len += outLen;
+	}
+
+	void WriteKey(const HashableBaseObj& key)
+	{
+		if (key.GetCategory() != ObjCategory::String)
+		{
+			throw TypeError("String", key.GetCategoryName());
+		}
+		const auto& str = key.AsString();
+		WriteString(str.data(), str.size());
+		WriteChar(':');
+		if (m_indent != 0)
+		{
+			WriteChar(' ');
+		}
+	}
+
+	/**
+	 * @brief Write a sequence (i.e., List or Tuple) as a JSON array
+	 *
+	 */
+	template<typename _SeqType>
+	void WriteArray(const _SeqType& seq, size_t depth)
+	{
+		size_t size = seq.size();
+		WriteChar('[');
+		for (size_t i = 0; i < size; ++i)
+		{
+			if (i != 0)
+			{
+				WriteChar(',');
+			}
+			WriteNewLine(depth + 1);
+			WriteValue(seq[i], depth + 1);
+		}
+		if (size != 0)
+		{
+			WriteNewLine(depth);
+		}
+		WriteChar(']');
+	}
+
+	void WriteValue(const BaseObj& obj, size_t depth)
+	{
+		switch (obj.GetCategory())
+		{
+		case ObjCategory::Null:
+			WriteRaw("null", 4);
+			break;
+
+		case ObjCategory::Bool:
+		case ObjCategory::Integer:
+		case ObjCategory::Real:
+		{
+			const auto& num = obj.AsRealNum();
+			auto numType = num.GetNumType();
+			if (numType != RealNumType::Other)
+			{
+				Internal::RealNumTagVisit<void, ToStringType>(
+					numType, num, NumWriter{ this });
+			}
+			else
+			{
+				auto str = num.ToString();
+				WriteRaw(str.data(), str.size());
+			}
+			break;
+		}
+
+		case ObjCategory::String:
+		{
+			const auto& str = obj.AsString();
+			WriteString(str.data(), str.size());
+			break;
+		}
+
+		case ObjCategory::List:
+			WriteArray(obj.AsList(), depth);
+			break;
+
+		case ObjCategory::Tuple:
+			WriteArray(obj.AsTuple(), depth);
+			break;
+
+		case ObjCategory::Dict:
+		{
+			const auto& dict = obj.AsDict();
+			WriteChar('{');
+			bool isFirst = true;
+			for (auto it = dict.cbegin(); it != dict.cend(); ++it)
+			{
+				if (!isFirst)
+				{
+					WriteChar(',');
+				}
+				isFirst = false;
+				WriteNewLine(depth + 1);
+				WriteKey(*std::get<0>(*it));
+				WriteValue(*std::get<1>(*it), depth + 1);
+			}
+			if (!isFirst)
+			{
+				WriteNewLine(depth);
+			}
+			WriteChar('}');
+			break;
+		}
+
+		case ObjCategory::StaticDict:
+		{
+			const auto& dict = obj.AsStaticDict();
+			WriteChar('{');
+			bool isFirst = true;
+			for (const auto& item : dict)
+			{
+				if (!isFirst)
+				{
+					WriteChar(',');
+				}
+				isFirst = false;
+				WriteNewLine(depth + 1);
+				WriteKey(item.first.get());
+				WriteValue(item.second.get(), depth + 1);
+			}
+			if (!isFirst)
+			{
+				WriteNewLine(depth);
+			}
+			WriteChar('}');
+			break;
+		}
+
+		case ObjCategory::Bytes:
+		default:
+			throw TypeError("JSON value", obj.GetCategoryName());
+		}
+	}
+
+private:
+
+	size_t m_indent;
+	std::string* m_out;
+	size_t m_len;
+	std::string m_numBuf;
+
+}; // class JsonWriter
+
+} // namespace SimpleObjects
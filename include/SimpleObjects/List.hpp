@@ -47,6 +47,8 @@ public: // Static member:
 	typedef RdIterator<value_type, true>                 const_iterator;
 	typedef RdIterator<value_type, false>                reverse_iterator;
 	typedef RdIterator<value_type, true>                 const_reverse_iterator;
+	typedef typename ContainerType::iterator             native_iterator;
+	typedef typename ContainerType::const_iterator       const_native_iterator;
 
 	typedef BaseBase                                     base_value_type;
 	typedef BaseBase&                                    base_reference;
@@ -65,6 +67,10 @@ public:
 		m_data()
 	{}
 
+	explicit ListImpl(const allocator_type& alloc) :
+		m_data(alloc)
+	{}
+
 	ListImpl(std::initializer_list<value_type> l) :
 		m_data(l)
 	{}
@@ -152,6 +158,14 @@ public:
 			return false;
 		}
 
+		const Self* rhsSame = dynamic_cast<const Self*>(&rhs);
+		if (rhsSame != nullptr)
+		{
+			// same concrete type, so the containers are compared directly,
+			// instead of through the type-erased iterators
+			return m_data == rhsSame->m_data;
+		}
+
 		return std::equal(m_data.cbegin(), m_data.cend(),
 			rhs.cbegin(),
 			[](const BaseBase& a, const BaseBase& b) -> bool
@@ -161,6 +175,14 @@ public:
 
 	virtual ObjectOrder ListBaseCompare(const Base& rhs) const override
 	{
+		const Self* rhsSame = dynamic_cast<const Self*>(&rhs);
+		if (rhsSame != nullptr)
+		{
+			return Internal::ObjectRangeCompareThreeWay(
+				m_data.cbegin(), m_data.cend(),
+				rhsSame->m_data.cbegin(), rhsSame->m_data.cend());
+		}
+
 		return Internal::ObjectRangeCompareThreeWay(
 			cbegin(), cend(),
 			rhs.cbegin(), rhs.cend());
@@ -205,6 +227,11 @@ public:
 		}
 	}
 
+	pointer data()
+	{
+		return m_data.data();
+	}
+
 	const_pointer data() const
 	{
 		return m_data.data();
@@ -301,6 +328,33 @@ public:
 		return ToRdIt<true>(m_data.crend());
 	}
 
+	// ========== native iterators ==========
+
+	// The iterators of the underlying container, which, unlike the
+	// type-erased ones above, don't allocate, and can be inlined and
+	// vectorized by the std algorithms. They are invalidated by the same
+	// operations as the ones of `ContainerType`.
+
+	native_iterator NativeBegin()
+	{
+		return m_data.begin();
+	}
+
+	native_iterator NativeEnd()
+	{
+		return m_data.end();
+	}
+
+	const_native_iterator NativeBegin() const
+	{
+		return m_data.cbegin();
+	}
+
+	const_native_iterator NativeEnd() const
+	{
+		return m_data.cend();
+	}
+
 	// ========== Overrides BaseObject ==========
 
 	virtual ObjCategory GetCategory() const override
@@ -535,6 +589,26 @@ protected:
 		}
 	}
 
+	// ========== batched iteration ==========
+
+	virtual void ListBaseForEach(
+		const std::function<void(base_reference)>& func) override
+	{
+		for (auto& item : m_data)
+		{
+			func(item);
+		}
+	}
+
+	virtual void ListBaseForEach(
+		const std::function<void(base_const_reference)>& func) const override
+	{
+		for (const auto& item : m_data)
+		{
+			func(item);
+		}
+	}
+
 private:
 
 	std::unique_ptr<Self> CopyImpl() const
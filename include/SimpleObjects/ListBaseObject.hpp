@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "BaseObject.hpp"
 
 #include "Iterator.hpp"
@@ -249,6 +251,22 @@ public:
 		return cend();
 	}
 
+	/**
+	 * @brief Call `func` on each item in the list, in order.
+	 *        The loop is run by the concrete list class, so, unlike the
+	 *        iterators above, it doesn't make any virtual calls per item.
+	 *
+	 */
+	void ForEach(const std::function<void(reference)>& func)
+	{
+		ListBaseForEach(func);
+	}
+
+	void ForEach(const std::function<void(const_reference)>& func) const
+	{
+		ListBaseForEach(func);
+	}
+
 	// ========== Copy and Move ==========
 
 	virtual std::unique_ptr<Self> Copy(const Self* /*unused*/) const = 0;
@@ -283,6 +301,12 @@ protected:
 
 	virtual void ListBasePushBack(const_reference val) = 0;
 
+	virtual void ListBaseForEach(
+		const std::function<void(reference)>& func) = 0;
+
+	virtual void ListBaseForEach(
+		const std::function<void(const_reference)>& func) const = 0;
+
 }; // class ListBaseObject
 
 } // namespace SimpleObjects
@@ -0,0 +1,435 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "DefaultTypes.hpp"
+#include "Exception.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+namespace Internal
+{
+
+/**
+ * @brief The number of bytes needed to represent the given length in
+ *        big-endian, without leading zeros
+ *
+ */
+inline size_t RlpLenOfLen(size_t len)
+{
+	size_t res = 0;
+	while (len > 0)
+	{
+		++res;
+		len >>= 8;
+	}
+	return res;
+}
+
+/**
+ * @brief The size of the prefix for a byte string or list with the given
+ *        payload size (the single byte case of byte strings is not
+ *        included)
+ *
+ */
+inline size_t RlpPrefixSize(size_t payloadSize)
+{
+	return payloadSize <= 55 ? 1 : (1 + RlpLenOfLen(payloadSize));
+}
+
+} // namespace Internal
+
+/**
+ * @brief An RLP encoder for trees of Bytes and List.
+ *        The encoded size of the tree is computed in a first pass, so the
+ *        output is written into a buffer of exactly that size in the second
+ *        pass, without any reallocation.
+ *        Objects of any other category can't be encoded, and TypeError is
+ *        thrown for them.
+ *
+ */
+class RlpEncoder
+{
+public: // static members
+
+	using Self = RlpEncoder;
+
+	static std::vector<uint8_t> Encode(const BaseObj& obj)
+	{
+		Self encoder;
+		std::vector<uint8_t> res;
+		encoder.Encode(obj, res);
+		return res;
+	}
+
+public:
+
+	RlpEncoder() :
+		m_listSizes(),
+		m_listIdx(0),
+		m_dest(nullptr)
+	{}
+
+	RlpEncoder(const Self& other) = delete;
+
+	RlpEncoder(Self&& other) = default;
+
+	virtual ~RlpEncoder() = default;
+
+	Self& operator=(const Self& rhs) = delete;
+
+	Self& operator=(Self&& rhs) = default;
+
+	/**
+	 * @brief Encode the given object, and append the result to `out`
+	 *
+	 */
+	void Encode(const BaseObj& obj, std::vector<uint8_t>& out)
+	{
+		m_listSizes.clear();
+		m_listIdx = 0;
+
+		size_t encSize = CalcSize(obj);
+
+		const size_t initLen = out.size();
+		out.resize(initLen + encSize);
+		m_dest = out.data() + initLen;
+		WriteItem(obj);
+		m_dest = nullptr;
+	}
+
+private: // helper functions
+
+	/**
+	 * @brief Calculate the encoded size of the given object; payload sizes
+	 *        of lists are recorded in pre-order, so they don't need to be
+	 *        calculated again when writing
+	 *
+	 */
+	size_t CalcSize(const BaseObj& obj)
+	{
+		switch (obj.GetCategory())
+		{
+		case ObjCategory::Bytes:
+		{
+			const auto& bytes = obj.AsBytes();
+			size_t size = bytes.size();
+			if (size == 1 && bytes.data()[0] < 0x80)
+			{
+				return 1;
+			}
+			return Internal::RlpPrefixSize(size) + size;
+		}
+
+		case ObjCategory::List:
+		{
+			const auto& list = obj.AsList();
+			size_t idx = m_listSizes.size();
+			m_listSizes.push_back(0);
+
+			size_t payloadSize = 0;
+			for (size_t i = 0; i < list.size(); ++i)
+			{
+				payloadSize += CalcSize(list[i]);
+			}
+			m_listSizes[idx] = payloadSize;
+			return Internal::RlpPrefixSize(payloadSize) + payloadSize;
+		}
+
+		default:
+			throw TypeError("Bytes or List", obj.GetCategoryName());
+		}
+	}
+
+	void WritePrefix(uint8_t shortBase, uint8_t longBase, size_t payloadSize)
+	{
+		if (payloadSize <= 55)
+		{
+			*m_dest++ = static_cast<uint8_t>(shortBase + payloadSize);
+			return;
+		}
+
+		size_t lenOfLen = Internal::RlpLenOfLen(payloadSize);
+		*m_dest++ = static_cast<uint8_t>(longBase + lenOfLen);
+		for (size_t i = lenOfLen; i > 0; --i)
+		{
+			*m_dest++ = static_cast<uint8_t>(payloadSize >> ((i - 1) * 8));
+		}
+	}
+
+	void WriteItem(const BaseObj& obj)
+	{
+		if (obj.GetCategory() == ObjCategory::Bytes)
+		{
+			const auto& bytes = obj.AsBytes();
+			size_t size = bytes.size();
+			const uint8_t* data = bytes.data();
+			if (size == 1 && data[0] < 0x80)
+			{
+				*m_dest++ = data[0];
+				return;
+			}
+			WritePrefix(0x80, 0xB7, size);
+			if (size > 0)
+			{
+				std::memcpy(m_dest, data, size);
+				m_dest += size;
+			}
+		}
+		else
+		{
+			// categories are already checked by CalcSize
+			const auto& list = obj.AsList();
+			WritePrefix(0xC0, 0xF7, m_listSizes[m_listIdx++]);
+			for (size_t i = 0; i < list.size(); ++i)
+			{
+				WriteItem(list[i]);
+			}
+		}
+	}
+
+private:
+
+	std::vector<size_t> m_listSizes;
+	size_t m_listIdx;
+	uint8_t* m_dest;
+
+}; // class RlpEncoder
+
+/**
+ * @brief An RLP decoder that builds trees of Bytes and List.
+ *        Byte strings are constructed directly from the slices of the input
+ *        buffer, and nested lists are tracked with an explicit stack,
+ *        instead of recursion.
+ *        Only canonical encodings are accepted; otherwise, ParseError is
+ *        thrown.
+ *
+ */
+class RlpDecoder
+{
+public: // static members
+
+	using Self = RlpDecoder;
+
+	/**
+	 * @brief Decode the given RLP encoded data, which must contain exactly
+	 *        one item
+	 *
+	 */
+	static Object Decode(const uint8_t* data, size_t size)
+	{
+		Self decoder;
+		return decoder.DecodeImpl<Bytes>(data, size);
+	}
+
+	static Object Decode(const std::vector<uint8_t>& data)
+	{
+		return Decode(data.data(), data.size());
+	}
+
+	/**
+	 * @brief Decode the given RLP encoded data, same as `Decode`, except
+	 *        that byte strings are BytesView referring to the slices of the
+	 *        input, so the input buffer MUST outlive the result
+	 *
+	 */
+	static Object DecodeView(const uint8_t* data, size_t size)
+	{
+		Self decoder;
+		return decoder.DecodeImpl<BytesView>(data, size);
+	}
+
+public:
+
+	RlpDecoder() :
+		m_frames(),
+		m_begin(nullptr)
+	{}
+
+	RlpDecoder(const Self& other) = delete;
+
+	RlpDecoder(Self&& other) = default;
+
+	virtual ~RlpDecoder() = default;
+
+	Self& operator=(const Self& rhs) = delete;
+
+	Self& operator=(Self&& rhs) = default;
+
+private: // helper types and functions
+
+	/**
+	 * @brief A list that is still being decoded
+	 *
+	 */
+	struct Frame
+	{
+		List m_list;
+		const uint8_t* m_end;
+	}; // struct Frame
+
+	[[noreturn]] void ThrowError(const std::string& msg, const uint8_t* pos) const
+	{
+		throw ParseError(msg, static_cast<size_t>(pos - m_begin));
+	}
+
+	static Bytes MakeItem(const uint8_t* p, size_t len, Bytes* /*unused*/)
+	{
+		return Bytes(p, p + len);
+	}
+
+	static BytesView MakeItem(const uint8_t* p, size_t len, BytesView* /*unused*/)
+	{
+		return BytesView(p, len);
+	}
+
+	/**
+	 * @brief Read the length of the payload in long form
+	 *
+	 */
+	size_t ReadLongLen(const uint8_t*& p, const uint8_t* end, size_t lenOfLen)
+	{
+		if (static_cast<size_t>(end - p) < lenOfLen)
+		{
+			ThrowError("Unexpected end of input", end);
+		}
+		if (lenOfLen > sizeof(size_t))
+		{
+			ThrowError("The length is too large", p);
+		}
+		if (p[0] == 0)
+		{
+			ThrowError("The length has leading zeros", p);
+		}
+
+		size_t len = 0;
+		for (size_t i = 0; i < lenOfLen; ++i)
+		{
+			len = (len << 8) | p[i];
+		}
+		if (len <= 55)
+		{
+			ThrowError("The length should be in short form", p);
+		}
+		p += lenOfLen;
+		return len;
+	}
+
+	template<typename _BytesType>
+	Object DecodeImpl(const uint8_t* data, size_t size)
+	{
+		m_frames.clear();
+		m_begin = data;
+
+		const uint8_t* p = data;
+		const uint8_t* end = data + size;
+
+		Object res;
+		bool hasRes = false;
+		while (!hasRes)
+		{
+			// complete all the lists ending at current position
+			while (!m_frames.empty() && p == m_frames.back().m_end)
+			{
+				Object list(std::move(m_frames.back().m_list));
+				m_frames.pop_back();
+				hasRes = AddItem(std::move(list), res);
+			}
+			if (hasRes)
+			{
+				break;
+			}
+
+			const uint8_t* itemEnd =
+				m_frames.empty() ? end : m_frames.back().m_end;
+			if (p >= itemEnd)
+			{
+				ThrowError("Unexpected end of input", itemEnd);
+			}
+
+			const uint8_t* itemBegin = p;
+			uint8_t prefix = *p++;
+			if (prefix < 0x80)
+			{
+				hasRes = AddItem(
+					Object(MakeItem(itemBegin, 1, (_BytesType*)nullptr)), res);
+			}
+			else if (prefix < 0xC0)
+			{
+				size_t len = (prefix <= 0xB7) ?
+					(prefix - 0x80) :
+					ReadLongLen(p, itemEnd, prefix - 0xB7);
+				if (static_cast<size_t>(itemEnd - p) < len)
+				{
+					ThrowError("Unexpected end of input", itemEnd);
+				}
+				if (len == 1 && p[0] < 0x80)
+				{
+					ThrowError("Single byte should be encoded as itself",
+						itemBegin);
+				}
+				hasRes = AddItem(
+					Object(MakeItem(p, len, (_BytesType*)nullptr)), res);
+				p += len;
+			}
+			else
+			{
+				size_t len = (prefix <= 0xF7) ?
+					(prefix - 0xC0) :
+					ReadLongLen(p, itemEnd, prefix - 0xF7);
+				if (static_cast<size_t>(itemEnd - p) < len)
+				{
+					ThrowError("Unexpected end of input", itemEnd);
+				}
+				m_frames.push_back(Frame{ List(), p + len });
+			}
+		}
+
+		if (p != end)
+		{
+			ThrowError("Extra data after the RLP item", p);
+		}
+		return res;
+	}
+
+	/**
+	 * @brief Add the decoded item to the innermost list
+	 *
+	 * @return true if the item is the top level one, which is stored in `res`
+	 */
+	bool AddItem(Object&& item, Object& res)
+	{
+		if (m_frames.empty())
+		{
+			res = std::forward<Object>(item);
+			return true;
+		}
+		m_frames.back().m_list.push_back(std::forward<Object>(item));
+		return false;
+	}
+
+private:
+
+	// deque is used, since List's move constructor is not noexcept,
+	// which would make vector copy the lists on growth
+	std::deque<Frame> m_frames;
+	const uint8_t* m_begin;
+
+}; // class RlpDecoder
+
+} // namespace SimpleObjects
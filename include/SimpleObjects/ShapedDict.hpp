@@ -0,0 +1,757 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "DictBaseObject.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "Internal/DictShape.hpp"
+#include "Internal/make_unique.hpp"
+
+#include "ToString.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A Dict that refers to a shared shape (i.e., Internal::DictShape)
+ *        for its keys, and only stores a dense array of values, in the
+ *        order of the slots of the shape. Thus, Dicts with the same keys,
+ *        such as a list of records from the same schema, share one copy of
+ *        the keys and the index, and a field can be accessed by its slot,
+ *        which is looked up only once for all the Dicts with the same shape.
+ *        Adding a key transitions the Dict to a new shape, and so does
+ *        removing a key, which is more expensive.
+ *        Items are iterated in the order of insertion.
+ *
+ */
+template<
+	typename _KeyType,
+	typename _ValType,
+	typename _ToStringType>
+class ShapedDictImpl :
+	public DictBaseObject<
+		HashableBaseObject<_ToStringType>,
+		BaseObject<_ToStringType>,
+		_ToStringType>
+{
+public: // Static member:
+
+	using ToStringType = _ToStringType;
+	using Self = ShapedDictImpl<_KeyType, _ValType, _ToStringType>;
+	using Base = DictBaseObject<
+		HashableBaseObject<_ToStringType>,
+		BaseObject<_ToStringType>,
+		_ToStringType>;
+	using BaseBase = typename Base::Base;
+
+	static_assert(std::is_same<BaseBase, BaseObject<_ToStringType> >::value,
+		"Expecting Base::Base to be BaseObject class");
+
+	typedef _KeyType                               key_type;
+	typedef _ValType                               mapped_type;
+	typedef std::pair<key_type, mapped_type>       value_type;
+
+	typedef typename Base::key_type                  base_key_type;
+	typedef typename Base::mapped_type               base_mapped_type;
+	typedef typename Base::key_iterator              base_key_iterator;
+	typedef typename Base::mapped_iterator           base_mapped_iterator;
+	typedef typename Base::const_mapped_iterator     base_const_mapped_iterator;
+
+	using Shape = Internal::DictShape<key_type, base_key_type>;
+	using ShapePtr = typename Shape::ShapePtr;
+	using ValContainer = std::vector<mapped_type>;
+
+	using LookupKey = typename Base::LookupKey;
+
+	using _KeyIteratorWrap = CppStdFwIteratorWrap<
+			typename Shape::const_iterator,
+			base_key_type,
+			true,
+			Internal::ItTransformDirect >;
+	using _ValKIteratorWrap = CppStdFwIteratorWrap<
+			typename ValContainer::const_iterator,
+			base_mapped_type,
+			true,
+			Internal::ItTransformDirect >;
+	using _ValIteratorWrap = CppStdFwIteratorWrap<
+			typename ValContainer::iterator,
+			base_mapped_type,
+			false,
+			Internal::ItTransformDirect >;
+
+	static constexpr ObjCategory sk_cat()
+	{
+		return ObjCategory::Dict;
+	}
+
+public:
+
+	ShapedDictImpl() :
+		m_shape(Shape::GetEmpty()),
+		m_vals()
+	{}
+
+	/**
+	 * @brief Construct a Dict with the keys of the given shape, and default
+	 *        values
+	 *
+	 */
+	explicit ShapedDictImpl(ShapePtr shape) :
+		m_shape(std::move(shape)),
+		m_vals(m_shape->size())
+	{}
+
+	ShapedDictImpl(std::initializer_list<value_type> l) :
+		ShapedDictImpl(l.begin(), l.end())
+	{}
+
+	template<typename _ItType>
+	ShapedDictImpl(_ItType begin, _ItType end) :
+		ShapedDictImpl()
+	{
+		for (; begin != end; ++begin)
+		{
+			InsertOnly(begin->first, begin->second);
+		}
+	}
+
+	ShapedDictImpl(const Self& other) :
+		m_shape(other.m_shape),
+		m_vals(other.m_vals)
+	{}
+
+	ShapedDictImpl(Self&& other) :
+		m_shape(other.m_shape),
+		m_vals(std::forward<ValContainer>(other.m_vals))
+	{
+		other.m_shape = Shape::GetEmpty();
+		other.m_vals.clear();
+	}
+
+	virtual ~ShapedDictImpl() = default;
+
+	Self& operator=(const Self& rhs)
+	{
+		if (this != &rhs)
+		{
+			m_vals = rhs.m_vals;
+			m_shape = rhs.m_shape;
+		}
+		return *this;
+	}
+
+	Self& operator=(Self&& rhs)
+	{
+		if (this != &rhs)
+		{
+			m_vals = std::forward<ValContainer>(rhs.m_vals);
+			m_shape = rhs.m_shape;
+			rhs.m_shape = Shape::GetEmpty();
+			rhs.m_vals.clear();
+		}
+		return *this;
+	}
+
+	const ShapePtr& GetShape() const
+	{
+		return m_shape;
+	}
+
+	// ========== operators ==========
+
+	virtual bool operator==(const Self& rhs) const
+	{
+		return DictBaseIsEqual(rhs);
+	}
+#ifndef __cpp_lib_three_way_comparison
+	virtual bool operator!=(const Self& rhs) const
+	{
+		return !DictBaseIsEqual(rhs);
+	}
+#endif
+
+	bool operator<(const Self& rhs) = delete;
+	bool operator>(const Self& rhs) = delete;
+	bool operator<=(const Self& rhs) = delete;
+	bool operator>=(const Self& rhs) = delete;
+
+	// ===== DictBase class
+
+	virtual bool DictBaseIsEqual(const Base& rhs) const override
+	{
+		if (m_vals.size() != rhs.size())
+		{
+			return false;
+		}
+
+		const Self* rhsShaped = dynamic_cast<const Self*>(&rhs);
+		if ((rhsShaped != nullptr) && (rhsShaped->m_shape == m_shape))
+		{
+			// same keys in the same slots
+			return m_vals == rhsShaped->m_vals;
+		}
+
+		auto ye = rhs.ValsCEnd();
+		for (size_t i = 0; i < m_vals.size(); ++i)
+		{
+			auto yj = rhs.FindVal(m_shape->GetKey(i));
+			if (yj == ye || !(m_vals[i] == *yj))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	using Base::operator==;
+#ifdef __cpp_lib_three_way_comparison
+	using Base::operator<=>;
+#else
+	using Base::operator!=;
+	using Base::operator<;
+	using Base::operator>;
+	using Base::operator<=;
+	using Base::operator>=;
+#endif
+
+	// ========== Functions provided by this class ==========
+
+	// ========== slot access ==========
+
+	/**
+	 * @brief Find the slot of the given key in the shape of this Dict; the
+	 *        slot is valid for all the Dicts with the same shape
+	 *
+	 * @return The slot of the key, or `size()` if it's not present
+	 */
+	size_t FindSlot(const base_key_type& key) const
+	{
+		return m_shape->Find(key);
+	}
+
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	size_t FindSlot(const _LookupType& key) const
+	{
+		return FindSlot(static_cast<const base_key_type&>(LookupKey::Make(key)));
+	}
+
+	const key_type& KeyAt(size_t slot) const
+	{
+		if (slot >= m_vals.size())
+		{
+			throw IndexError(slot);
+		}
+		return m_shape->GetKey(slot);
+	}
+
+	mapped_type& ValAt(size_t slot)
+	{
+		if (slot >= m_vals.size())
+		{
+			throw IndexError(slot);
+		}
+		return m_vals[slot];
+	}
+
+	const mapped_type& ValAt(size_t slot) const
+	{
+		if (slot >= m_vals.size())
+		{
+			throw IndexError(slot);
+		}
+		return m_vals[slot];
+	}
+
+	// ========== value access ==========
+
+	mapped_type& operator[](const base_key_type& key)
+	{
+		size_t slot = m_shape->Find(key);
+		if (slot == m_vals.size())
+		{
+			AddSlot(key, mapped_type());
+		}
+		return m_vals[slot];
+	}
+
+	const mapped_type& operator[](const base_key_type& key) const
+	{
+		size_t slot = m_shape->Find(key);
+		if (slot == m_vals.size())
+		{
+			throw KeyError(key.ShortDebugString(), KeyError::sk_keyName);
+		}
+		return m_vals[slot];
+	}
+
+	/**
+	 * @brief Look up a raw string or number; see Internal::DictLookupKey
+	 *
+	 */
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	const mapped_type& operator[](const _LookupType& key) const
+	{
+		return (*this)[static_cast<const base_key_type&>(LookupKey::Make(key))];
+	}
+
+	// ========== item searching ==========
+
+	bool HasKey(const base_key_type& key) const
+	{
+		return m_shape->Find(key) != m_vals.size();
+	}
+
+	template<typename _LookupType,
+		typename = Internal::DictLookupKeyType<_LookupType, _ToStringType> >
+	bool HasKey(const _LookupType& key) const
+	{
+		return HasKey(static_cast<const base_key_type&>(LookupKey::Make(key)));
+	}
+
+	// ========== adding/removing values ==========
+
+	/**
+	 * @return The slot of the key, and whether or not the value is inserted
+	 */
+	std::pair<size_t, bool> InsertOnly(
+		const key_type& key, const mapped_type& other)
+	{
+		size_t slot = m_shape->Find(key);
+		if (slot == m_vals.size())
+		{
+			AddSlot(key, other);
+			return {slot, true};
+		}
+		return {slot, false};
+	}
+
+	std::pair<size_t, bool> InsertOnly(
+		key_type&& key, mapped_type&& other)
+	{
+		size_t slot = m_shape->Find(key);
+		if (slot == m_vals.size())
+		{
+			AddSlot(key, std::forward<mapped_type>(other));
+			return {slot, true};
+		}
+		return {slot, false};
+	}
+
+	std::pair<size_t, bool> InsertOrAssign(
+		const key_type& key, const mapped_type& other)
+	{
+		size_t slot = m_shape->Find(key);
+		if (slot == m_vals.size())
+		{
+			AddSlot(key, other);
+			return {slot, true};
+		}
+		m_vals[slot] = other;
+		return {slot, false};
+	}
+
+	std::pair<size_t, bool> InsertOrAssign(
+		key_type&& key, mapped_type&& other)
+	{
+		size_t slot = m_shape->Find(key);
+		if (slot == m_vals.size())
+		{
+			AddSlot(key, std::forward<mapped_type>(other));
+			return {slot, true};
+		}
+		m_vals[slot] = std::forward<mapped_type>(other);
+		return {slot, false};
+	}
+
+	/**
+	 * @brief Remove the given key, if it's present. The Dict transitions to
+	 *        the shape derived by adding the remaining keys in order,
+	 *        which takes a time linear to the number of keys.
+	 *
+	 */
+	void Remove(const base_key_type& key)
+	{
+		size_t slot = m_shape->Find(key);
+		if (slot == m_vals.size())
+		{
+			return;
+		}
+
+		ShapePtr shape = Shape::GetEmpty();
+		for (size_t i = 0; i < m_vals.size(); ++i)
+		{
+			if (i != slot)
+			{
+				shape = Shape::Add(shape, m_shape->GetKey(i));
+			}
+		}
+		m_vals.erase(m_vals.begin() + slot);
+		m_shape = std::move(shape);
+	}
+
+	// ========== Overrides BaseObject ==========
+
+	virtual ObjCategory GetCategory() const override
+	{
+		return sk_cat();
+	}
+
+	using BaseBase::Set;
+
+	virtual void Set(const BaseBase& other) override
+	{
+		try
+		{
+			const Self& casted = dynamic_cast<const Self&>(other);
+			*this = casted;
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("Dict", this->GetCategoryName());
+		}
+	}
+
+	virtual void Set(BaseBase&& other) override
+	{
+		try
+		{
+			Self&& casted = dynamic_cast<Self&&>(other);
+			*this = std::forward<Self>(casted);
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("Dict", this->GetCategoryName());
+		}
+	}
+
+	virtual bool IsTrue() const override
+	{
+		return m_vals.size() > 0;
+	}
+
+	// ========== Overrides DictBaseObject ==========
+
+	// ========== capacity ==========
+
+	virtual size_t size() const override
+	{
+		return m_vals.size();
+	}
+
+	// ========== iterators ==========
+
+	virtual base_key_iterator KeysBegin() const override
+	{
+		return base_key_iterator::template Make<_KeyIteratorWrap>(
+			m_shape->begin());
+	}
+
+	virtual base_key_iterator KeysEnd() const override
+	{
+		return base_key_iterator::template Make<_KeyIteratorWrap>(
+			m_shape->end());
+	}
+
+	virtual base_const_mapped_iterator ValsCBegin() const override
+	{
+		return base_const_mapped_iterator::template Make<_ValKIteratorWrap>(
+			m_vals.cbegin());
+	}
+
+	virtual base_const_mapped_iterator ValsCEnd() const override
+	{
+		return base_const_mapped_iterator::template Make<_ValKIteratorWrap>(
+			m_vals.cend());
+	}
+
+	virtual base_mapped_iterator ValsBegin() override
+	{
+		return base_mapped_iterator::template Make<_ValIteratorWrap>(
+			m_vals.begin());
+	}
+
+	virtual base_mapped_iterator ValsEnd() override
+	{
+		return base_mapped_iterator::template Make<_ValIteratorWrap>(
+			m_vals.end());
+	}
+
+	// ========== Interface copy/Move ==========
+
+	using Base::Copy;
+	virtual std::unique_ptr<Base> Copy(const Base* /*unused*/) const override
+	{
+		return CopyImpl();
+	}
+
+	using Base::Move;
+	virtual std::unique_ptr<Base> Move(const Base* /*unused*/) override
+	{
+		return MoveImpl();
+	}
+
+	// ========== To string ==========
+
+	virtual std::string DebugString() const override
+	{
+		std::string res;
+		res += '{';
+		res += ' ';
+		for (size_t i = 0; i < m_vals.size(); ++i)
+		{
+			res += m_shape->GetKey(i).DebugString();
+			res += " : ";
+			res += m_vals[i].DebugString();
+			if (i < m_vals.size() - 1)
+			{
+				res += ',';
+				res += ' ';
+			}
+		}
+		res += ' ';
+		res += '}';
+		return res;
+	}
+
+	virtual std::string ShortDebugString() const override
+	{
+		std::string res;
+		res += '{';
+		for (size_t i = 0; i < m_vals.size(); ++i)
+		{
+			res += m_shape->GetKey(i).ShortDebugString();
+			res += ":";
+			res += m_vals[i].ShortDebugString();
+			if (i < m_vals.size() - 1)
+			{
+				res += ',';
+			}
+		}
+		res += '}';
+		return res;
+	}
+
+	virtual ToStringType ToString() const override
+	{
+		auto res = Internal::ToString<ToStringType>("{ ");
+		for (size_t i = 0; i < m_vals.size(); ++i)
+		{
+			res += m_shape->GetKey(i).ToString();
+			res += Internal::ToString<ToStringType>(" : ");
+			res += m_vals[i].ToString();
+			if (i < m_vals.size() - 1)
+			{
+				res += Internal::ToString<ToStringType>(", ");
+			}
+		}
+		res += Internal::ToString<ToStringType>(" }");
+		return res;
+	}
+
+	virtual void DumpString(OutIterator<typename ToStringType::value_type> outIt) const override
+	{
+		*outIt++ = '{';
+		*outIt++ = ' ';
+		for (size_t i = 0; i < m_vals.size(); ++i)
+		{
+			m_shape->GetKey(i).DumpString(outIt);
+			*outIt++ = ' ';
+			*outIt++ = ':';
+			*outIt++ = ' ';
+			m_vals[i].DumpString(outIt);
+			if (i < m_vals.size() - 1)
+			{
+				*outIt++ = ',';
+				*outIt++ = ' ';
+			}
+		}
+		*outIt++ = ' ';
+		*outIt++ = '}';
+	}
+
+protected:
+
+	// ========== Overrides DictBaseObject ==========
+
+	virtual base_const_mapped_iterator DictBaseFindVal(
+		const base_key_type& key) const override
+	{
+		return base_const_mapped_iterator::template Make<_ValKIteratorWrap>(
+			m_vals.cbegin() + m_shape->Find(key));
+	}
+
+	virtual base_mapped_iterator DictBaseFindVal(
+		const base_key_type& key) override
+	{
+		return base_mapped_iterator::template Make<_ValIteratorWrap>(
+			m_vals.begin() + m_shape->Find(key));
+	}
+
+	virtual base_mapped_iterator DictBaseFindValOrAddDefault(
+		const base_key_type& key) override
+	{
+		size_t slot = m_shape->Find(key);
+		if (slot == m_vals.size())
+		{
+			AddSlot(key, mapped_type());
+		}
+		return base_mapped_iterator::template Make<_ValIteratorWrap>(
+			m_vals.begin() + slot);
+	}
+
+	virtual bool DictBaseInsertOnly(
+		const base_key_type& key, const base_mapped_type& val) override
+	{
+		return InsertOnly(DynCastKey(key), DynCastVal(val)).second;
+	}
+
+	virtual bool DictBaseInsertOnly(
+		base_key_type&& key, base_mapped_type&& val) override
+	{
+		return InsertOnly(
+			DynCastKey(std::forward<base_key_type>(key)),
+			DynCastVal(std::forward<base_mapped_type>(val))).second;
+	}
+
+	virtual bool DictBaseInsertOrAssign(
+		const base_key_type& key, const base_mapped_type& val) override
+	{
+		return InsertOrAssign(DynCastKey(key), DynCastVal(val)).second;
+	}
+
+	virtual bool DictBaseInsertOrAssign(
+		base_key_type&& key, base_mapped_type&& val) override
+	{
+		return InsertOrAssign(
+			DynCastKey(std::forward<base_key_type>(key)),
+			DynCastVal(std::forward<base_mapped_type>(val))).second;
+	}
+
+	virtual void DictBaseRemove(const base_key_type& key) override
+	{
+		Remove(key);
+	}
+
+	virtual void DictBaseForEach(
+		const std::function<void(const base_key_type&, base_mapped_type&)>& func
+	) override
+	{
+		for (size_t i = 0; i < m_vals.size(); ++i)
+		{
+			func(m_shape->GetKey(i), m_vals[i]);
+		}
+	}
+
+	virtual void DictBaseForEach(
+		const std::function<
+			void(const base_key_type&, const base_mapped_type&)>& func
+	) const override
+	{
+		for (size_t i = 0; i < m_vals.size(); ++i)
+		{
+			func(m_shape->GetKey(i), m_vals[i]);
+		}
+	}
+
+private:
+
+	static const key_type& DynCastKey(const base_key_type& key)
+	{
+		try
+		{
+			return dynamic_cast<const key_type&>(key);
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("key type of the Dict", key.GetCategoryName());
+		}
+	}
+
+	static key_type&& DynCastKey(base_key_type&& key)
+	{
+		try
+		{
+			return dynamic_cast<key_type&&>(key);
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("key type of the Dict", key.GetCategoryName());
+		}
+	}
+
+	static const mapped_type& DynCastVal(const base_mapped_type& val)
+	{
+		try
+		{
+			return dynamic_cast<const mapped_type&>(val);
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("value type of the Dict", val.GetCategoryName());
+		}
+	}
+
+	static mapped_type&& DynCastVal(base_mapped_type&& val)
+	{
+		try
+		{
+			return dynamic_cast<mapped_type&&>(val);
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("value type of the Dict", val.GetCategoryName());
+		}
+	}
+
+	/**
+	 * @brief Append the value of a key that's not in the current shape, and
+	 *        transition to the shape with that key
+	 *
+	 */
+	template<typename _KType>
+	void AddSlot(const _KType& key, mapped_type val)
+	{
+		ShapePtr shape = Shape::Add(m_shape, key);
+		if (m_vals.size() == m_vals.capacity())
+		{
+			// the values are moved to the new storage explicitly, since
+			// vector would copy them if the move constructor is not noexcept
+			ValContainer vals;
+			vals.reserve((std::max)(m_vals.size() * 2, size_t(4)));
+			std::move(m_vals.begin(), m_vals.end(), std::back_inserter(vals));
+			m_vals.swap(vals);
+		}
+		m_vals.push_back(std::move(val));
+		m_shape = std::move(shape);
+	}
+
+	std::unique_ptr<Self> CopyImpl() const
+	{
+		return Internal::make_unique<Self>(*this);
+	}
+
+	std::unique_ptr<Self> MoveImpl()
+	{
+		return Internal::make_unique<Self>(std::move(*this));
+	}
+
+	ShapePtr m_shape;
+	ValContainer m_vals;
+
+}; // class ShapedDictImpl
+
+} // namespace SimpleObjects
@@ -8,3 +8,7 @@
 #include "BaseObject.hpp"
 
 #include "DefaultTypes.hpp"
+
+#include "JsonParser.hpp"
+#include "JsonWriter.hpp"
+#include "Rlp.hpp"
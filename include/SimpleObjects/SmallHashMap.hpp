@@ -0,0 +1,773 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "FlatHashMap.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief A hash map optimized for a few key-value pairs, which can be used
+ *        as the container type of DictImpl.
+ *
+ *        Up to `_SmallCap` key-value pairs are stored inside the map object,
+ *        together with their hash values, which are kept in their own array;
+ *        a lookup scans the hash values first, and compares the keys only
+ *        when the hash values match. No memory is allocated by the map in
+ *        this state.
+ *        Once the map grows past `_SmallCap`, all pairs are moved into a
+ *        FlatHashMap, which is used from then on, until the map is cleared.
+ *
+ *        Since keys are const, moving this map, or moving the pairs into
+ *        the FlatHashMap, copies the keys stored inside the map object; the
+ *        mapped values are moved.
+ *
+ * @tparam _KeyType      The type of keys
+ * @tparam _ValType      The type of mapped values
+ * @tparam _SmallCap     The max number of pairs stored inside the map object
+ * @tparam _HashType     The hasher of keys
+ * @tparam _KeyEqualType The equality predicate of keys
+ * @tparam _Alloc        The allocator of key-value pairs
+ */
+template<
+	typename _KeyType,
+	typename _ValType,
+	size_t _SmallCap = 8,
+	typename _HashType = std::hash<_KeyType>,
+	typename _KeyEqualType = std::equal_to<_KeyType>,
+	typename _Alloc = std::allocator<std::pair<const _KeyType, _ValType> > >
+class SmallHashMap
+{
+public: // static members
+
+	using Self = SmallHashMap<
+		_KeyType, _ValType, _SmallCap, _HashType, _KeyEqualType, _Alloc>;
+	using LargeMapType = FlatHashMap<
+		_KeyType, _ValType, _HashType, _KeyEqualType, _Alloc>;
+
+	static_assert(_SmallCap > 0 && _SmallCap <= 32,
+		"The small capacity must be in the range of [1, 32]");
+
+	typedef _KeyType                                key_type;
+	typedef _ValType                                mapped_type;
+	typedef std::pair<const _KeyType, _ValType>     value_type;
+	typedef size_t                                  size_type;
+	typedef std::ptrdiff_t                          difference_type;
+	typedef _HashType                               hasher;
+	typedef _KeyEqualType                           key_equal;
+	typedef _Alloc                                  allocator_type;
+	typedef value_type&                             reference;
+	typedef const value_type&                       const_reference;
+	typedef value_type*                             pointer;
+	typedef const value_type*                       const_pointer;
+
+	template<bool _IsConst>
+	class IteratorImpl;
+
+	typedef IteratorImpl<false>                     iterator;
+	typedef IteratorImpl<true>                      const_iterator;
+
+	static constexpr size_t sk_smallCap = _SmallCap;
+
+	/**
+	 * @brief The iterator walks the pairs stored inside the map object, or
+	 *        the ones in the FlatHashMap, depending on the state of the map
+	 *
+	 */
+	template<bool _IsConst>
+	class IteratorImpl
+	{
+	public: // static members
+
+		template<bool>
+		friend class IteratorImpl;
+
+		using MapPtrType =
+			typename std::conditional<_IsConst, const Self*, Self*>::type;
+		using LargeItType = typename std::conditional<_IsConst,
+			typename LargeMapType::const_iterator,
+			typename LargeMapType::iterator>::type;
+
+		typedef std::forward_iterator_tag           iterator_category;
+		typedef std::pair<const _KeyType, _ValType> value_type;
+		typedef std::ptrdiff_t                      difference_type;
+		typedef typename std::conditional<_IsConst,
+			const value_type*, value_type*>::type   pointer;
+		typedef typename std::conditional<_IsConst,
+			const value_type&, value_type&>::type   reference;
+
+	public:
+
+		IteratorImpl() :
+			m_map(nullptr),
+			m_idx(0),
+			m_largeIt()
+		{}
+
+		IteratorImpl(MapPtrType map, size_t idx, LargeItType largeIt) :
+			m_map(map),
+			m_idx(idx),
+			m_largeIt(largeIt)
+		{}
+
+		template<bool _OtherIsConst,
+			typename std::enable_if<
+				_IsConst && !_OtherIsConst, int>::type = 0>
+		IteratorImpl(const IteratorImpl<_OtherIsConst>& other) :
+			m_map(other.m_map),
+			m_idx(other.m_idx),
+			m_largeIt(other.m_largeIt)
+		{}
+
+		reference operator*() const
+		{
+			return m_map->m_isLarge ?
+				*m_largeIt :
+				m_map->SmallValue(m_idx);
+		}
+
+		pointer operator->() const
+		{
+			return &(**this);
+		}
+
+		IteratorImpl& operator++()
+		{
+			if (m_map->m_isLarge)
+			{
+				++m_largeIt;
+			}
+			else
+			{
+				m_idx = m_map->NextSmall(m_idx + 1);
+			}
+			return *this;
+		}
+
+		IteratorImpl operator++(int)
+		{
+			IteratorImpl tmp(*this);
+			++(*this);
+			return tmp;
+		}
+
+		bool operator==(const IteratorImpl& rhs) const
+		{
+			return (m_map == rhs.m_map) &&
+				(m_idx == rhs.m_idx) &&
+				(m_largeIt == rhs.m_largeIt);
+		}
+
+		bool operator!=(const IteratorImpl& rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+		size_t GetIdx() const
+		{
+			return m_idx;
+		}
+
+		const LargeItType& GetLargeIt() const
+		{
+			return m_largeIt;
+		}
+
+	private:
+
+		MapPtrType m_map;
+		size_t m_idx;
+		LargeItType m_largeIt;
+
+	}; // class IteratorImpl
+
+public:
+
+	SmallHashMap() :
+		SmallHashMap(allocator_type())
+	{}
+
+	explicit SmallHashMap(const allocator_type& alloc) :
+		m_large(alloc),
+		m_aliveMask(0),
+		m_isLarge(false)
+	{}
+
+	SmallHashMap(
+		std::initializer_list<value_type> l,
+		const allocator_type& alloc = allocator_type()) :
+		SmallHashMap(alloc)
+	{
+		for (const auto& item : l)
+		{
+			insert(item);
+		}
+	}
+
+	SmallHashMap(const Self& other) :
+		m_large(other.m_large),
+		m_aliveMask(0),
+		m_isLarge(other.m_isLarge)
+	{
+		CopySmall(other);
+	}
+
+	SmallHashMap(Self&& other) :
+		m_large(std::move(other.m_large)),
+		m_aliveMask(0),
+		m_isLarge(other.m_isLarge)
+	{
+		MoveSmall(other);
+		other.m_isLarge = false;
+	}
+
+	~SmallHashMap()
+	{
+		DestroySmall();
+	}
+
+	Self& operator=(const Self& rhs)
+	{
+		if (this != &rhs)
+		{
+			DestroySmall();
+			m_large = rhs.m_large;
+			m_isLarge = rhs.m_isLarge;
+			CopySmall(rhs);
+		}
+		return *this;
+	}
+
+	Self& operator=(Self&& rhs)
+	{
+		if (this != &rhs)
+		{
+			DestroySmall();
+			m_large = std::move(rhs.m_large);
+			m_isLarge = rhs.m_isLarge;
+			MoveSmall(rhs);
+			rhs.m_isLarge = false;
+		}
+		return *this;
+	}
+
+	allocator_type get_allocator() const
+	{
+		return m_large.get_allocator();
+	}
+
+	// ========== capacity ==========
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	size_t size() const
+	{
+		return m_isLarge ? m_large.size() : PopCount(m_aliveMask);
+	}
+
+	/**
+	 * @brief Make room for `n` key-value pairs; the pairs are moved into the
+	 *        FlatHashMap right away if `n` is larger than `_SmallCap`
+	 *
+	 */
+	void reserve(size_t n)
+	{
+		if (n > _SmallCap)
+		{
+			Promote();
+			m_large.reserve(n);
+		}
+	}
+
+	// ========== iterators ==========
+
+	iterator begin()
+	{
+		return m_isLarge ?
+			iterator(this, 0, m_large.begin()) :
+			iterator(this, NextSmall(0), typename LargeMapType::iterator());
+	}
+
+	iterator end()
+	{
+		return m_isLarge ?
+			iterator(this, 0, m_large.end()) :
+			iterator(this, _SmallCap, typename LargeMapType::iterator());
+	}
+
+	const_iterator begin() const
+	{
+		return cbegin();
+	}
+
+	const_iterator end() const
+	{
+		return cend();
+	}
+
+	const_iterator cbegin() const
+	{
+		return m_isLarge ?
+			const_iterator(this, 0, m_large.cbegin()) :
+			const_iterator(
+				this, NextSmall(0), typename LargeMapType::const_iterator());
+	}
+
+	const_iterator cend() const
+	{
+		return m_isLarge ?
+			const_iterator(this, 0, m_large.cend()) :
+			const_iterator(
+				this, _SmallCap, typename LargeMapType::const_iterator());
+	}
+
+	// ========== lookup ==========
+
+	iterator find(const key_type& key)
+	{
+		if (m_isLarge)
+		{
+			return iterator(this, 0, m_large.find(key));
+		}
+		const size_t idx = FindSmall(key, m_large.hash_function()(key));
+		return idx == sk_npos ?
+			end() :
+			iterator(this, idx, typename LargeMapType::iterator());
+	}
+
+	const_iterator find(const key_type& key) const
+	{
+		if (m_isLarge)
+		{
+			return const_iterator(this, 0, m_large.find(key));
+		}
+		const size_t idx = FindSmall(key, m_large.hash_function()(key));
+		return idx == sk_npos ?
+			cend() :
+			const_iterator(this, idx, typename LargeMapType::const_iterator());
+	}
+
+	size_t count(const key_type& key) const
+	{
+		return find(key) == cend() ? 0 : 1;
+	}
+
+	mapped_type& at(const key_type& key)
+	{
+		auto it = find(key);
+		if (it == end())
+		{
+			throw std::out_of_range("SmallHashMap::at - key not found");
+		}
+		return it->second;
+	}
+
+	const mapped_type& at(const key_type& key) const
+	{
+		auto it = find(key);
+		if (it == cend())
+		{
+			throw std::out_of_range("SmallHashMap::at - key not found");
+		}
+		return it->second;
+	}
+
+	mapped_type& operator[](const key_type& key)
+	{
+		return EmplaceImpl(key).first->second;
+	}
+
+	mapped_type& operator[](key_type&& key)
+	{
+		return EmplaceImpl(std::forward<key_type>(key)).first->second;
+	}
+
+	// ========== modifiers ==========
+
+	/**
+	 * @brief Insert a key-value pair, with the mapped value constructed from
+	 *        `args`, if the key is not in the map yet; same as
+	 *        `FlatHashMap::emplace`
+	 *
+	 */
+	template<typename... _Args>
+	std::pair<iterator, bool> emplace(const key_type& key, _Args&&... args)
+	{
+		return EmplaceImpl(key, std::forward<_Args>(args)...);
+	}
+
+	template<typename... _Args>
+	std::pair<iterator, bool> emplace(key_type&& key, _Args&&... args)
+	{
+		return EmplaceImpl(
+			std::forward<key_type>(key), std::forward<_Args>(args)...);
+	}
+
+	/**
+	 * @brief Same as `emplace`; the hint is ignored
+	 *
+	 */
+	template<typename _KArgType, typename... _Args>
+	iterator emplace_hint(const_iterator, _KArgType&& key, _Args&&... args)
+	{
+		return EmplaceImpl(
+			std::forward<_KArgType>(key),
+			std::forward<_Args>(args)...).first;
+	}
+
+	std::pair<iterator, bool> insert(const value_type& val)
+	{
+		return EmplaceImpl(val.first, val.second);
+	}
+
+	template<typename _PairType>
+	std::pair<iterator, bool> insert(_PairType&& val)
+	{
+		return EmplaceImpl(
+			std::forward<_PairType>(val).first,
+			std::forward<_PairType>(val).second);
+	}
+
+	size_t erase(const key_type& key)
+	{
+		if (m_isLarge)
+		{
+			return m_large.erase(key);
+		}
+		const size_t idx = FindSmall(key, m_large.hash_function()(key));
+		if (idx == sk_npos)
+		{
+			return 0;
+		}
+		EraseSmall(idx);
+		return 1;
+	}
+
+	iterator erase(const_iterator it)
+	{
+		if (m_isLarge)
+		{
+			return iterator(this, 0, m_large.erase(it.GetLargeIt()));
+		}
+		EraseSmall(it.GetIdx());
+		return iterator(
+			this, NextSmall(it.GetIdx() + 1), typename LargeMapType::iterator());
+	}
+
+	iterator erase(iterator it)
+	{
+		return erase(const_iterator(it));
+	}
+
+	/**
+	 * @brief Remove all key-value pairs; the map goes back to store pairs
+	 *        inside the map object
+	 *
+	 */
+	void clear()
+	{
+		DestroySmall();
+		LargeMapType(m_large.get_allocator()).swap(m_large);
+		m_isLarge = false;
+	}
+
+	void swap(Self& other)
+	{
+		Self tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+	// ========== operators ==========
+
+	/**
+	 * @brief Two maps are equal if they have the same set of keys, and the
+	 *        same value for each key, regardless of the order
+	 *
+	 */
+	bool operator==(const Self& rhs) const
+	{
+		if (size() != rhs.size())
+		{
+			return false;
+		}
+		for (const auto& item : *this)
+		{
+			auto it = rhs.find(item.first);
+			if ((it == rhs.cend()) || !(it->second == item.second))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool operator!=(const Self& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+private: // static members
+
+	using AllocTraits = std::allocator_traits<allocator_type>;
+
+	static constexpr size_t sk_npos = (std::numeric_limits<size_t>::max)();
+
+	struct Storage
+	{
+		alignas(value_type) unsigned char m_val[sizeof(value_type)];
+	}; // struct Storage
+
+	static size_t PopCount(uint32_t mask)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<size_t>(__builtin_popcount(mask));
+#else
+		size_t res = 0;
+		for (; mask != 0; mask &= mask - 1)
+		{
+			++res;
+		}
+		return res;
+#endif
+	}
+
+private:
+
+	bool IsAlive(size_t idx) const
+	{
+		return ((m_aliveMask >> idx) & 1U) != 0;
+	}
+
+	value_type* SmallPtr(size_t idx)
+	{
+		return reinterpret_cast<value_type*>(m_small[idx].m_val);
+	}
+
+	value_type& SmallValue(size_t idx)
+	{
+		return *SmallPtr(idx);
+	}
+
+	const value_type& SmallValue(size_t idx) const
+	{
+		return *reinterpret_cast<const value_type*>(m_small[idx].m_val);
+	}
+
+	size_t NextSmall(size_t idx) const
+	{
+		while ((idx < _SmallCap) && !IsAlive(idx))
+		{
+			++idx;
+		}
+		return idx;
+	}
+
+	size_t FindSmall(const key_type& key, size_t hashVal) const
+	{
+		for (size_t i = 0; i < _SmallCap; ++i)
+		{
+			if (IsAlive(i) &&
+				(m_hashes[i] == hashVal) &&
+				m_large.key_eq()(SmallValue(i).first, key))
+			{
+				return i;
+			}
+		}
+		return sk_npos;
+	}
+
+	template<typename _KArgType, typename... _Args>
+	std::pair<iterator, bool> EmplaceImpl(_KArgType&& key, _Args&&... args)
+	{
+		if (!m_isLarge)
+		{
+			const size_t hashVal = m_large.hash_function()(key);
+			const size_t found = FindSmall(key, hashVal);
+			if (found != sk_npos)
+			{
+				return std::make_pair(
+					iterator(this, found, typename LargeMapType::iterator()),
+					false);
+			}
+
+			if (m_aliveMask != FullMask())
+			{
+				size_t idx = 0;
+				while (IsAlive(idx))
+				{
+					++idx;
+				}
+				allocator_type alloc = m_large.get_allocator();
+				AllocTraits::construct(alloc, SmallPtr(idx),
+					std::piecewise_construct,
+					std::forward_as_tuple(std::forward<_KArgType>(key)),
+					std::forward_as_tuple(std::forward<_Args>(args)...));
+				m_hashes[idx] = hashVal;
+				m_aliveMask |= (1U << idx);
+				return std::make_pair(
+					iterator(this, idx, typename LargeMapType::iterator()),
+					true);
+			}
+
+			Promote();
+		}
+
+		auto res = m_large.emplace(
+			std::forward<_KArgType>(key), std::forward<_Args>(args)...);
+		return std::make_pair(iterator(this, 0, res.first), res.second);
+	}
+
+	void EraseSmall(size_t idx)
+	{
+		allocator_type alloc = m_large.get_allocator();
+		AllocTraits::destroy(alloc, SmallPtr(idx));
+		m_aliveMask &= ~(1U << idx);
+	}
+
+	static constexpr uint32_t FullMask()
+	{
+		return _SmallCap == 32 ?
+			(std::numeric_limits<uint32_t>::max)() :
+			static_cast<uint32_t>((1ULL << _SmallCap) - 1);
+	}
+
+	/**
+	 * @brief Move all pairs stored inside the map object into the
+	 *        FlatHashMap; if that fails, the mapped values moved so far are
+	 *        moved back
+	 *
+	 */
+	void Promote()
+	{
+		if (m_isLarge)
+		{
+			return;
+		}
+
+		m_large.reserve(_SmallCap + 1);
+		size_t i = 0;
+		try
+		{
+			for (; i < _SmallCap; ++i)
+			{
+				if (IsAlive(i))
+				{
+					value_type& item = SmallValue(i);
+					m_large.emplace(item.first, std::move(item.second));
+				}
+			}
+		}
+		catch(...)
+		{
+			for (size_t j = 0; j < i; ++j)
+			{
+				if (IsAlive(j))
+				{
+					value_type& item = SmallValue(j);
+					item.second = std::move(m_large.at(item.first));
+				}
+			}
+			m_large.clear();
+			throw;
+		}
+
+		DestroySmall();
+		m_isLarge = true;
+	}
+
+	void CopySmall(const Self& other)
+	{
+		allocator_type alloc = m_large.get_allocator();
+		for (size_t i = 0; i < _SmallCap; ++i)
+		{
+			if (other.IsAlive(i))
+			{
+				try
+				{
+					AllocTraits::construct(
+						alloc, SmallPtr(i), other.SmallValue(i));
+				}
+				catch(...)
+				{
+					DestroySmall();
+					throw;
+				}
+				m_hashes[i] = other.m_hashes[i];
+				m_aliveMask |= (1U << i);
+			}
+		}
+	}
+
+	void MoveSmall(Self& other)
+	{
+		allocator_type alloc = m_large.get_allocator();
+		for (size_t i = 0; i < _SmallCap; ++i)
+		{
+			if (other.IsAlive(i))
+			{
+				AllocTraits::construct(
+					alloc, SmallPtr(i), std::move(other.SmallValue(i)));
+				m_hashes[i] = other.m_hashes[i];
+				m_aliveMask |= (1U << i);
+			}
+		}
+		other.DestroySmall();
+	}
+
+	void DestroySmall()
+	{
+		allocator_type alloc = m_large.get_allocator();
+		for (size_t i = 0; i < _SmallCap; ++i)
+		{
+			if (IsAlive(i))
+			{
+				AllocTraits::destroy(alloc, SmallPtr(i));
+			}
+		}
+		m_aliveMask = 0;
+	}
+
+	LargeMapType m_large;
+	uint32_t m_aliveMask;
+	bool m_isLarge;
+	size_t m_hashes[_SmallCap];
+	Storage m_small[_SmallCap];
+
+}; // class SmallHashMap
+
+template<typename _KeyType, typename _ValType, size_t _SmallCap,
+	typename _HashType, typename _KeyEqualType, typename _Alloc>
+constexpr size_t SmallHashMap<_KeyType, _ValType, _SmallCap,
+	_HashType, _KeyEqualType, _Alloc>::sk_smallCap;
+
+template<typename _KeyType, typename _ValType, size_t _SmallCap,
+	typename _HashType, typename _KeyEqualType, typename _Alloc>
+constexpr size_t SmallHashMap<_KeyType, _ValType, _SmallCap,
+	_HashType, _KeyEqualType, _Alloc>::sk_npos;
+
+} // namespace SimpleObjects
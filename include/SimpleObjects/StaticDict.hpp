@@ -548,6 +548,14 @@ public:
 			return false;
 		}
 
+		const Self* rhsSame = dynamic_cast<const Self*>(&rhs);
+		if (rhsSame != nullptr)
+		{
+			// same concrete type, so the keys are the same, and the values
+			// are compared directly, instead of through the iterators
+			return m_data == rhsSame->m_data;
+		}
+
 		auto ita = m_krefArray.cbegin();
 		auto itb = rhs.cbegin();
 		auto itae = m_krefArray.cend();
@@ -8,11 +8,16 @@
 #include "StringBaseObject.hpp"
 
 #include <algorithm>
+#include <functional>
+#include <string>
 
 #include "Compare.hpp"
 #include "ToString.hpp"
 #include "Utils.hpp"
 
+#include "Internal/HashCache.hpp"
+#include "Internal/HashPolicy.hpp"
+
 #ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 namespace SimpleObjects
 #else
@@ -20,6 +25,38 @@ namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
 #endif
 {
 
+namespace Internal
+{
+
+/**
+ * @brief Hash the content of a string container.
+ *        Strings using allocators other than the standard one are hashed in
+ *        the same way as the standard strings, so that equal strings always
+ *        have the same hash value, regardless of their allocators.
+ *
+ * @tparam _CtnType    The type of the string container
+ * @tparam _PolicyType The hash policy used to hash the characters
+ */
+template<typename _CtnType, typename _PolicyType = DefaultHashPolicy>
+struct StrContainerHash
+{
+	using CharType = typename _CtnType::value_type;
+	using TraitsType = typename _CtnType::traits_type;
+
+	template<typename _OtherStrType>
+	static size_t Hash(const _OtherStrType& str)
+	{
+		return Hash(str.data(), str.size());
+	}
+
+	static size_t Hash(const CharType* str, size_t len)
+	{
+		return _PolicyType::template HashStr<CharType, TraitsType>(str, len);
+	}
+}; // struct StrContainerHash
+
+} // namespace Internal
+
 template<typename _CtnType, typename _ToStringType>
 class StringImpl :
 	public StringBaseObject<
@@ -54,6 +91,8 @@ public: // Static member:
 	typedef typename Base::const_iterator                const_iterator;
 	typedef typename Base::iterator                      reverse_iterator;
 	typedef typename Base::const_iterator                const_reverse_iterator;
+	typedef typename ContainerType::iterator             native_iterator;
+	typedef typename ContainerType::const_iterator       const_native_iterator;
 
 	static constexpr size_type npos = ContainerType::npos;
 
@@ -71,28 +110,46 @@ public: // Static member:
 public:
 
 	StringImpl() :
-		m_data()
+		m_data(),
+		m_hashCache()
 	{}
 
 	StringImpl(const ContainerType& str):
-		m_data(str)
+		m_data(str),
+		m_hashCache()
 	{}
 
 	StringImpl(ContainerType&& str):
-		m_data(std::forward<ContainerType>(str))
+		m_data(std::forward<ContainerType>(str)),
+		m_hashCache()
 	{}
 
 	StringImpl(const_pointer str) :
-		m_data(str)
+		m_data(str),
+		m_hashCache()
+	{}
+
+	explicit StringImpl(const allocator_type& alloc) :
+		m_data(alloc),
+		m_hashCache()
+	{}
+
+	StringImpl(const_pointer str, const allocator_type& alloc) :
+		m_data(str, alloc),
+		m_hashCache()
 	{}
 
 	StringImpl(const Self& other) :
-		m_data(other.m_data)
+		m_data(other.m_data),
+		m_hashCache(other.m_hashCache)
 	{}
 
 	StringImpl(Self&& other) :
-		m_data(std::forward<ContainerType>(other.m_data))
-	{}
+		m_data(std::forward<ContainerType>(other.m_data)),
+		m_hashCache(other.m_hashCache)
+	{
+		other.m_hashCache.Reset();
+	}
 
 	virtual ~StringImpl() = default;
 
@@ -101,6 +158,7 @@ public:
 		if (this != &rhs)
 		{
 			m_data = rhs.m_data;
+			m_hashCache = rhs.m_hashCache;
 		}
 		return *this;
 	}
@@ -110,6 +168,8 @@ public:
 		if (this != &rhs)
 		{
 			m_data = std::forward<ContainerType>(rhs.m_data);
+			m_hashCache = rhs.m_hashCache;
+			rhs.m_hashCache.Reset();
 		}
 		return *this;
 	}
@@ -199,6 +259,7 @@ public:
 
 	virtual void resize(size_t len) override
 	{
+		m_hashCache.Reset();
 		m_data.resize(len);
 	}
 
@@ -211,6 +272,7 @@ public:
 
 	virtual reference operator[](size_t idx) override
 	{
+		m_hashCache.Reset();
 		try
 		{
 			return m_data.at(idx);
@@ -247,20 +309,29 @@ public:
 
 	virtual void push_back(const value_type& ch) override
 	{
+		m_hashCache.Reset();
 		m_data.push_back(ch);
 	}
 
 	virtual void pop_back() override
 	{
+		m_hashCache.Reset();
 		m_data.pop_back();
 	}
 
 	using Base::Append;
 	virtual void Append(const_iterator begin, const_iterator end) override
 	{
+		m_hashCache.Reset();
 		std::copy(begin, end, std::back_inserter(m_data));
 	}
 
+	virtual void Append(const_pointer begin, const_pointer end) override
+	{
+		m_hashCache.Reset();
+		m_data.append(begin, static_cast<size_t>(end - begin));
+	}
+
 	// ========== item searching ==========
 
 	using Base::StartsWith;
@@ -301,11 +372,13 @@ public:
 
 	virtual iterator begin() override
 	{
+		m_hashCache.Reset();
 		return ToRdIt<false>(m_data.begin());
 	}
 
 	virtual iterator end() override
 	{
+		m_hashCache.Reset();
 		return ToRdIt<false>(m_data.end());
 	}
 
@@ -321,11 +394,13 @@ public:
 
 	virtual reverse_iterator rbegin() override
 	{
+		m_hashCache.Reset();
 		return ToRdIt<false>(m_data.rbegin());
 	}
 
 	virtual reverse_iterator rend() override
 	{
+		m_hashCache.Reset();
 		return ToRdIt<false>(m_data.rend());
 	}
 
@@ -339,11 +414,43 @@ public:
 		return ToRdIt<true>(m_data.crend());
 	}
 
+	// ========== native iterators ==========
+
+	// The iterators of the underlying container, which, unlike the
+	// type-erased ones above, don't allocate, and can be inlined and
+	// vectorized by the std algorithms. They are invalidated by the same
+	// operations as the ones of `ContainerType`.
+	// Getting the non-const ones drops the cached hash, as `begin()` does.
+
+	native_iterator NativeBegin()
+	{
+		m_hashCache.Reset();
+		return m_data.begin();
+	}
+
+	native_iterator NativeEnd()
+	{
+		m_hashCache.Reset();
+		return m_data.end();
+	}
+
+	const_native_iterator NativeBegin() const
+	{
+		return m_data.cbegin();
+	}
+
+	const_native_iterator NativeEnd() const
+	{
+		return m_data.cend();
+	}
+
 	// ========== Overrides HashableBaseObject ==========
 
 	virtual std::size_t Hash() const override
 	{
-		return std::hash<ContainerType>()(m_data);
+		return m_hashCache.Get([this]() {
+			return Internal::StrContainerHash<ContainerType>::Hash(m_data);
+		});
 	}
 
 	// ========== Overrides BaseObject ==========
@@ -441,6 +548,7 @@ private:
 	}
 
 	ContainerType m_data;
+	Internal::HashCache m_hashCache;
 
 }; // class StringImpl
 
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "HashableBaseObject.hpp"
 
 #include "Iterator.hpp"
@@ -95,6 +97,18 @@ public:
 	virtual int StringBaseCompare(size_t pos1, size_t count1,
 		const_pointer begin, const_pointer end) const = 0;
 
+	/**
+	 * @brief Get the identity of the interned string that this object
+	 *        refers to; two interned strings are equal if and only if
+	 *        their identities are the same
+	 *
+	 * @return the identity, or nullptr if this string is not interned
+	 */
+	virtual const void* GetInternedId() const
+	{
+		return nullptr;
+	}
+
 	bool operator==(const Self& rhs) const
 	{
 		return StringBaseEqual(
@@ -222,9 +236,24 @@ public:
 	virtual void Append(const_iterator begin,
 		const_iterator end) = 0;
 
+	/**
+	 * @brief Append the characters in a contiguous range;
+	 *        the concrete classes copy them in bulk, instead of one at a time
+	 *        through the type-erased iterators.
+	 *        The range may be part of this string.
+	 *
+	 * @param begin the begin of the range
+	 * @param end   the end of the range
+	 */
+	virtual void Append(const_pointer begin, const_pointer end)
+	{
+		return this->Append(ToRdIt<true>(begin), ToRdIt<true>(end));
+	}
+
 	virtual void Append(const Self& other)
 	{
-		return this->Append(other.cbegin(), other.cend());
+		const_pointer otherData = other.data();
+		return this->Append(otherData, otherData + other.size());
 	}
 
 	virtual Self& operator+=(const Self& rhs)
@@ -238,37 +267,77 @@ public:
 	virtual bool StartsWith(const_iterator begin,
 		const_iterator end) const = 0;
 
+	/**
+	 * @brief Check if this string starts with the characters in a contiguous
+	 *        range, which are compared in bulk
+	 *
+	 * @param begin the begin of the range
+	 * @param end   the end of the range
+	 */
+	virtual bool StartsWith(const_pointer begin, const_pointer end) const
+	{
+		const size_t len = static_cast<size_t>(end - begin);
+		return (this->size() >= len) &&
+			std::equal(begin, end, this->data());
+	}
+
 	virtual bool StartsWith(const Self& other) const
 	{
-		if (this->size() < other.size())
-		{
-			return false;
-		}
-		return this->StartsWith(other.cbegin(), other.end());
+		const_pointer otherData = other.data();
+		return this->StartsWith(otherData, otherData + other.size());
 	}
 
 	virtual bool EndsWith(
 		const_iterator begin, const_iterator end) const = 0;
 
+	/**
+	 * @brief Check if this string ends with the characters in a contiguous
+	 *        range, which are compared in bulk
+	 *
+	 * @param begin the begin of the range
+	 * @param end   the end of the range
+	 */
+	virtual bool EndsWith(const_pointer begin, const_pointer end) const
+	{
+		const size_t len = static_cast<size_t>(end - begin);
+		return (this->size() >= len) &&
+			std::equal(begin, end, this->data() + (this->size() - len));
+	}
+
 	virtual bool EndsWith(const Self& other) const
 	{
-		if (this->size() < other.size())
-		{
-			return false;
-		}
-		return this->EndsWith(other.cbegin(), other.end());
+		const_pointer otherData = other.data();
+		return this->EndsWith(otherData, otherData + other.size());
 	}
 
 	virtual const_iterator Contains(
 		const_iterator begin, const_iterator end) const = 0;
 
-	virtual const_iterator Contains(const Self& other) const
+	/**
+	 * @brief Find the first occurrence of the characters in a contiguous
+	 *        range, which is searched directly in the data of this string
+	 *
+	 * @param begin the begin of the range
+	 * @param end   the end of the range
+	 * @return the position of the first occurrence, or `cend()` if not found
+	 */
+	virtual const_iterator Contains(
+		const_pointer begin, const_pointer end) const
 	{
-		if (this->size() < other.size())
+		const_pointer thisData = this->data();
+		const_pointer thisEnd = thisData + this->size();
+		const_pointer res = std::search(thisData, thisEnd, begin, end);
+		if (res == thisEnd)
 		{
-			return cend();
+			return this->cend();
 		}
-		return this->Contains(other.cbegin(), other.end());
+		return this->cbegin() + (res - thisData);
+	}
+
+	virtual const_iterator Contains(const Self& other) const
+	{
+		const_pointer otherData = other.data();
+		return this->Contains(otherData, otherData + other.size());
 	}
 
 	// ========== iterators ==========
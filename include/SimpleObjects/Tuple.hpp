@@ -0,0 +1,532 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "TupleBaseObject.hpp"
+
+#include <memory>
+
+#include "ToString.hpp"
+
+#include "Internal/HashCache.hpp"
+#include "Internal/hash.hpp"
+#include "Internal/make_unique.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief An immutable sequence of hashable objects.
+ *        The hash value is combined from the hash values of the items, in
+ *        order, and it's computed only once, since the items can't be
+ *        modified after construction.
+ *
+ */
+template<typename _CtnType, typename _ToStringType>
+class TupleImpl :
+	public TupleBaseObject<
+		HashableBaseObject<_ToStringType>,
+		_ToStringType>
+{
+public: // Static member:
+
+	using ContainerType = _CtnType;
+	using ToStringType  = _ToStringType;
+	using Self = TupleImpl<_CtnType, _ToStringType>;
+	using Base = TupleBaseObject<HashableBaseObject<_ToStringType>, _ToStringType>;
+	using BaseBase = typename Base::Base;
+	using BaseBaseBase = typename BaseBase::Base;
+
+	static_assert(std::is_same<BaseBase, HashableBaseObject<_ToStringType> >::value,
+		"Expecting Base::Base to be HashableBaseObject class");
+	static_assert(std::is_same<BaseBaseBase, BaseObject<_ToStringType> >::value,
+		"Expecting Base::Base::Base to be BaseObject class");
+
+	typedef typename ContainerType::allocator_type       allocator_type;
+	typedef typename ContainerType::value_type           value_type;
+	typedef typename ContainerType::size_type            size_type;
+	typedef typename ContainerType::difference_type      difference_type;
+	typedef typename ContainerType::const_reference      const_reference;
+	typedef typename ContainerType::const_pointer        const_pointer;
+	typedef RdIterator<value_type, true>                 const_iterator;
+	typedef RdIterator<value_type, true>                 const_reverse_iterator;
+
+	typedef BaseBase                                     base_value_type;
+	typedef const BaseBase&                              base_const_reference;
+	typedef RdIterator<base_value_type, true>            base_const_iterator;
+
+	static constexpr ObjCategory sk_cat()
+	{
+		return ObjCategory::Tuple;
+	}
+
+public:
+
+	TupleImpl() :
+		m_data(),
+		m_hashCache()
+	{}
+
+	explicit TupleImpl(const allocator_type& alloc) :
+		m_data(alloc),
+		m_hashCache()
+	{}
+
+	TupleImpl(std::initializer_list<value_type> l) :
+		m_data(l),
+		m_hashCache()
+	{}
+
+	explicit TupleImpl(const ContainerType& data) :
+		m_data(data),
+		m_hashCache()
+	{}
+
+	explicit TupleImpl(ContainerType&& data) :
+		m_data(std::forward<ContainerType>(data)),
+		m_hashCache()
+	{}
+
+	template<typename _ItType>
+	TupleImpl(_ItType begin, _ItType end) :
+		m_data(begin, end),
+		m_hashCache()
+	{}
+
+	TupleImpl(const Self& other) :
+		m_data(other.m_data),
+		m_hashCache(other.m_hashCache)
+	{}
+
+	TupleImpl(Self&& other) :
+		m_data(std::forward<ContainerType>(other.m_data)),
+		m_hashCache(other.m_hashCache)
+	{
+		other.m_hashCache.Reset();
+	}
+
+	virtual ~TupleImpl() = default;
+
+	Self& operator=(const Self& rhs)
+	{
+		if (this != &rhs)
+		{
+			m_data = rhs.m_data;
+			m_hashCache = rhs.m_hashCache;
+		}
+		return *this;
+	}
+
+	Self& operator=(Self&& rhs)
+	{
+		if (this != &rhs)
+		{
+			m_data = std::forward<ContainerType>(rhs.m_data);
+			m_hashCache = rhs.m_hashCache;
+			rhs.m_hashCache.Reset();
+		}
+		return *this;
+	}
+
+	const ContainerType& GetVal() const
+	{
+		return m_data;
+	}
+
+	// ========== operators ==========
+
+	// ===== This class
+
+	bool operator==(const Self& rhs) const
+	{
+		return m_data == rhs.m_data;
+	}
+
+#ifdef __cpp_lib_three_way_comparison
+	auto operator<=>(const Self& rhs) const
+	{
+		return m_data <=> rhs.m_data;
+	}
+#else
+	bool operator!=(const Self& rhs) const
+	{
+		return m_data != rhs.m_data;
+	}
+
+	bool operator<(const Self& rhs) const
+	{
+		return m_data < rhs.m_data;
+	}
+
+	bool operator>(const Self& rhs) const
+	{
+		return m_data > rhs.m_data;
+	}
+
+	bool operator<=(const Self& rhs) const
+	{
+		return m_data <= rhs.m_data;
+	}
+
+	bool operator>=(const Self& rhs) const
+	{
+		return m_data >= rhs.m_data;
+	}
+#endif
+
+	// ===== TupleBase class
+
+	virtual bool TupleBaseIsEqual(const Base& rhs) const override
+	{
+		if (m_data.size() != rhs.size())
+		{
+			return false;
+		}
+
+		const Self* rhsSame = dynamic_cast<const Self*>(&rhs);
+		if (rhsSame != nullptr)
+		{
+			// same concrete type, so the containers are compared directly,
+			// instead of through the type-erased iterators
+			return m_data == rhsSame->m_data;
+		}
+
+		return std::equal(m_data.cbegin(), m_data.cend(),
+			rhs.cbegin(),
+			[](const BaseBase& a, const BaseBase& b) -> bool
+			{ return a == b; }
+		);
+	}
+
+	virtual ObjectOrder TupleBaseCompare(const Base& rhs) const override
+	{
+		const Self* rhsSame = dynamic_cast<const Self*>(&rhs);
+		if (rhsSame != nullptr)
+		{
+			return Internal::ObjectRangeCompareThreeWay(
+				m_data.cbegin(), m_data.cend(),
+				rhsSame->m_data.cbegin(), rhsSame->m_data.cend());
+		}
+
+		return Internal::ObjectRangeCompareThreeWay(
+			cbegin(), cend(),
+			rhs.cbegin(), rhs.cend());
+	}
+
+	using Base::operator==;
+#ifdef __cpp_lib_three_way_comparison
+	using Base::operator<=>;
+#else
+	using Base::operator!=;
+	using Base::operator<;
+	using Base::operator>;
+	using Base::operator<=;
+	using Base::operator>=;
+#endif
+
+	// ========== Functions provided by this class ==========
+
+	// ========== value access ==========
+
+	const value_type& operator[](size_t idx) const
+	{
+		try
+		{
+			return m_data.at(idx);
+		}
+		catch(const std::out_of_range&)
+		{
+			throw IndexError(idx);
+		}
+	}
+
+	const_pointer data() const
+	{
+		return m_data.data();
+	}
+
+	// ========== item searching ==========
+
+	bool Contains(const_reference val) const
+	{
+		auto e = cend();
+		return std::find(cbegin(), e, val) != e;
+	}
+
+	// ========== iterators ==========
+
+	const_iterator cbegin() const
+	{
+		return ToRdIt<true>(m_data.cbegin());
+	}
+
+	const_iterator cend() const
+	{
+		return ToRdIt<true>(m_data.cend());
+	}
+
+	const_iterator begin() const
+	{
+		return cbegin();
+	}
+
+	const_iterator end() const
+	{
+		return cend();
+	}
+
+	const_reverse_iterator crbegin() const
+	{
+		return ToRdIt<true>(m_data.crbegin());
+	}
+
+	const_reverse_iterator crend() const
+	{
+		return ToRdIt<true>(m_data.crend());
+	}
+
+	// ========== Overrides HashableBaseObject ==========
+
+	virtual std::size_t Hash() const override
+	{
+		return m_hashCache.Get([this]() {
+			size_t seed = 0;
+			for (const auto& item : m_data)
+			{
+				Internal::hash_combine(seed, item.Hash());
+			}
+			return seed;
+		});
+	}
+
+	// ========== Overrides BaseObject ==========
+
+	virtual ObjCategory GetCategory() const override
+	{
+		return sk_cat();
+	}
+
+	using BaseBaseBase::Set;
+
+	virtual void Set(const BaseBaseBase& other) override
+	{
+		try
+		{
+			const Self& casted = dynamic_cast<const Self&>(other);
+			*this = casted;
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("Tuple", other.GetCategoryName());
+		}
+	}
+
+	virtual void Set(BaseBaseBase&& other) override
+	{
+		try
+		{
+			Self&& casted = dynamic_cast<Self&&>(other);
+			*this = std::forward<Self>(casted);
+		}
+		catch(const std::bad_cast&)
+		{
+			throw TypeError("Tuple", other.GetCategoryName());
+		}
+	}
+
+	virtual bool IsTrue() const override
+	{
+		return m_data.size() > 0;
+	}
+
+	// ========== Overrides TupleBaseObject ==========
+
+	// ========== capacity ==========
+
+	virtual size_t size() const override
+	{
+		return m_data.size();
+	}
+
+	// ========== Interface copy/Move ==========
+
+	using Base::Copy;
+	virtual std::unique_ptr<Base> Copy(const Base* /*unused*/) const override
+	{
+		return CopyImpl();
+	}
+
+	using Base::Move;
+	virtual std::unique_ptr<Base> Move(const Base* /*unused*/) override
+	{
+		return MoveImpl();
+	}
+
+	// ========== To string ==========
+
+	virtual std::string DebugString() const override
+	{
+		std::string res;
+		res += '(';
+		res += ' ';
+		size_t i = 0;
+		for (const auto& item : m_data)
+		{
+			res += item.DebugString();
+			if (i < m_data.size() - 1)
+			{
+				res += ',';
+				res += ' ';
+			}
+			++i;
+		}
+		res += ' ';
+		res += ')';
+		return res;
+	}
+
+	virtual std::string ShortDebugString() const override
+	{
+		std::string res;
+		res += '(';
+		size_t i = 0;
+		for (const auto& item : m_data)
+		{
+			res += item.ShortDebugString();
+			if (i < m_data.size() - 1)
+			{
+				res += ',';
+			}
+			++i;
+		}
+		res += ')';
+		return res;
+	}
+
+	virtual ToStringType ToString() const override
+	{
+		auto res = Internal::ToString<ToStringType>("( ");
+		size_t i = 0;
+		for (const auto& item : m_data)
+		{
+			res += item.ToString();
+			if (i < m_data.size() - 1)
+			{
+				res += Internal::ToString<ToStringType>(", ");
+			}
+			++i;
+		}
+		res += Internal::ToString<ToStringType>(" )");
+		return res;
+	}
+
+	virtual void DumpString(OutIterator<typename ToStringType::value_type> outIt) const override
+	{
+		*outIt++ = '(';
+		*outIt++ = ' ';
+		size_t i = 0;
+		for (const auto& item : m_data)
+		{
+			item.DumpString(outIt);
+			if (i < m_data.size() - 1)
+			{
+				*outIt++ = ',';
+				*outIt++ = ' ';
+			}
+			++i;
+		}
+		*outIt++ = ' ';
+		*outIt++ = ')';
+	}
+
+protected:
+
+	// ========== iterators ==========
+
+	virtual base_const_iterator TupleBaseBegin() const override
+	{
+		return ToRdIt<true,
+			typename ContainerType::const_iterator,
+			base_value_type>(m_data.cbegin());
+	}
+
+	virtual base_const_iterator TupleBaseEnd() const override
+	{
+		return ToRdIt<true,
+			typename ContainerType::const_iterator,
+			base_value_type>(m_data.cend());
+	}
+
+	// ========== value access ==========
+
+	virtual base_const_reference TupleBaseAt(size_t idx) const override
+	{
+		return Self::operator[](idx);
+	}
+
+	// ========== batched iteration ==========
+
+	virtual void TupleBaseForEach(
+		const std::function<void(base_const_reference)>& func) const override
+	{
+		for (const auto& item : m_data)
+		{
+			func(item);
+		}
+	}
+
+private:
+
+	std::unique_ptr<Self> CopyImpl() const
+	{
+		return Internal::make_unique<Self>(*this);
+	}
+
+	std::unique_ptr<Self> MoveImpl()
+	{
+		return Internal::make_unique<Self>(std::move(*this));
+	}
+
+	ContainerType m_data;
+	Internal::HashCache m_hashCache;
+
+}; // class TupleImpl
+
+} // namespace SimpleObjects
+
+// ========== Hash ==========
+namespace std
+{
+
+	template<typename _CtnType, typename _ToStringType>
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+	struct hash<SimpleObjects::TupleImpl<_CtnType, _ToStringType> >
+	{
+		using _ObjType = SimpleObjects::TupleImpl<_CtnType, _ToStringType>;
+#else
+	struct hash<SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE::TupleImpl<_CtnType, _ToStringType> >
+	{
+		using _ObjType = SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE::TupleImpl<_CtnType, _ToStringType>;
+#endif
+
+	public:
+
+#if __cplusplus < 201703L
+		typedef size_t       result_type;
+		typedef _ObjType     argument_type;
+#endif
+
+		size_t operator()(const _ObjType& cnt) const
+		{
+			return cnt.Hash();
+		}
+	}; // struct hash
+
+} // namespace std
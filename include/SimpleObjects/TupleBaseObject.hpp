@@ -0,0 +1,253 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+
+#include "HashableBaseObject.hpp"
+
+#include "Iterator.hpp"
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+namespace SimpleObjects
+#else
+namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+#endif
+{
+
+/**
+ * @brief Defining a interface class for immutable sequences of hashable
+ *        objects, which are hashable themselves, so that they can be used
+ *        as composite keys of Dict
+ *
+ * @tparam _ValBaseType The base type of the items
+ */
+template<typename _ValBaseType, typename _ToStringType>
+class TupleBaseObject : public HashableBaseObject<_ToStringType>
+{
+public: // Static members
+
+	using ToStringType = _ToStringType;
+	using Self = TupleBaseObject<_ValBaseType, _ToStringType>;
+	using Base = HashableBaseObject<_ToStringType>;
+	using BaseBase = typename Base::Base;
+
+	static_assert(std::is_same<BaseBase, BaseObject<_ToStringType> >::value,
+		"Expecting Base::Base to be BaseObject class");
+
+	using TupleBase = typename BaseBase::TupleBase;
+
+	typedef _ValBaseType                        value_type;
+	typedef const value_type&                   const_reference;
+	typedef const value_type*                   const_pointer;
+	typedef RdIterator<value_type, true>        const_iterator;
+
+	static constexpr Self* sk_null = nullptr;
+
+public:
+	TupleBaseObject() = default;
+
+	// LCOV_EXCL_START
+	/**
+	 * @brief Destroy the Tuple Base Object
+	 *
+	 */
+	virtual ~TupleBaseObject() = default;
+	// LCOV_EXCL_STOP
+
+	virtual const char* GetCategoryName() const override
+	{
+		return "Tuple";
+	}
+
+	virtual TupleBase& AsTuple() override
+	{
+		return Internal::AsChildType<
+				std::is_same<Self, TupleBase>::value, Self, TupleBase
+			>::AsChild(*this, "Tuple", this->GetCategoryName());
+	}
+
+	virtual const TupleBase& AsTuple() const override
+	{
+		return Internal::AsChildType<
+				std::is_same<Self, TupleBase>::value, Self, TupleBase
+			>::AsChild(*this, "Tuple", this->GetCategoryName());
+	}
+
+	// ========== operators ==========
+
+	// ===== This class
+
+	virtual bool TupleBaseIsEqual(const Self& rhs) const = 0;
+
+	virtual ObjectOrder TupleBaseCompare(const Self& rhs) const = 0;
+
+	bool operator==(const Self& rhs) const
+	{
+		return TupleBaseIsEqual(rhs);
+	}
+
+	bool operator!=(const Self& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+	bool operator<(const Self& rhs) const
+	{
+		auto cmpRes = TupleBaseCompare(rhs);
+		switch (cmpRes)
+		{
+		case ObjectOrder::Less:
+			return true;
+		case ObjectOrder::EqualUnordered:
+		case ObjectOrder::NotEqualUnordered:
+			throw UnsupportedOperation("<",
+				this->GetCategoryName(), rhs.GetCategoryName());
+		default:
+			return false;
+		}
+	}
+
+	bool operator>(const Self& rhs) const
+	{
+		auto cmpRes = TupleBaseCompare(rhs);
+		switch (cmpRes)
+		{
+		case ObjectOrder::Greater:
+			return true;
+		case ObjectOrder::EqualUnordered:
+		case ObjectOrder::NotEqualUnordered:
+			throw UnsupportedOperation(">",
+				this->GetCategoryName(), rhs.GetCategoryName());
+		default:
+			return false;
+		}
+	}
+
+	bool operator<=(const Self& rhs) const
+	{
+		return !(*this > rhs);
+	}
+
+	bool operator>=(const Self& rhs) const
+	{
+		return !(*this < rhs);
+	}
+
+	// ===== ObjectBase class
+
+	virtual bool BaseObjectIsEqual(const BaseBase& rhs) const override
+	{
+		return (rhs.GetCategory() == ObjCategory::Tuple) &&
+				TupleBaseIsEqual(rhs.AsTuple());
+	}
+
+	virtual ObjectOrder BaseObjectCompare(const BaseBase& rhs) const override
+	{
+		switch (rhs.GetCategory())
+		{
+		case ObjCategory::Tuple:
+			return TupleBaseCompare(rhs.AsTuple());
+		default:
+			return ObjectOrder::NotEqualUnordered;
+		}
+	}
+
+	using Base::operator==;
+#ifdef __cpp_lib_three_way_comparison
+	using Base::operator<=>;
+#else
+	using Base::operator!=;
+	using Base::operator<;
+	using Base::operator>;
+	using Base::operator<=;
+	using Base::operator>=;
+#endif
+
+	// ========== capacity ==========
+
+	virtual size_t size() const = 0;
+
+	// ========== value access ==========
+
+	const_reference operator[](size_t idx) const
+	{
+		return TupleBaseAt(idx);
+	}
+
+	// ========== item searching ==========
+
+	bool Contains(const_reference val) const
+	{
+		auto e = cend();
+		return std::find(cbegin(), e, val) != e;
+	}
+
+	// ========== iterators ==========
+
+	const_iterator cbegin() const
+	{
+		return TupleBaseBegin();
+	}
+
+	const_iterator cend() const
+	{
+		return TupleBaseEnd();
+	}
+
+	const_iterator begin() const
+	{
+		return cbegin();
+	}
+
+	const_iterator end() const
+	{
+		return cend();
+	}
+
+	/**
+	 * @brief Call `func` on each item in the tuple, in order, without any
+	 *        virtual calls per item
+	 *
+	 */
+	void ForEach(const std::function<void(const_reference)>& func) const
+	{
+		TupleBaseForEach(func);
+	}
+
+	// ========== Copy and Move ==========
+
+	virtual std::unique_ptr<Self> Copy(const Self* /*unused*/) const = 0;
+
+	virtual std::unique_ptr<Self> Move(const Self* /*unused*/) = 0;
+
+	using Base::Copy;
+	virtual std::unique_ptr<Base> Copy(const Base* /*unused*/) const override
+	{
+		return Copy(sk_null);
+	}
+
+	using Base::Move;
+	virtual std::unique_ptr<Base> Move(const Base* /*unused*/) override
+	{
+		return Move(sk_null);
+	}
+
+protected:
+
+	virtual const_iterator TupleBaseBegin() const = 0;
+
+	virtual const_iterator TupleBaseEnd() const = 0;
+
+	virtual const_reference TupleBaseAt(size_t idx) const = 0;
+
+	virtual void TupleBaseForEach(
+		const std::function<void(const_reference)>& func) const = 0;
+
+}; // class TupleBaseObject
+
+} // namespace SimpleObjects
@@ -0,0 +1,182 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <memory>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+}
+
+GTEST_TEST(TestArena, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestArena, MonotonicArena)
+{
+	MonotonicArena arena(64);
+	EXPECT_EQ(arena.GetAllocatedSize(), 0);
+
+	void* ptr1 = arena.Allocate(3, 1);
+	void* ptr2 = arena.Allocate(8, 8);
+	EXPECT_NE(ptr1, nullptr);
+	EXPECT_NE(ptr2, nullptr);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr2) % 8, 0);
+	EXPECT_EQ(arena.GetAllocatedSize(), 11);
+
+	// larger than a chunk
+	void* ptr3 = arena.Allocate(1000);
+	EXPECT_NE(ptr3, nullptr);
+	EXPECT_EQ(
+		reinterpret_cast<uintptr_t>(ptr3) % MonotonicArena::sk_maxAlign, 0);
+	EXPECT_EQ(arena.GetAllocatedSize(), 1011);
+
+	// invalid alignment
+	EXPECT_THROW(arena.Allocate(8, 3), std::bad_alloc);
+	EXPECT_THROW(
+		arena.Allocate(8, MonotonicArena::sk_maxAlign * 2), std::bad_alloc);
+
+	arena.Reset();
+	EXPECT_EQ(arena.GetAllocatedSize(), 0);
+	EXPECT_NE(arena.Allocate(16), nullptr);
+
+	arena.Release();
+	EXPECT_EQ(arena.GetAllocatedSize(), 0);
+	EXPECT_NE(arena.Allocate(16), nullptr);
+}
+
+GTEST_TEST(TestArena, ArenaScope)
+{
+	MonotonicArena arena1;
+	MonotonicArena arena2;
+	EXPECT_EQ(MonotonicArena::GetCurrent(), nullptr);
+	{
+		ArenaScope scope1(arena1);
+		EXPECT_EQ(MonotonicArena::GetCurrent(), &arena1);
+		{
+			ArenaScope scope2(arena2);
+			EXPECT_EQ(MonotonicArena::GetCurrent(), &arena2);
+		}
+		EXPECT_EQ(MonotonicArena::GetCurrent(), &arena1);
+	}
+	EXPECT_EQ(MonotonicArena::GetCurrent(), nullptr);
+}
+
+GTEST_TEST(TestArena, ArenaAllocator)
+{
+	using VecType = std::vector<uint64_t, ArenaAllocator<uint64_t> >;
+
+	MonotonicArena arena;
+
+	VecType heapVec;
+	EXPECT_EQ(heapVec.get_allocator().GetArena(), nullptr);
+	heapVec.push_back(1);
+
+	VecType arenaVec{ ArenaAllocator<uint64_t>(&arena) };
+	for (uint64_t i = 0; i < 100; ++i)
+	{
+		arenaVec.push_back(i);
+	}
+	EXPECT_EQ(arenaVec.get_allocator().GetArena(), &arena);
+	EXPECT_GE(arena.GetAllocatedSize(), 100 * sizeof(uint64_t));
+
+	// copies follow the active arena
+	VecType heapCpy = arenaVec;
+	EXPECT_EQ(heapCpy.get_allocator().GetArena(), nullptr);
+	EXPECT_EQ(heapCpy, arenaVec);
+	{
+		ArenaScope scope(arena);
+		VecType arenaCpy = heapVec;
+		EXPECT_EQ(arenaCpy.get_allocator().GetArena(), &arena);
+		EXPECT_EQ(arenaCpy, heapVec);
+	}
+
+	// moves keep the allocator
+	VecType arenaMov = std::move(arenaVec);
+	EXPECT_EQ(arenaMov.get_allocator().GetArena(), &arena);
+	EXPECT_EQ(arenaMov.size(), 100);
+}
+
+GTEST_TEST(TestArena, ObjectAllocation)
+{
+	MonotonicArena arena;
+
+	// objects allocated on the heap outside of any scope
+	std::unique_ptr<BaseObj> heapObj = String("Test").Copy(BaseObj::sk_null);
+	EXPECT_EQ(arena.GetAllocatedSize(), 0);
+
+	{
+		ArenaScope scope(arena);
+
+		std::unique_ptr<BaseObj> arenaObj = heapObj->Copy(BaseObj::sk_null);
+		EXPECT_GT(arena.GetAllocatedSize(), sizeof(String));
+		EXPECT_EQ(*arenaObj, *heapObj);
+
+		Object dict = Dict({ { String("key"), Int64(12345) }, });
+		EXPECT_GT(arena.GetAllocatedSize(), sizeof(String) + sizeof(Dict));
+		EXPECT_EQ(dict.AsDict()[String("key")], Int64(12345));
+
+		// objects can be destroyed as usual
+		arenaObj.reset();
+	}
+
+	// objects from the arena can be destroyed outside of the scope
+	const size_t allocSize = arena.GetAllocatedSize();
+	std::unique_ptr<BaseObj> arenaObj;
+	{
+		ArenaScope scope(arena);
+		arenaObj = heapObj->Copy(BaseObj::sk_null);
+	}
+	EXPECT_GT(arena.GetAllocatedSize(), allocSize);
+	heapObj.reset();
+	arenaObj.reset();
+}
+
+GTEST_TEST(TestArena, ObjectTree)
+{
+	using ArenaList =
+		ListImpl<std::vector<Object, ArenaAllocator<Object> >, std::string>;
+	using ArenaBytes =
+		BytesImpl<std::vector<uint8_t, ArenaAllocator<uint8_t> >, std::string>;
+
+	MonotonicArena arena;
+
+	// the whole tree, including the buffers of the containers, is placed in
+	// the arena, so it can be dropped without running any destructor
+	ArenaList& list = arena.Create<ArenaList>();
+	{
+		ArenaScope scope(arena);
+		for (size_t i = 0; i < 100; ++i)
+		{
+			list.push_back(ArenaBytes({ 0x01U, 0x02U, 0x03U, 0x04U, }));
+		}
+		list.push_back(ArenaList({ Int64(1), Int64(2), }));
+	}
+	EXPECT_EQ(list.size(), 101);
+	EXPECT_EQ(list[0].AsBytes().size(), 4);
+	EXPECT_EQ(list[100].AsList()[1], Int64(2));
+	EXPECT_GT(arena.GetAllocatedSize(), 100 * sizeof(Object));
+
+	arena.Reset();
+	EXPECT_EQ(arena.GetAllocatedSize(), 0);
+}
@@ -0,0 +1,354 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+}
+
+namespace
+{
+
+template<typename _MapType, typename _RefType>
+void ExpectSameMap(const _MapType& map, const _RefType& ref)
+{
+	ASSERT_EQ(map.size(), ref.size());
+	auto it = map.cbegin();
+	for (const auto& item : ref)
+	{
+		ASSERT_TRUE(it != map.cend());
+		EXPECT_EQ(it->first, item.first);
+		EXPECT_EQ(it->second, item.second);
+		++it;
+	}
+	EXPECT_TRUE(it == map.cend());
+}
+
+} // namespace
+
+GTEST_TEST(TestBTreeMap, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestBTreeMap, Basic)
+{
+	BTreeMap<std::string, int> map;
+	EXPECT_TRUE(map.empty());
+	EXPECT_TRUE(map.begin() == map.end());
+	EXPECT_TRUE(map.find("a") == map.end());
+	EXPECT_TRUE(map.lower_bound("a") == map.end());
+	EXPECT_THROW(map.at("a"), std::out_of_range);
+
+	auto res = map.emplace("b", 2);
+	EXPECT_TRUE(res.second);
+	EXPECT_EQ(res.first->first, "b");
+	res = map.emplace("b", 3);
+	EXPECT_FALSE(res.second);
+	EXPECT_EQ(res.first->second, 2);
+
+	EXPECT_TRUE(map.insert(std::make_pair(std::string("d"), 4)).second);
+	map["a"] = 1;
+	EXPECT_EQ(map["c"], 0);
+	EXPECT_EQ(map.size(), 4);
+	ExpectSameMap(map, std::map<std::string, int>{
+		{ "a", 1 }, { "b", 2 }, { "c", 0 }, { "d", 4 } });
+
+	EXPECT_EQ(map.lower_bound("b")->first, "b");
+	EXPECT_EQ(map.upper_bound("b")->first, "c");
+	EXPECT_EQ(map.lower_bound("bb")->first, "c");
+	EXPECT_TRUE(map.upper_bound("d") == map.end());
+
+	const auto& cmap = map;
+	EXPECT_EQ(cmap.at("d"), 4);
+	EXPECT_EQ(cmap.count("e"), 0);
+
+	EXPECT_EQ(map.erase("c"), 1);
+	EXPECT_EQ(map.erase("c"), 0);
+	EXPECT_EQ(map.size(), 3);
+
+	map.clear();
+	EXPECT_TRUE(map.empty());
+	EXPECT_TRUE(map.emplace("z", 26).second);
+	EXPECT_EQ(map.at("z"), 26);
+}
+
+GTEST_TEST(TestBTreeMap, RandomOps)
+{
+	BTreeMap<int64_t, int64_t> map;
+	std::map<int64_t, int64_t> ref;
+	std::mt19937_64 rng(24680);
+
+	for (int i = 0; i < 60000; ++i)
+	{
+		// grow first, then shrink, so that nodes are both split and merged
+		const int64_t key = static_cast<int64_t>(rng() % 4096);
+		const uint64_t op = rng() % 8;
+		if (op < ((i < 30000) ? 5U : 2U))
+		{
+			EXPECT_EQ(map.emplace(key, i).second, ref.emplace(key, i).second);
+		}
+		else if (op < 6)
+		{
+			EXPECT_EQ(map.erase(key), ref.erase(key));
+		}
+		else
+		{
+			auto it = map.lower_bound(key);
+			auto rit = ref.lower_bound(key);
+			ASSERT_EQ(it == map.end(), rit == ref.end());
+			if (rit != ref.end())
+			{
+				EXPECT_EQ(it->first, rit->first);
+			}
+			auto jt = map.upper_bound(key);
+			auto rjt = ref.upper_bound(key);
+			ASSERT_EQ(jt == map.end(), rjt == ref.end());
+			if (rjt != ref.end())
+			{
+				EXPECT_EQ(jt->first, rjt->first);
+			}
+		}
+		ASSERT_EQ(map.size(), ref.size());
+	}
+	ExpectSameMap(map, ref);
+
+	for (auto it = ref.begin(); it != ref.end(); it = ref.erase(it))
+	{
+		ASSERT_EQ(map.erase(it->first), 1);
+	}
+	EXPECT_TRUE(map.empty());
+	EXPECT_TRUE(map.begin() == map.end());
+}
+
+GTEST_TEST(TestBTreeMap, SortedInput)
+{
+	std::vector<std::pair<int64_t, int64_t> > input;
+	std::map<int64_t, int64_t> ref;
+	for (int64_t i = 0; i < 10000; ++i)
+	{
+		input.emplace_back(i * 3, i);
+		ref.emplace(i * 3, i);
+	}
+
+	BTreeMap<int64_t, int64_t> map(input.begin(), input.end());
+	ExpectSameMap(map, ref);
+
+	// keys out of order are still inserted at the right places
+	map.emplace_hint(map.cend(), 1, -1);
+	map.emplace_hint(map.cend(), 30000, -2);
+	ref.emplace(1, -1);
+	ref.emplace(30000, -2);
+	ExpectSameMap(map, ref);
+
+	BTreeMap<int64_t, int64_t> rmap(input.rbegin(), input.rend());
+	ref.erase(1);
+	ref.erase(30000);
+	ExpectSameMap(rmap, ref);
+}
+
+GTEST_TEST(TestBTreeMap, EraseIterator)
+{
+	BTreeMap<int64_t, int64_t> map;
+	for (int64_t i = 0; i < 1000; ++i)
+	{
+		map.emplace(i, i);
+	}
+
+	for (auto it = map.begin(); it != map.end(); )
+	{
+		if (it->first % 3 != 1)
+		{
+			it = map.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+	EXPECT_EQ(map.size(), 333);
+	int64_t expected = 1;
+	for (const auto& item : map)
+	{
+		EXPECT_EQ(item.first, expected);
+		expected += 3;
+	}
+}
+
+GTEST_TEST(TestBTreeMap, StableReferences)
+{
+	BTreeMap<std::string, std::string> map;
+	map.emplace("key", "val");
+	const std::string* keyPtr = &(map.find("key")->first);
+	std::string* valPtr = &(map.find("key")->second);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		map.emplace(std::to_string(i), std::to_string(i));
+	}
+	for (int i = 0; i < 1000; i += 2)
+	{
+		map.erase(std::to_string(i));
+	}
+	EXPECT_EQ(&(map.find("key")->first), keyPtr);
+	EXPECT_EQ(&(map.find("key")->second), valPtr);
+	EXPECT_EQ(*valPtr, "val");
+}
+
+GTEST_TEST(TestBTreeMap, CopyMoveCompare)
+{
+	BTreeMap<std::string, int> map1 = { { "c", 3 }, { "a", 1 }, { "b", 2 } };
+	map1.erase("b");
+
+	BTreeMap<std::string, int> map2 = map1;
+	EXPECT_TRUE(map1 == map2);
+	map2.emplace("d", 4);
+	EXPECT_TRUE(map1 != map2);
+
+	BTreeMap<std::string, int> map3 = std::move(map2);
+	EXPECT_EQ(map3.size(), 3);
+	EXPECT_EQ(map2.size(), 0);
+	map2.emplace("e", 5);
+	EXPECT_EQ(map2.at("e"), 5);
+
+	map3 = map1;
+	EXPECT_TRUE(map3 == map1);
+	map3 = std::move(map2);
+	EXPECT_EQ(map3.size(), 1);
+	EXPECT_EQ(map3.at("e"), 5);
+
+	map3.swap(map1);
+	EXPECT_EQ(map1.size(), 1);
+	EXPECT_EQ(map3.size(), 2);
+
+	BTreeMap<int64_t, int64_t> big;
+	for (int64_t i = 0; i < 5000; ++i)
+	{
+		big.emplace((i * 7919) % 5000, i);
+	}
+	BTreeMap<int64_t, int64_t> bigCopy = big;
+	EXPECT_TRUE(bigCopy == big);
+	bigCopy[42] = -1;
+	EXPECT_TRUE(bigCopy != big);
+}
+
+GTEST_TEST(TestBTreeMap, ArenaAllocator)
+{
+	using MapType = BTreeMap<int64_t, std::string,
+		std::less<int64_t>,
+		ArenaAllocator<std::pair<const int64_t, std::string> > >;
+
+	MonotonicArena arena;
+	{
+		ArenaScope scope(arena);
+		MapType map;
+		for (int64_t i = 0; i < 100; ++i)
+		{
+			map.emplace(i, std::to_string(i));
+		}
+		EXPECT_GT(arena.GetAllocatedSize(), 0);
+		EXPECT_EQ(map.at(42), "42");
+	}
+}
+
+GTEST_TEST(TestBTreeMap, SortedDict)
+{
+	SortedDict dict;
+	dict.InsertOrAssign(String("b"), Int64(1));
+	dict.InsertOrAssign(Int64(10), Null());
+	dict.InsertOrAssign(Double(2.5), Null());
+	dict.InsertOrAssign(Bool(true), Null());
+	dict.InsertOrAssign(String("a"), Int64(2));
+	dict.InsertOrAssign(Null(), Null());
+	dict.InsertOrAssign(Bytes({ 0x01U, }), Null());
+	dict.InsertOrAssign(Tuple({ Int64(1), String("x") }), Null());
+	dict.InsertOrAssign(Tuple({ String("x"), Int64(1) }), Null());
+	dict.InsertOrAssign(Tuple({ Int64(1) }), Null());
+	EXPECT_EQ(dict.size(), 10);
+
+	// numbers are ordered by values; other categories follow ObjCategory
+	EXPECT_EQ(dict.ShortDebugString(),
+		"{null:null,true:null,2.5:null,10:null,\"a\":2,\"b\":1,"
+		"\"\\x01\":null,(1):null,(1,\"x\"):null,(\"x\",1):null}");
+
+	// a number key is found no matter which category it's in
+	EXPECT_TRUE(dict.HasKey(Int64(1)));
+	EXPECT_TRUE(dict.HasKey(Double(10.0)));
+	EXPECT_EQ(dict["a"], Int64(2));
+
+	Dict ref;
+	for (const auto& item : dict)
+	{
+		ref.InsertOrAssign(item.first.GetVal(), item.second);
+	}
+	EXPECT_TRUE(dict == static_cast<const DictBaseObj&>(ref));
+	EXPECT_TRUE(ref == static_cast<const DictBaseObj&>(dict));
+}
+
+GTEST_TEST(TestBTreeMap, SortedDictRange)
+{
+	std::vector<std::pair<String, Int64> > input;
+	for (int64_t i = 0; i < 100; ++i)
+	{
+		input.emplace_back(
+			String(std::string("key_") + static_cast<char>('a' + i / 10) +
+				static_cast<char>('a' + i % 10)),
+			Int64(i));
+	}
+	SortedDict dict(input.begin(), input.end());
+	EXPECT_EQ(dict.size(), 100);
+	EXPECT_EQ(dict["key_ba"], Int64(10));
+
+	// all keys in [key_c, key_d)
+	std::vector<int64_t> vals;
+	for (auto it = dict.LowerBound("key_c"); it != dict.LowerBound("key_d"); ++it)
+	{
+		vals.push_back(it->second.AsCppInt64());
+	}
+	std::vector<int64_t> expVals;
+	for (int64_t i = 20; i < 30; ++i)
+	{
+		expVals.push_back(i);
+	}
+	EXPECT_EQ(vals, expVals);
+
+	EXPECT_EQ(dict.UpperBound("key_ji")->first.GetVal(), String("key_jj"));
+	EXPECT_TRUE(dict.UpperBound(String("key_jj~")) == dict.end());
+	EXPECT_TRUE(dict.LowerBound(Int64(1))->first.GetVal() == String("key_aa"));
+
+	auto it = dict.LowerBound(String("key_ja"));
+	it->second = Int64(-1);
+	EXPECT_EQ(dict["key_ja"], Int64(-1));
+
+	SortedDict copy = dict;
+	EXPECT_TRUE(copy == dict);
+	copy.Remove(String("key_aa"));
+	EXPECT_EQ(copy.begin()->first.GetVal(), String("key_ab"));
+	EXPECT_EQ(JsonWriter::Dump(SortedDict({
+			{ String("z"), Int64(1) }, { String("m"), Int64(2) } })),
+		"{\"m\":2,\"z\":1}");
+}
@@ -210,8 +210,8 @@ GTEST_TEST(TestBytes, Hash)
 	std::vector<uint8_t> val1 = { 0x00U, 0x01U, 0x02U, 0x03U, };
 	std::vector<uint8_t> val2 = { 0x00U, 0x01U, 0x02U, 0x06U, };
 
-	size_t h1 = Internal::hash_range(val1.cbegin(), val1.cend());
-	size_t h2 = Internal::hash_range(val2.cbegin(), val2.cend());
+	size_t h1 = Internal::DefaultHashPolicy::HashBytes(val1.data(), val1.size());
+	size_t h2 = Internal::DefaultHashPolicy::HashBytes(val2.data(), val2.size());
 
 	EXPECT_EQ(Bytes({ 0x00U, 0x01U, 0x02U, 0x03U, }).Hash(), h1);
 	EXPECT_EQ(Bytes({ 0x00U, 0x01U, 0x02U, 0x06U, }).Hash(), h2);
@@ -225,6 +225,44 @@ GTEST_TEST(TestBytes, Hash)
 		std::hash<Bytes>()(Bytes({ 0x00U, 0x01U, 0x02U, 0x06U, })));
 }
 
+GTEST_TEST(TestBytes, HashCache)
+{
+	auto hashOf = [](const std::vector<uint8_t>& v)
+	{
+		return Internal::DefaultHashPolicy::HashBytes(v.data(), v.size());
+	};
+
+	Bytes bytes({ 0x00U, 0x01U, 0x02U, });
+	EXPECT_EQ(bytes.Hash(), hashOf({ 0x00U, 0x01U, 0x02U, }));
+
+	// the cached hash value is dropped by every modification
+	bytes.push_back(0x03U);
+	EXPECT_EQ(bytes.Hash(), hashOf({ 0x00U, 0x01U, 0x02U, 0x03U, }));
+	bytes.pop_back();
+	EXPECT_EQ(bytes.Hash(), hashOf({ 0x00U, 0x01U, 0x02U, }));
+	bytes[0] = 0x10U;
+	EXPECT_EQ(bytes.Hash(), hashOf({ 0x10U, 0x01U, 0x02U, }));
+	bytes += Bytes({ 0x04U, });
+	EXPECT_EQ(bytes.Hash(), hashOf({ 0x10U, 0x01U, 0x02U, 0x04U, }));
+	bytes.resize(2);
+	EXPECT_EQ(bytes.Hash(), hashOf({ 0x10U, 0x01U, }));
+	*bytes.begin() = 0x20U;
+	EXPECT_EQ(bytes.Hash(), hashOf({ 0x20U, 0x01U, }));
+	*bytes.rbegin() = 0x30U;
+	EXPECT_EQ(bytes.Hash(), hashOf({ 0x20U, 0x30U, }));
+	*bytes.NativeBegin() = 0x40U;
+	EXPECT_EQ(bytes.Hash(), hashOf({ 0x40U, 0x30U, }));
+	bytes.Set(Bytes({ 0x05U, }));
+	EXPECT_EQ(bytes.Hash(), hashOf({ 0x05U, }));
+
+	// copies share the cached value, and moved-from objects drop it
+	Bytes cpy = bytes;
+	EXPECT_EQ(cpy.Hash(), hashOf({ 0x05U, }));
+	Bytes moved = std::move(cpy);
+	EXPECT_EQ(moved.Hash(), hashOf({ 0x05U, }));
+	EXPECT_EQ(cpy.Hash(), hashOf(cpy.GetVal()));
+}
+
 GTEST_TEST(TestBytes, At)
 {
 	const auto testBytes1 = Bytes({ 0x00U, 0x01U, 0x02U, });
@@ -267,6 +305,20 @@ GTEST_TEST(TestBytes, Append)
 
 	testBytes1 += testBytes2;
 	EXPECT_EQ(testBytes1, Bytes({ 0x00U, 0x01U, 0x02U, 0x03U, }));
+
+	const uint8_t span[] = { 0x04U, 0x05U, };
+	testBytes1.Append(span, span + 2);
+	EXPECT_EQ(testBytes1,
+		Bytes({ 0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, }));
+
+	// append to itself through the base class
+	auto selfBytes = Bytes({ 0x00U, 0x01U, 0x02U, });
+	BytesBaseObj& selfBase = selfBytes;
+	selfBase += selfBase;
+	EXPECT_EQ(selfBytes, Bytes({ 0x00U, 0x01U, 0x02U, 0x00U, 0x01U, 0x02U, }));
+	selfBase.Append(selfBase.data() + 1, selfBase.data() + 3);
+	EXPECT_EQ(selfBytes,
+		Bytes({ 0x00U, 0x01U, 0x02U, 0x00U, 0x01U, 0x02U, 0x01U, 0x02U, }));
 }
 
 GTEST_TEST(TestBytes, Data)
@@ -412,6 +464,21 @@ GTEST_TEST(TestBytes, Iterator)
 	testProg2();
 }
 
+GTEST_TEST(TestBytes, NativeIterator)
+{
+	auto testBytes1 = Bytes({ 0x00U, 0x12U, 0xABU, 0xCDU, });
+	const auto& kTestBytes1 = testBytes1;
+
+	EXPECT_EQ(kTestBytes1.NativeEnd() - kTestBytes1.NativeBegin(), 4);
+	EXPECT_EQ(&(*kTestBytes1.NativeBegin()), kTestBytes1.data());
+	EXPECT_TRUE(std::equal(
+		kTestBytes1.NativeBegin(), kTestBytes1.NativeEnd(),
+		kTestBytes1.cbegin()));
+
+	std::fill(testBytes1.NativeBegin(), testBytes1.NativeEnd(), 0x5AU);
+	EXPECT_EQ(testBytes1, Bytes({ 0x5AU, 0x5AU, 0x5AU, 0x5AU, }));
+}
+
 GTEST_TEST(TestBytes, ToString)
 {
 	auto testBytes1 = Bytes({ 0x00U, 0x12U, 0xABU, 0xCDU, });
@@ -436,3 +503,25 @@ GTEST_TEST(TestBytes, ToString)
 		EXPECT_EQ(res, expRes);
 	}
 }
+
+GTEST_TEST(TestBytes, Allocator)
+{
+	MonotonicArena arena;
+	ArenaAllocator<uint8_t> alloc(&arena);
+
+	auto bytes = MakeBytes(alloc);
+	EXPECT_EQ(bytes.GetVal().get_allocator(), alloc);
+	for (uint8_t i = 0; i < 100; ++i)
+	{
+		bytes.push_back(i);
+	}
+	EXPECT_GE(arena.GetAllocatedSize(), 100);
+
+	Bytes expBytes;
+	for (uint8_t i = 0; i < 100; ++i)
+	{
+		expBytes.push_back(i);
+	}
+	EXPECT_TRUE(bytes.BaseObjectIsEqual(expBytes));
+	EXPECT_EQ(bytes.Hash(), expBytes.Hash());
+}
@@ -0,0 +1,145 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <vector>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+}
+
+GTEST_TEST(TestBytesView, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestBytesView, ReadAccess)
+{
+	const std::vector<uint8_t> buf = { 1, 2, 3, 4, 5 };
+	const BytesView view(buf.data(), buf.size());
+
+	EXPECT_FALSE(view.IsOwned());
+	EXPECT_EQ(view.data(), buf.data());
+	EXPECT_EQ(view.size(), 5);
+	EXPECT_EQ(view[2], 3);
+	EXPECT_THROW(view[5], IndexError);
+	EXPECT_EQ(view.GetCategory(), ObjCategory::Bytes);
+	EXPECT_TRUE(view.IsTrue());
+	EXPECT_FALSE(BytesView().IsTrue());
+
+	std::vector<uint8_t> copied(view.begin(), view.end());
+	EXPECT_EQ(copied, buf);
+	std::vector<uint8_t> reversed(view.crbegin(), view.crend());
+	EXPECT_EQ(reversed, std::vector<uint8_t>({ 5, 4, 3, 2, 1 }));
+
+	EXPECT_EQ(view.DebugString(), Bytes({ 1, 2, 3, 4, 5 }).DebugString());
+	EXPECT_EQ(view.ToString(), Bytes({ 1, 2, 3, 4, 5 }).ToString());
+
+	// nothing above should copy the data
+	EXPECT_FALSE(view.IsOwned());
+}
+
+GTEST_TEST(TestBytesView, CompareAndHash)
+{
+	const std::vector<uint8_t> buf = { 1, 2, 3 };
+	const BytesView view(buf.data(), buf.size());
+	const Bytes bytes = { 1, 2, 3 };
+
+	EXPECT_TRUE(view == bytes);
+	EXPECT_TRUE(bytes == view);
+	EXPECT_FALSE(view != bytes);
+	EXPECT_TRUE(view < Bytes({ 1, 2, 4 }));
+	EXPECT_TRUE(view > Bytes({ 1, 2 }));
+	EXPECT_EQ(view.Hash(), bytes.Hash());
+	EXPECT_EQ(std::hash<BytesView>()(view), std::hash<Bytes>()(bytes));
+
+	// lookup in a dict keyed by bytes
+	Dict dict = { { HashableObject(bytes), Int64(1) } };
+	EXPECT_EQ(dict[HashableObject(view)], Int64(1));
+}
+
+GTEST_TEST(TestBytesView, Slice)
+{
+	const std::vector<uint8_t> buf = { 1, 2, 3, 4, 5 };
+	const BytesView view(buf.data(), buf.size());
+
+	BytesView slice = view.Slice(1, 3);
+	EXPECT_EQ(slice.data(), buf.data() + 1);
+	EXPECT_EQ(slice, Bytes({ 2, 3, 4 }));
+
+	EXPECT_EQ(view.Slice(3, 10), Bytes({ 4, 5 }));
+	EXPECT_EQ(view.Slice(5, 1).size(), 0);
+	EXPECT_THROW(view.Slice(6, 1), IndexError);
+}
+
+GTEST_TEST(TestBytesView, CopyOnWrite)
+{
+	const std::vector<uint8_t> buf = { 1, 2, 3 };
+	BytesView view(buf.data(), buf.size());
+	BytesView view2 = view;
+
+	view.push_back(4);
+	EXPECT_TRUE(view.IsOwned());
+	EXPECT_NE(view.data(), buf.data());
+	EXPECT_EQ(view, Bytes({ 1, 2, 3, 4 }));
+	// the buffer and other views are not affected
+	EXPECT_EQ(buf, std::vector<uint8_t>({ 1, 2, 3 }));
+	EXPECT_EQ(view2, Bytes({ 1, 2, 3 }));
+	EXPECT_FALSE(view2.IsOwned());
+
+	view2[0] = 9;
+	EXPECT_EQ(view2, Bytes({ 9, 2, 3 }));
+	EXPECT_EQ(buf[0], 1);
+
+	BytesView view3(buf.data(), buf.size());
+	view3.Append(Bytes({ 5, 6 }));
+	EXPECT_EQ(view3, Bytes({ 1, 2, 3, 5, 6 }));
+	// append a part of itself, while it's still borrowed
+	BytesView view5(buf.data(), buf.size());
+	view5.Append(view5.data() + 1, view5.data() + 3);
+	EXPECT_EQ(view5, Bytes({ 1, 2, 3, 2, 3 }));
+	view5 += view5;
+	EXPECT_EQ(view5, Bytes({ 1, 2, 3, 2, 3, 1, 2, 3, 2, 3 }));
+	view3.pop_back();
+	view3.resize(2);
+	EXPECT_EQ(view3, Bytes({ 1, 2 }));
+
+	// copies of an owned view are independent
+	BytesView view4 = view3;
+	view4.push_back(7);
+	EXPECT_EQ(view3, Bytes({ 1, 2 }));
+	EXPECT_EQ(view4, Bytes({ 1, 2, 7 }));
+}
+
+GTEST_TEST(TestBytesView, InObject)
+{
+	const std::vector<uint8_t> buf = { 1, 2, 3 };
+	Object obj = BytesView(buf.data(), buf.size());
+
+	EXPECT_EQ(obj.GetCategory(), ObjCategory::Bytes);
+	EXPECT_EQ(obj.AsBytes().data(), buf.data());
+	EXPECT_EQ(obj, Bytes({ 1, 2, 3 }));
+
+	Object obj2 = obj;
+	EXPECT_EQ(obj2.AsBytes().data(), buf.data());
+
+	EXPECT_THROW(obj.Set(Bytes()), TypeError);
+}
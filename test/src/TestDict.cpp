@@ -737,6 +737,37 @@ GTEST_TEST(TestDict, BaseDictIterator)
 	}
 }
 
+GTEST_TEST(TestDict, BaseDictForEach)
+{
+	auto testDc = Dict({
+		{ Null(),         Bool(false) },
+		{ Int64(123),     Int64(321) },
+		{ String("key3"), String("val3") },
+	});
+
+	{
+		const DictBaseObj& testDcB = testDc;
+		Dict visited;
+		testDcB.ForEach([&](const HashableBaseObj& key, const BaseObj& val)
+		{
+			visited.InsertOnly(HashableObject(key), Object(val));
+		});
+		EXPECT_EQ(visited, testDc);
+	}
+
+	{
+		DictBaseObj& testDcB = testDc;
+		testDcB.ForEach([](const HashableBaseObj& key, BaseObj& val)
+		{
+			if (key.GetCategory() == ObjCategory::String)
+			{
+				val.AsString().push_back('Y');
+			}
+		});
+		EXPECT_EQ(testDc[String("key3")], String("val3Y"));
+	}
+}
+
 GTEST_TEST(TestDict, BaseDictFindVal)
 {
 	{
@@ -924,3 +955,163 @@ GTEST_TEST(TestDict, BaseDictRemove)
 		EXPECT_FALSE(testDcB.HasKey(HashableObject(String("key3"))));
 	}
 }
+
+GTEST_TEST(TestDict, BaseDictSameTypeEqual)
+{
+	const Dict a = {
+		{ String("a"), List({ Int64(1), Dict({ { Int64(2), Null() } }) }) },
+		{ Int64(3), String("b") },
+	};
+	const Dict b = {
+		{ Int64(3), String("b") },
+		{ String("a"), List({ Double(1.0), Dict({ { Int64(2), Null() } }) }) },
+	};
+	const Dict c = {
+		{ String("a"), List({ Int64(1), Dict({ { Int64(2), Bool(false) } }) }) },
+		{ Int64(3), String("b") },
+	};
+	EXPECT_TRUE(static_cast<const BaseObj&>(a) == b);
+	EXPECT_FALSE(static_cast<const BaseObj&>(a) == c);
+
+	// the order of insertion doesn't matter
+	const OrderedDict oa = { { String("a"), Int64(1) }, { String("b"), Int64(2) } };
+	const OrderedDict ob = { { String("b"), Int64(2) }, { String("a"), Int64(1) } };
+	EXPECT_TRUE(static_cast<const BaseObj&>(oa) == ob);
+
+	// dicts of different concrete types
+	const FlatDict fa = { { String("a"), Int64(1) }, { String("b"), Int64(2) } };
+	EXPECT_TRUE(static_cast<const BaseObj&>(fa) == oa);
+	EXPECT_TRUE(static_cast<const BaseObj&>(oa) == fa);
+}
+
+GTEST_TEST(TestDict, Allocator)
+{
+	MonotonicArena arena;
+	ArenaAllocator<Object> alloc(&arena);
+
+	auto dict = MakeDict(alloc);
+	EXPECT_EQ(dict.GetVal().get_allocator(), alloc);
+	dict[String("key1")] = Int64(1);
+	dict[Int64(2)] = String("val2");
+	EXPECT_GT(arena.GetAllocatedSize(), 0);
+
+	EXPECT_TRUE(dict.BaseObjectIsEqual(Dict({
+		{ String("key1"), Int64(1) },
+		{ Int64(2), String("val2") },
+	})));
+	EXPECT_EQ(dict[String("key1")], Int64(1));
+}
+
+GTEST_TEST(TestDict, LookupByRawKey)
+{
+	Dict testDc = Dict({
+		{ String("key1"), Int64(1) },
+		{ Int64(-2),      String("val2") },
+		{ UInt64(3),      String("val3") },
+		{ Double(4.5),    String("val4") },
+		{ Bool(true),     String("val5") },
+		{ Bytes({ 1, 2 }), String("val6") },
+	});
+	const Dict& testDcC = testDc;
+
+	// strings
+	EXPECT_TRUE(testDcC.HasKey("key1"));
+	EXPECT_TRUE(testDcC.HasKey(std::string("key1")));
+	EXPECT_FALSE(testDcC.HasKey("key2"));
+	EXPECT_EQ(testDcC["key1"], Int64(1));
+	EXPECT_EQ(testDc["key1"], Int64(1));
+	EXPECT_THROW(testDcC["key2"], KeyError);
+	EXPECT_TRUE(testDc.find("key1") != testDc.end());
+	EXPECT_TRUE(testDcC.find("key2") == testDcC.end());
+#if __cplusplus >= 201703L
+	EXPECT_TRUE(testDcC.HasKey(std::string_view("key1xx", 4)));
+#endif // __cplusplus >= 201703L
+
+	// numbers
+	EXPECT_TRUE(testDcC.HasKey(-2));
+	EXPECT_EQ(testDcC[static_cast<int8_t>(-2)], String("val2"));
+	EXPECT_TRUE(testDcC.HasKey(3U));
+	EXPECT_TRUE(testDcC.HasKey(4.5f));
+	EXPECT_TRUE(testDcC.HasKey(true));
+	EXPECT_FALSE(testDcC.HasKey(5));
+
+	// views of any hashable type
+	EXPECT_TRUE(testDcC.HasKey(StringView("key1")));
+	EXPECT_EQ(testDcC[StringView("key1")], Int64(1));
+	EXPECT_EQ(testDc[BytesView(Bytes({ 1, 2 }))], String("val6"));
+	EXPECT_TRUE(testDc.find(BytesView(Bytes({ 1, 2 }))) != testDc.end());
+
+	// inserting by a view copies it into a key of key_type
+	{
+		StringView keyView("key7");
+		testDc[keyView] = Int64(7);
+	}
+	EXPECT_EQ(testDcC["key7"], Int64(7));
+
+	// base class
+	const DictBaseObj& testDcB = testDc;
+	EXPECT_TRUE(testDcB.HasKey("key1"));
+	EXPECT_TRUE(testDcB.HasKey(std::string("key7")));
+	EXPECT_FALSE(testDcB.HasKey("key2"));
+	EXPECT_EQ(testDcB["key1"], Int64(1));
+	EXPECT_THROW(testDcB["key2"], KeyError);
+	EXPECT_TRUE(testDcB.FindVal(-2) != testDcB.ValsCEnd());
+	EXPECT_TRUE(testDcB.FindVal(5) == testDcB.ValsCEnd());
+	EXPECT_EQ(*(testDc.AsDict().FindVal(3U)), String("val3"));
+}
+
+GTEST_TEST(TestDict, DictKeyStorage)
+{
+	using DictKey = Dict::DictKey;
+
+	// an owning key is stored inside the DictKey object
+	DictKey key1 = DictKey::Make(String("key1"));
+	EXPECT_TRUE(key1.IsOwner());
+	const void* key1Begin = &key1;
+	const void* key1End = &key1 + 1;
+	EXPECT_GE(static_cast<const void*>(&key1.GetVal()), key1Begin);
+	EXPECT_LT(static_cast<const void*>(&key1.GetVal()), key1End);
+	EXPECT_EQ(key1.GetBasePtr(), &key1.GetVal());
+
+	DictKey key2 = key1;
+	EXPECT_TRUE(key2.IsOwner());
+	EXPECT_NE(&key2.GetVal(), &key1.GetVal());
+	EXPECT_EQ(key2.GetBasePtr(), &key2.GetVal());
+	EXPECT_TRUE(key2 == key1);
+	EXPECT_EQ(key2.Hash(), key1.Hash());
+
+	DictKey key3 = std::move(key2);
+	EXPECT_TRUE(key3.IsOwner());
+	EXPECT_EQ(key3.GetBasePtr(), &key3.GetVal());
+	EXPECT_TRUE(key3 == key1);
+
+	// a borrowing key points to the key owned by someone else
+	const HashableObject obj = String("key4");
+	DictKey key4 = DictKey::Borrow(&obj);
+	EXPECT_FALSE(key4.IsOwner());
+	EXPECT_EQ(key4.GetBasePtr(), &obj);
+	DictKey key5 = key4;
+	EXPECT_FALSE(key5.IsOwner());
+	EXPECT_EQ(key5.GetBasePtr(), &obj);
+
+	key5 = key1;
+	EXPECT_TRUE(key5.IsOwner());
+	EXPECT_EQ(key5.GetBasePtr(), &key5.GetVal());
+	EXPECT_TRUE(key5 == key1);
+	key5 = DictKey::Make(String("key5"));
+	EXPECT_EQ(key5.GetVal(), String("key5"));
+	key5 = key4;
+	EXPECT_FALSE(key5.IsOwner());
+	EXPECT_TRUE(key5 == key4);
+
+	// keys of a Dict are stored in the container nodes
+	Dict dict;
+	dict[String("key1")] = Null();
+	const auto& item = *dict.begin();
+	EXPECT_GE(
+		static_cast<const void*>(&item.first.GetVal()),
+		static_cast<const void*>(&item));
+	EXPECT_LT(
+		static_cast<const void*>(&item.first.GetVal()),
+		static_cast<const void*>(&item + 1));
+}
@@ -0,0 +1,156 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+} // namespace SimpleObjects_Test
+
+GTEST_TEST(TestFastHash, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestFastHash, Mul)
+{
+	uint64_t a = 0xFFFFFFFFFFFFFFFFULL;
+	uint64_t b = 0xFFFFFFFFFFFFFFFFULL;
+	Internal::FastHashMul(a, b);
+	EXPECT_EQ(a, 0x0000000000000001ULL);
+	EXPECT_EQ(b, 0xFFFFFFFFFFFFFFFEULL);
+
+	a = 0x0000000100000000ULL;
+	b = 0x0000000100000003ULL;
+	Internal::FastHashMul(a, b);
+	EXPECT_EQ(a, 0x0000000300000000ULL);
+	EXPECT_EQ(b, 0x0000000000000001ULL);
+}
+
+GTEST_TEST(TestFastHash, Lengths)
+{
+	// cover all the branches: empty, 1-3, 4-16, 17-48, and > 48 bytes
+	std::vector<uint8_t> data(300, 0x00U);
+	std::set<uint64_t> hashes;
+	for (size_t len = 0; len <= data.size(); ++len)
+	{
+		hashes.insert(Internal::FastHash64(data.data(), len));
+	}
+	// zeros of different lengths have different hash values
+	EXPECT_EQ(hashes.size(), data.size() + 1);
+
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = static_cast<uint8_t>(i * 7);
+	}
+	for (size_t len = 1; len <= data.size(); ++len)
+	{
+		uint64_t h = Internal::FastHash64(data.data(), len);
+		// deterministic
+		EXPECT_EQ(h, Internal::FastHash64(data.data(), len));
+
+		// every byte affects the hash value
+		for (size_t i = 0; i < len; i += 5)
+		{
+			data[i] ^= 0x10U;
+			EXPECT_NE(h, Internal::FastHash64(data.data(), len));
+			data[i] ^= 0x10U;
+		}
+	}
+}
+
+GTEST_TEST(TestFastHash, UnalignedAndSeed)
+{
+	std::string str =
+		"Lorem ipsum dolor sit amet, consectetur adipisicing elit, "
+		"sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.";
+	std::string shifted = "#" + str;
+
+	EXPECT_EQ(
+		Internal::FastHash64(str.data(), str.size()),
+		Internal::FastHash64(shifted.data() + 1, str.size()));
+
+	EXPECT_NE(
+		Internal::FastHash64(str.data(), str.size(), 0),
+		Internal::FastHash64(str.data(), str.size(), 1));
+	EXPECT_EQ(
+		Internal::FastHash64(str.data(), str.size(), 1),
+		Internal::FastHash64(str.data(), str.size(), 1));
+}
+
+GTEST_TEST(TestFastHash, Policy)
+{
+	using FastPolicy = Internal::FastHashPolicy;
+	using StdPolicy = Internal::StdHashPolicy;
+	using Traits = std::char_traits<char>;
+
+	const std::string str = "a string key";
+	const std::vector<uint8_t> bytes(str.begin(), str.end());
+
+	// the same content is hashed in the same way by Bytes and String
+	EXPECT_EQ(
+		(FastPolicy::HashStr<char, Traits>(str.data(), str.size())),
+		FastPolicy::HashBytes(bytes.data(), bytes.size()));
+
+	EXPECT_EQ(
+		(StdPolicy::HashStr<char, Traits>(str.data(), str.size())),
+		std::hash<std::string>()(str));
+	EXPECT_EQ(
+		StdPolicy::HashBytes(bytes.data(), bytes.size()),
+		Internal::hash_range(bytes.cbegin(), bytes.cend()));
+
+	EXPECT_EQ(
+		Bytes(bytes).Hash(),
+		Internal::DefaultHashPolicy::HashBytes(bytes.data(), bytes.size()));
+	EXPECT_EQ(
+		String(str).Hash(),
+		(Internal::DefaultHashPolicy::HashStr<char, Traits>(
+			str.data(), str.size())));
+	EXPECT_EQ(
+		BytesView(bytes.data(), bytes.size()).Hash(),
+		Bytes(bytes).Hash());
+	EXPECT_EQ(StringView(str.data(), str.size()).Hash(), String(str).Hash());
+}
+
+GTEST_TEST(TestFastHash, SeededPolicy)
+{
+	using SeededPolicy = Internal::SeededFastHashPolicy;
+	using Traits = std::char_traits<char>;
+
+	const std::string str = "a string key";
+	const std::vector<uint8_t> bytes(str.begin(), str.end());
+
+	const uint64_t seed = Internal::ProcessHashSeed();
+	EXPECT_EQ(seed, Internal::ProcessHashSeed());
+
+	size_t h = SeededPolicy::HashBytes(bytes.data(), bytes.size());
+	EXPECT_EQ(h, Internal::FastHash(bytes.data(), bytes.size(), seed));
+	EXPECT_EQ(h, SeededPolicy::HashBytes(bytes.data(), bytes.size()));
+	EXPECT_EQ(h, (SeededPolicy::HashStr<char, Traits>(str.data(), str.size())));
+
+	// the seed is random, so the chance that it makes no difference is
+	// negligible
+	EXPECT_NE(h, Internal::FastHashPolicy::HashBytes(bytes.data(), bytes.size()));
+	EXPECT_NE(Internal::GenHashSeed(), Internal::GenHashSeed());
+}
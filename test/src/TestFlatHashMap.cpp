@@ -0,0 +1,538 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+}
+
+namespace
+{
+
+/**
+ * @brief A hasher putting every key into a few buckets, so that long probe
+ *        sequences are built
+ *
+ */
+struct CollidingHash
+{
+	size_t operator()(int64_t val) const
+	{
+		return static_cast<size_t>(val % 3);
+	}
+}; // struct CollidingHash
+
+} // namespace
+
+GTEST_TEST(TestFlatHashMap, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestFlatHashMap, Basic)
+{
+	FlatHashMap<std::string, int> map;
+	EXPECT_TRUE(map.empty());
+	EXPECT_EQ(map.bucket_count(), 0);
+	EXPECT_TRUE(map.find("a") == map.end());
+	EXPECT_EQ(map.count("a"), 0);
+	EXPECT_THROW(map.at("a"), std::out_of_range);
+
+	auto res = map.emplace("a", 1);
+	EXPECT_TRUE(res.second);
+	EXPECT_EQ(res.first->first, "a");
+	EXPECT_EQ(res.first->second, 1);
+
+	res = map.emplace("a", 2);
+	EXPECT_FALSE(res.second);
+	EXPECT_EQ(res.first->second, 1);
+
+	EXPECT_TRUE(map.insert(std::make_pair(std::string("b"), 2)).second);
+	map["c"] = 3;
+	EXPECT_EQ(map["d"], 0);
+
+	EXPECT_EQ(map.size(), 4);
+	EXPECT_EQ(map.at("a"), 1);
+	EXPECT_EQ(map.at("b"), 2);
+	EXPECT_EQ(map.at("c"), 3);
+	EXPECT_EQ(map.count("d"), 1);
+
+	const auto& cmap = map;
+	EXPECT_EQ(cmap.find("b")->second, 2);
+	EXPECT_TRUE(cmap.find("e") == cmap.cend());
+
+	EXPECT_EQ(map.erase("d"), 1);
+	EXPECT_EQ(map.erase("d"), 0);
+	EXPECT_EQ(map.size(), 3);
+
+	map.clear();
+	EXPECT_TRUE(map.empty());
+	EXPECT_TRUE(map.begin() == map.end());
+	EXPECT_TRUE(map.find("a") == map.end());
+	EXPECT_TRUE(map.emplace("a", 5).second);
+	EXPECT_EQ(map.at("a"), 5);
+}
+
+GTEST_TEST(TestFlatHashMap, InsertionOrder)
+{
+	FlatHashMap<int64_t, int64_t> map;
+	for (int64_t i = 0; i < 100; ++i)
+	{
+		map.emplace(i * 1024, i);
+	}
+
+	int64_t expected = 0;
+	for (const auto& item : map)
+	{
+		EXPECT_EQ(item.first, expected * 1024);
+		EXPECT_EQ(item.second, expected);
+		++expected;
+	}
+	EXPECT_EQ(expected, 100);
+
+	// freed entries are reused by the next insertions
+	map.erase(10 * 1024);
+	map.emplace(-1, -1);
+	auto it = map.begin();
+	for (int64_t i = 0; i < 10; ++i)
+	{
+		++it;
+	}
+	EXPECT_EQ(it->first, -1);
+}
+
+GTEST_TEST(TestFlatHashMap, StableReferences)
+{
+	FlatHashMap<std::string, std::string> map;
+	map.emplace("key", "val");
+	const std::string* keyPtr = &(map.find("key")->first);
+	std::string* valPtr = &(map.find("key")->second);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		map.emplace(std::to_string(i), std::to_string(i));
+	}
+	EXPECT_EQ(keyPtr, &(map.find("key")->first));
+	EXPECT_EQ(valPtr, &(map.find("key")->second));
+	EXPECT_EQ(*valPtr, "val");
+}
+
+GTEST_TEST(TestFlatHashMap, Collisions)
+{
+	FlatHashMap<int64_t, int64_t, CollidingHash> map;
+	for (int64_t i = 0; i < 64; ++i)
+	{
+		EXPECT_TRUE(map.emplace(i, i * 2).second);
+	}
+	for (int64_t i = 0; i < 64; i += 2)
+	{
+		EXPECT_EQ(map.erase(i), 1);
+	}
+	EXPECT_EQ(map.size(), 32);
+	for (int64_t i = 0; i < 64; ++i)
+	{
+		if (i % 2 == 0)
+		{
+			EXPECT_TRUE(map.find(i) == map.end());
+		}
+		else
+		{
+			EXPECT_EQ(map.at(i), i * 2);
+		}
+	}
+}
+
+GTEST_TEST(TestFlatHashMap, RandomOps)
+{
+	FlatHashMap<int64_t, int64_t> map;
+	std::unordered_map<int64_t, int64_t> ref;
+	std::mt19937_64 rng(12345);
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		const int64_t key = static_cast<int64_t>(rng() % 2048);
+		switch (rng() % 3)
+		{
+		case 0:
+			EXPECT_EQ(map.emplace(key, i).second, ref.emplace(key, i).second);
+			break;
+		case 1:
+			map[key] = i;
+			ref[key] = i;
+			break;
+		default:
+			EXPECT_EQ(map.erase(key), ref.erase(key));
+			break;
+		}
+	}
+
+	ASSERT_EQ(map.size(), ref.size());
+	size_t count = 0;
+	for (const auto& item : map)
+	{
+		EXPECT_EQ(ref.at(item.first), item.second);
+		++count;
+	}
+	EXPECT_EQ(count, ref.size());
+}
+
+GTEST_TEST(TestFlatHashMap, EraseIterator)
+{
+	FlatHashMap<int64_t, int64_t> map;
+	for (int64_t i = 0; i < 50; ++i)
+	{
+		map.emplace(i, i);
+	}
+
+	for (auto it = map.begin(); it != map.end(); )
+	{
+		if (it->first % 3 == 0)
+		{
+			it = map.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+	EXPECT_EQ(map.size(), 33);
+	for (const auto& item : map)
+	{
+		EXPECT_NE(item.first % 3, 0);
+	}
+}
+
+GTEST_TEST(TestFlatHashMap, CopyMoveCompare)
+{
+	FlatHashMap<std::string, int> map1 = { { "a", 1 }, { "b", 2 }, { "c", 3 } };
+	map1.erase("b");
+
+	FlatHashMap<std::string, int> map2 = map1;
+	EXPECT_TRUE(map1 == map2);
+	map2.emplace("d", 4);
+	EXPECT_TRUE(map1 != map2);
+	EXPECT_EQ(map2.at("d"), 4);
+
+	FlatHashMap<std::string, int> map3 = { { "c", 3 }, { "a", 1 } };
+	EXPECT_TRUE(map1 == map3);
+	map3["a"] = 5;
+	EXPECT_TRUE(map1 != map3);
+
+	FlatHashMap<std::string, int> map4 = std::move(map2);
+	EXPECT_EQ(map4.size(), 3);
+	EXPECT_EQ(map2.size(), 0);
+	EXPECT_TRUE(map2.find("a") == map2.end());
+	map2.emplace("e", 5);
+	EXPECT_EQ(map2.at("e"), 5);
+
+	map4 = map1;
+	EXPECT_TRUE(map4 == map1);
+	map4 = std::move(map2);
+	EXPECT_EQ(map4.size(), 1);
+	EXPECT_EQ(map4.at("e"), 5);
+
+	map4.swap(map1);
+	EXPECT_EQ(map1.size(), 1);
+	EXPECT_EQ(map4.size(), 2);
+}
+
+GTEST_TEST(TestFlatHashMap, ArenaAllocator)
+{
+	using MapType = FlatHashMap<int64_t, std::string,
+		std::hash<int64_t>, std::equal_to<int64_t>,
+		ArenaAllocator<std::pair<const int64_t, std::string> > >;
+
+	MonotonicArena arena;
+	{
+		ArenaScope scope(arena);
+		MapType map;
+		for (int64_t i = 0; i < 100; ++i)
+		{
+			map.emplace(i, std::to_string(i));
+		}
+		EXPECT_GT(arena.GetAllocatedSize(), 0);
+		EXPECT_EQ(map.at(42), "42");
+	}
+}
+
+GTEST_TEST(TestFlatHashMap, FlatDict)
+{
+	FlatDict dict;
+	dict.InsertOrAssign(String("a"), Int64(1));
+	dict.InsertOrAssign(Int64(2), String("b"));
+	dict[String("c")] = Null();
+	EXPECT_EQ(dict.size(), 3);
+	EXPECT_EQ(dict[String("a")], Int64(1));
+	EXPECT_EQ(dict[Int64(2)], String("b"));
+	EXPECT_TRUE(dict.HasKey(String("c")));
+	EXPECT_FALSE(dict.HasKey(String("d")));
+	EXPECT_THROW(
+		static_cast<const FlatDict&>(dict)[String("d")], KeyError);
+
+	Dict ref;
+	ref.InsertOrAssign(Int64(2), String("b"));
+	ref.InsertOrAssign(String("c"), Null());
+	ref.InsertOrAssign(String("a"), Int64(1));
+	EXPECT_TRUE(dict == static_cast<const DictBaseObj&>(ref));
+
+	FlatDict copy = dict;
+	EXPECT_TRUE(copy == dict);
+	copy.Remove(String("a"));
+	EXPECT_EQ(copy.size(), 2);
+	EXPECT_FALSE(copy == dict);
+
+	// key-value pairs are iterated in insertion order
+	EXPECT_EQ(dict.DebugString(), "{ \"a\" : 1, 2 : \"b\", \"c\" : null }");
+
+	Object obj = dict;
+	EXPECT_EQ(obj.AsDict().size(), 3);
+}
+
+GTEST_TEST(TestFlatHashMap, OrderedHashMap)
+{
+	OrderedHashMap<int64_t, int64_t> map;
+	std::vector<int64_t> order;
+	std::mt19937_64 rng(54321);
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		const int64_t key = static_cast<int64_t>(rng() % 512);
+		if (rng() % 2 == 0)
+		{
+			if (map.emplace(key, i).second)
+			{
+				order.push_back(key);
+			}
+		}
+		else if (map.erase(key) == 1)
+		{
+			order.erase(std::find(order.begin(), order.end(), key));
+		}
+	}
+
+	// the order is kept across erases and compactions
+	ASSERT_EQ(map.size(), order.size());
+	size_t i = 0;
+	for (const auto& item : map)
+	{
+		EXPECT_EQ(item.first, order[i]);
+		++i;
+	}
+	EXPECT_EQ(i, order.size());
+
+	// erasing while iterating
+	for (auto it = map.begin(); it != map.end(); )
+	{
+		it = (it->first % 2 == 0) ? map.erase(it) : std::next(it);
+	}
+	order.erase(
+		std::remove_if(order.begin(), order.end(),
+			[](int64_t key) { return key % 2 == 0; }),
+		order.end());
+	i = 0;
+	for (const auto& item : map)
+	{
+		EXPECT_EQ(item.first, order[i]);
+		++i;
+	}
+	EXPECT_EQ(i, order.size());
+
+	// the entry of the last key is reclaimed by the next insertion
+	map.erase(order.back());
+	order.pop_back();
+	map.emplace(1000, 0);
+	order.push_back(1000);
+	auto copy = map;
+	i = 0;
+	for (const auto& item : copy)
+	{
+		EXPECT_EQ(item.first, order[i]);
+		++i;
+	}
+	EXPECT_EQ(i, order.size());
+}
+
+GTEST_TEST(TestFlatHashMap, OrderedDict)
+{
+	OrderedDict dict;
+	dict.InsertOrAssign(String("z"), Int64(1));
+	dict.InsertOrAssign(String("a"), Int64(2));
+	dict.InsertOrAssign(String("m"), Int64(3));
+	dict.Remove(String("a"));
+	dict.InsertOrAssign(String("b"), Int64(4));
+	dict.InsertOrAssign(String("z"), Int64(5));
+
+	EXPECT_EQ(dict.DebugString(), "{ \"z\" : 5, \"m\" : 3, \"b\" : 4 }");
+	EXPECT_EQ(dict.ShortDebugString(), "{\"z\":5,\"m\":3,\"b\":4}");
+	EXPECT_EQ(JsonWriter::Dump(dict), "{\"z\":5,\"m\":3,\"b\":4}");
+
+	std::vector<std::string> keys;
+	const DictBaseObj& dictBase = dict;
+	for (auto it = dictBase.KeysBegin(); it != dictBase.KeysEnd(); ++it)
+	{
+		keys.push_back(it->AsString().c_str());
+	}
+	EXPECT_EQ(keys, (std::vector<std::string>{ "z", "m", "b" }));
+
+	Dict ref;
+	ref.InsertOrAssign(String("b"), Int64(4));
+	ref.InsertOrAssign(String("m"), Int64(3));
+	ref.InsertOrAssign(String("z"), Int64(5));
+	EXPECT_TRUE(dict == static_cast<const DictBaseObj&>(ref));
+}
+
+GTEST_TEST(TestFlatHashMap, SmallHashMap)
+{
+	using MapType = SmallHashMap<int64_t, std::string, 4>;
+
+	MapType map;
+	EXPECT_TRUE(map.empty());
+	EXPECT_TRUE(map.begin() == map.end());
+	EXPECT_THROW(map.at(1), std::out_of_range);
+
+	for (int64_t i = 0; i < 4; ++i)
+	{
+		EXPECT_TRUE(map.emplace(i, std::to_string(i)).second);
+	}
+	EXPECT_FALSE(map.emplace(2, "x").second);
+	EXPECT_EQ(map.size(), 4);
+	EXPECT_EQ(map.at(2), "2");
+
+	// the slot of an erased pair is reused
+	EXPECT_EQ(map.erase(1), 1);
+	EXPECT_EQ(map.erase(1), 0);
+	map[10] = "10";
+	EXPECT_EQ(map.size(), 4);
+	EXPECT_EQ(std::distance(map.begin(), map.end()), 4);
+
+	// promoted to the hash table past the small capacity
+	MapType small = map;
+	map[11] = "11";
+	map.emplace(12, "12");
+	EXPECT_EQ(map.size(), 6);
+	for (int64_t key : { 0, 2, 3, 10, 11, 12 })
+	{
+		EXPECT_EQ(map.at(key), std::to_string(key));
+	}
+	EXPECT_TRUE(map != small);
+	map.erase(11);
+	map.erase(12);
+	EXPECT_TRUE(map == small);
+	EXPECT_TRUE(small == map);
+
+	for (auto it = map.begin(); it != map.end(); )
+	{
+		it = (it->first % 2 == 0) ? map.erase(it) : std::next(it);
+	}
+	EXPECT_EQ(map.size(), 1);
+	EXPECT_EQ(map.begin()->first, 3);
+
+	MapType moved = std::move(map);
+	EXPECT_EQ(moved.size(), 1);
+	EXPECT_TRUE(map.empty());
+	map = small;
+	EXPECT_TRUE(map == small);
+	map.swap(moved);
+	EXPECT_EQ(map.size(), 1);
+	EXPECT_TRUE(moved == small);
+
+	map.clear();
+	EXPECT_TRUE(map.empty());
+	EXPECT_TRUE(map.emplace(5, "5").second);
+	EXPECT_EQ(map.at(5), "5");
+
+	// random operations across promotions and clears
+	SmallHashMap<int64_t, int64_t, 8, CollidingHash> rmap;
+	std::unordered_map<int64_t, int64_t> ref;
+	std::mt19937_64 rng(54321);
+	for (int i = 0; i < 20000; ++i)
+	{
+		const int64_t key = static_cast<int64_t>(rng() % 12);
+		switch (rng() % 4)
+		{
+		case 0:
+			EXPECT_EQ(rmap.emplace(key, i).second, ref.emplace(key, i).second);
+			break;
+		case 1:
+			rmap[key] = i;
+			ref[key] = i;
+			break;
+		case 2:
+			EXPECT_EQ(rmap.erase(key), ref.erase(key));
+			break;
+		default:
+			if (i % 97 == 0)
+			{
+				rmap.clear();
+				ref.clear();
+			}
+			break;
+		}
+		ASSERT_EQ(rmap.size(), ref.size());
+	}
+	for (const auto& item : rmap)
+	{
+		EXPECT_EQ(ref.at(item.first), item.second);
+	}
+}
+
+GTEST_TEST(TestFlatHashMap, SmallDict)
+{
+	SmallDict dict;
+	dict.InsertOrAssign(String("a"), Int64(1));
+	dict.InsertOrAssign(Int64(2), String("b"));
+	dict[String("c")] = Null();
+	EXPECT_EQ(dict.size(), 3);
+	EXPECT_EQ(dict[String("a")], Int64(1));
+	EXPECT_EQ(dict["a"], Int64(1));
+	EXPECT_EQ(dict[Int64(2)], String("b"));
+	EXPECT_FALSE(dict.HasKey(String("d")));
+	EXPECT_THROW(
+		static_cast<const SmallDict&>(dict)[String("d")], KeyError);
+
+	Dict ref;
+	ref.InsertOrAssign(Int64(2), String("b"));
+	ref.InsertOrAssign(String("c"), Null());
+	ref.InsertOrAssign(String("a"), Int64(1));
+	EXPECT_TRUE(dict == static_cast<const DictBaseObj&>(ref));
+
+	SmallDict copy = dict;
+	for (int64_t i = 0; i < 20; ++i)
+	{
+		copy.InsertOrAssign(Int64(100 + i), Int64(i));
+		ref.InsertOrAssign(Int64(100 + i), Int64(i));
+	}
+	EXPECT_EQ(copy.size(), 23);
+	EXPECT_EQ(copy[Int64(119)], Int64(19));
+	EXPECT_TRUE(copy == static_cast<const DictBaseObj&>(ref));
+	EXPECT_FALSE(copy == dict);
+
+	Object obj = dict;
+	EXPECT_EQ(obj.AsDict().size(), 3);
+}
@@ -185,7 +185,9 @@ GTEST_TEST(TestHashableObj, Hash)
 	HashableObject objStr = String("Test");
 	std::string cppStr = "Test";
 
-	EXPECT_EQ(std::hash<HashableObject>()(objStr), std::hash<std::string>()(cppStr));
+	EXPECT_EQ(std::hash<HashableObject>()(objStr),
+		(Internal::DefaultHashPolicy::HashStr<char, std::char_traits<char> >(
+			cppStr.data(), cppStr.size())));
 }
 
 GTEST_TEST(TestHashableObj, Copy)
@@ -345,3 +347,36 @@ GTEST_TEST(TestHashableObj, Getters)
 	HashableObject d   = Double((std::numeric_limits<double>::max)());
 	EXPECT_TRUE(d.AsCppDouble() == (std::numeric_limits<double>::max)());
 }
+
+GTEST_TEST(TestHashableObj, InlineStorage)
+{
+	auto isStoredInPlace = [](
+		const HashableObject& wrapper, const BaseObj& payload) -> bool
+	{
+		const char* begin = reinterpret_cast<const char*>(&wrapper);
+		const char* ptr = reinterpret_cast<const char*>(&payload);
+		return (begin <= ptr) && (ptr < begin + sizeof(HashableObject));
+	};
+
+	HashableObject null;
+	EXPECT_TRUE(isStoredInPlace(null, null.AsNull()));
+	HashableObject i64 = Int64(12345);
+	EXPECT_TRUE(isStoredInPlace(i64, i64.AsRealNum()));
+	HashableObject str = String("Test");
+	EXPECT_TRUE(isStoredInPlace(str, str.AsString()));
+
+	HashableObject strCpy = str;
+	EXPECT_TRUE(isStoredInPlace(strCpy, strCpy.AsString()));
+	EXPECT_EQ(strCpy.Hash(), str.Hash());
+	HashableObject strMov = std::move(strCpy);
+	EXPECT_TRUE(isStoredInPlace(strMov, strMov.AsString()));
+	EXPECT_EQ(strMov, str);
+
+	strMov = i64;
+	EXPECT_TRUE(isStoredInPlace(strMov, strMov.AsRealNum()));
+	EXPECT_EQ(strMov.Hash(), i64.Hash());
+
+	HashableObject fromBase(static_cast<const HashableBaseObj&>(str));
+	EXPECT_EQ(fromBase, str);
+	EXPECT_EQ(fromBase.Hash(), str.Hash());
+}
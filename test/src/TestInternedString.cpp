@@ -0,0 +1,168 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+}
+
+GTEST_TEST(TestInternedString, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestInternedString, Interning)
+{
+	auto& table = InternedString::InternTable::GetInstance();
+
+	const std::string buf = "TestInternedString_Interning";
+	const InternedString str1(buf.data(), buf.size());
+	const size_t numEntries = table.size();
+
+	const InternedString str2(buf.c_str());
+	const InternedString str3((String(buf)));
+	EXPECT_EQ(table.size(), numEntries);
+	EXPECT_TRUE(str1.IsInterned());
+	EXPECT_NE(str1.data(), buf.data());
+	EXPECT_EQ(str1.data(), str2.data());
+	EXPECT_EQ(str1.data(), str3.data());
+	EXPECT_EQ(str1.c_str(), str1.data());
+	EXPECT_EQ(str1.GetInternedId(), str2.GetInternedId());
+
+	const InternedString other("TestInternedString_Interning_Other");
+	EXPECT_EQ(table.size(), numEntries + 1);
+	EXPECT_NE(str1.GetInternedId(), other.GetInternedId());
+	EXPECT_EQ(String(buf).GetInternedId(), nullptr);
+
+	EXPECT_EQ(InternedString().size(), 0);
+	EXPECT_FALSE(InternedString().IsTrue());
+	EXPECT_EQ(str1.GetCategory(), ObjCategory::String);
+	EXPECT_EQ(str1.DebugString(), "\"" + buf + "\"");
+	EXPECT_EQ(str1.ToString(), String(buf).ToString());
+	EXPECT_EQ(str1[4], 'I');
+	EXPECT_THROW(str1[buf.size()], IndexError);
+	EXPECT_EQ(std::string(str1.begin(), str1.end()), buf);
+
+	// it's small enough to be stored in place by the object wrappers
+	EXPECT_TRUE(HashableObject::IsInlineObj<InternedString>::value);
+}
+
+GTEST_TEST(TestInternedString, ConcurrentInterning)
+{
+	std::vector<const void*> ids(8, nullptr);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < ids.size(); ++i)
+	{
+		threads.emplace_back([&ids, i]()
+		{
+			for (size_t j = 0; j < 100; ++j)
+			{
+				InternedString str(("TestInternedString_Concurrent" +
+					std::to_string(j)).c_str());
+				(void)str;
+			}
+			ids[i] = InternedString(
+				"TestInternedString_Concurrent42").GetInternedId();
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	for (const void* id : ids)
+	{
+		EXPECT_EQ(id, ids[0]);
+	}
+}
+
+GTEST_TEST(TestInternedString, CompareAndHash)
+{
+	const InternedString istr = "abc";
+	const String str = "abc";
+
+	EXPECT_TRUE(istr == str);
+	EXPECT_TRUE(str == istr);
+	EXPECT_TRUE(istr == InternedString("abc"));
+	EXPECT_FALSE(istr == InternedString("abd"));
+	EXPECT_TRUE(istr < String("abd"));
+	EXPECT_TRUE(istr > String("ab"));
+	EXPECT_EQ(istr.Hash(), str.Hash());
+	EXPECT_EQ(std::hash<InternedString>()(istr), std::hash<String>()(str));
+
+	const HashableObject hobj1 = istr;
+	const HashableObject hobj2 = InternedString("abc");
+	EXPECT_TRUE(hobj1 == hobj2);
+	EXPECT_FALSE(hobj1 == HashableObject(InternedString("abd")));
+	EXPECT_TRUE(hobj1 == HashableObject(str));
+	EXPECT_TRUE(HashableObject(str) == hobj1);
+	EXPECT_FALSE(hobj1 == HashableObject(Int64(1)));
+
+	Dict dict = { { HashableObject(str), Int64(1) } };
+	EXPECT_EQ(dict[HashableObject(istr)], Int64(1));
+
+	FlatDict flatDict = { { HashableObject(istr), Int64(2) } };
+	EXPECT_EQ(flatDict[HashableObject(str)], Int64(2));
+	EXPECT_EQ(flatDict[HashableObject(InternedString("abc"))], Int64(2));
+	EXPECT_EQ(flatDict.find(HashableObject(InternedString("abd"))),
+		flatDict.end());
+}
+
+GTEST_TEST(TestInternedString, CopyOnWrite)
+{
+	InternedString str = "TestInternedString_CopyOnWrite";
+	InternedString str2 = str;
+
+	str.push_back('!');
+	EXPECT_FALSE(str.IsInterned());
+	EXPECT_EQ(str.GetInternedId(), nullptr);
+	EXPECT_EQ(str, String("TestInternedString_CopyOnWrite!"));
+	EXPECT_EQ(str.Hash(), String("TestInternedString_CopyOnWrite!").Hash());
+	EXPECT_TRUE(str2.IsInterned());
+	EXPECT_EQ(str2, String("TestInternedString_CopyOnWrite"));
+	EXPECT_EQ(InternedString("TestInternedString_CopyOnWrite"),
+		String("TestInternedString_CopyOnWrite"));
+
+	// a mutated string is still equal to the interned one with the same
+	// content
+	str.pop_back();
+	EXPECT_FALSE(str.IsInterned());
+	EXPECT_EQ(str, str2);
+	EXPECT_TRUE(HashableObject(str) == HashableObject(str2));
+	EXPECT_TRUE(HashableObject(str2) == HashableObject(str));
+
+	InternedString str3 = str;
+	EXPECT_FALSE(str3.IsInterned());
+	str3[0] = 'X';
+	EXPECT_EQ(str3, String("XestInternedString_CopyOnWrite"));
+	EXPECT_EQ(str, String("TestInternedString_CopyOnWrite"));
+
+	str3 = str2;
+	EXPECT_TRUE(str3.IsInterned());
+	str3.Set(InternedString("abc"));
+	EXPECT_EQ(str3, String("abc"));
+	EXPECT_THROW(str3.Set(String("abc")), TypeError);
+
+	Object obj = InternedString("abc");
+	EXPECT_EQ(obj.AsString().data(), InternedString("abc").data());
+	EXPECT_EQ(obj, String("abc"));
+}
@@ -302,3 +302,42 @@ GTEST_TEST(TestIterator, UpConversion)
 	EXPECT_TRUE(*itin == 'f');
 	EXPECT_NO_THROW(++itin);
 }
+
+GTEST_TEST(TestIterator, InlineStorage)
+{
+	using _String = StringImpl<std::string, std::string>;
+	using _ItWrap = CppStdRdIteratorWrap<
+		std::string::iterator, char, false, Internal::ItTransformDirect>;
+	using _Storage = RdIterator<char, false>::WrappedItStorage;
+
+	static_assert(_Storage::CanInline<_ItWrap>::value,
+		"Iterators of std containers should be stored inline.");
+
+	_String testStr = "abc";
+
+	// copies are independent from each other
+	auto it1 = testStr.begin();
+	auto it2 = it1;
+	++it2;
+	EXPECT_TRUE(*it1 == 'a');
+	EXPECT_TRUE(*it2 == 'b');
+	EXPECT_TRUE(it2 - it1 == 1);
+
+	it1 = it2;
+	EXPECT_TRUE(it1 == it2);
+	++it2;
+	EXPECT_TRUE(*it1 == 'b');
+	EXPECT_TRUE(*it2 == 'c');
+
+	auto it3 = std::move(it2);
+	EXPECT_TRUE(*it3 == 'c');
+	EXPECT_TRUE(++it3 == testStr.end());
+
+	// constructed from a heap allocated iterator
+	std::string stdStr = "ab";
+	auto it4 = RdIterator<char, false>(_ItWrap::Build(stdStr.begin()));
+	auto it5 = it4;
+	++it5;
+	EXPECT_TRUE(*it4 == 'a');
+	EXPECT_TRUE(*it5 == 'b');
+}
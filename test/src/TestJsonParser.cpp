@@ -0,0 +1,283 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+}
+
+GTEST_TEST(TestJsonParser, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestJsonParser, Literals)
+{
+	EXPECT_EQ(JsonParser::Parse("null"), Null());
+	EXPECT_EQ(JsonParser::Parse(" true "), Bool(true));
+	EXPECT_EQ(JsonParser::Parse("\tfalse\n"), Bool(false));
+
+	EXPECT_THROW(JsonParser::Parse("nul"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("tru e"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("True"), ParseError);
+	EXPECT_THROW(JsonParser::Parse(""), ParseError);
+	EXPECT_THROW(JsonParser::Parse("  "), ParseError);
+}
+
+GTEST_TEST(TestJsonParser, Numbers)
+{
+	Object obj = JsonParser::Parse("0");
+	EXPECT_EQ(obj.AsRealNum().GetNumType(), RealNumType::Int64);
+	EXPECT_EQ(obj, Int64(0));
+
+	EXPECT_EQ(JsonParser::Parse("-123"), Int64(-123));
+	EXPECT_EQ(
+		JsonParser::Parse("9223372036854775807"),
+		Int64(9223372036854775807LL));
+	EXPECT_EQ(
+		JsonParser::Parse("-9223372036854775808").AsCppInt64(),
+		std::numeric_limits<int64_t>::min());
+
+	obj = JsonParser::Parse("18446744073709551615");
+	EXPECT_EQ(obj.AsRealNum().GetNumType(), RealNumType::UInt64);
+	EXPECT_EQ(obj.AsCppUInt64(), std::numeric_limits<uint64_t>::max());
+
+	// out of range of any integer type
+	obj = JsonParser::Parse("18446744073709551616");
+	EXPECT_EQ(obj.AsRealNum().GetNumType(), RealNumType::Double);
+	EXPECT_EQ(obj.AsCppDouble(), 18446744073709551616.0);
+	obj = JsonParser::Parse("-9223372036854775809");
+	EXPECT_EQ(obj.AsRealNum().GetNumType(), RealNumType::Double);
+
+	obj = JsonParser::Parse("1.5");
+	EXPECT_EQ(obj.AsRealNum().GetNumType(), RealNumType::Double);
+	EXPECT_EQ(obj.AsCppDouble(), 1.5);
+	EXPECT_EQ(JsonParser::Parse("-0.25e2").AsCppDouble(), -25.0);
+	EXPECT_EQ(JsonParser::Parse("1E+2").AsCppDouble(), 100.0);
+	EXPECT_EQ(JsonParser::Parse("125e-3").AsCppDouble(), 0.125);
+
+	EXPECT_THROW(JsonParser::Parse("-"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("01"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("1."), ParseError);
+	EXPECT_THROW(JsonParser::Parse(".5"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("1.e2"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("1e"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("1e+"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("+1"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("-a"), ParseError);
+}
+
+GTEST_TEST(TestJsonParser, Strings)
+{
+	EXPECT_EQ(JsonParser::Parse("\"\""), String(""));
+	EXPECT_EQ(JsonParser::Parse("\"abc\""), String("abc"));
+	EXPECT_EQ(
+		JsonParser::Parse("\"a\\\"b\\\\c\\/d\\b\\f\\n\\r\\t\""),
+		String("a\"b\\c/d\b\f\n\r\t"));
+
+	// unicode escapes
+	EXPECT_EQ(JsonParser::Parse("\"\\u0041\""), String("A"));
+	EXPECT_EQ(JsonParser::Parse("\"\\u00e9\""), String("\xC3\xA9"));
+	EXPECT_EQ(JsonParser::Parse("\"\\u4E2D\""), String("\xE4\xB8\xAD"));
+	EXPECT_EQ(
+		JsonParser::Parse("\"\\ud83d\\ude00\""),
+		String("\xF0\x9F\x98\x80"));
+	// raw UTF-8 is kept as it is
+	EXPECT_EQ(JsonParser::Parse("\"\xE4\xB8\xAD\""), String("\xE4\xB8\xAD"));
+
+	EXPECT_THROW(JsonParser::Parse("\"abc"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("\"abc\\"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("\"\\x\""), ParseError);
+	EXPECT_THROW(JsonParser::Parse("\"\\u12\""), ParseError);
+	EXPECT_THROW(JsonParser::Parse("\"\\u12G4\""), ParseError);
+	EXPECT_THROW(JsonParser::Parse("\"\\ud83d\""), ParseError);
+	EXPECT_THROW(JsonParser::Parse("\"\\ud83d\\u0041\""), ParseError);
+	EXPECT_THROW(JsonParser::Parse("\"\\ude00\""), ParseError);
+	EXPECT_THROW(JsonParser::Parse("\"a\nb\""), ParseError);
+}
+
+GTEST_TEST(TestJsonParser, Containers)
+{
+	EXPECT_EQ(JsonParser::Parse("[]"), List());
+	EXPECT_EQ(JsonParser::Parse("{}"), Dict());
+	EXPECT_EQ(
+		JsonParser::Parse("[1, \"a\", null, [true, []]]"),
+		List({
+			Int64(1), String("a"), Null(),
+			List({ Bool(true), List() }),
+		}));
+	EXPECT_EQ(
+		JsonParser::Parse(
+			"{\"a\": 1, \"b\": {\"c\": [false]}, \"d\": {}}"),
+		Dict({
+			{ String("a"), Int64(1) },
+			{ String("b"), Dict({
+				{ String("c"), List({ Bool(false) }) },
+			}) },
+			{ String("d"), Dict() },
+		}));
+
+	// duplicate keys - the first one is kept
+	EXPECT_EQ(
+		JsonParser::Parse("{\"a\": 1, \"a\": 2}"),
+		Dict({ { String("a"), Int64(1) } }));
+
+	// nesting depth is not bounded by the call stack of the parser
+	const size_t depth = 10000;
+	std::string nested = std::string(depth, '[') + std::string(depth, ']');
+	Object obj = JsonParser::Parse(nested);
+	EXPECT_EQ(obj.AsList().size(), 1);
+
+	EXPECT_THROW(JsonParser::Parse("["), ParseError);
+	EXPECT_THROW(JsonParser::Parse("[1"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("[1,]"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("[,1]"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("[1 2]"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("[1}"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("{\"a\" 1}"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("{\"a\": 1,}"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("{1: 1}"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("{\"a\": 1]"), ParseError);
+	EXPECT_THROW(JsonParser::Parse("[] []"), ParseError);
+}
+
+GTEST_TEST(TestJsonParser, ErrorPosition)
+{
+	try
+	{
+		JsonParser::Parse("[1, 2, x]");
+		FAIL() << "ParseError is not thrown";
+	}
+	catch (const ParseError& e)
+	{
+		EXPECT_EQ(e.GetPos(), 7);
+	}
+
+	// the position is counted across chunks
+	JsonParser parser;
+	parser.Feed("[\"abc", 5);
+	try
+	{
+		parser.Feed("\", ?", 4);
+		FAIL() << "ParseError is not thrown";
+	}
+	catch (const ParseError& e)
+	{
+		EXPECT_EQ(e.GetPos(), 8);
+	}
+}
+
+GTEST_TEST(TestJsonParser, Incremental)
+{
+	const std::string json =
+		"{\"key\\u00e9\": [12345, -6.5e-1, \"str\\\"ing\\ud83d\\ude00\"],"
+		" \"t\": true, \"f\": false, \"n\": null, \"big\": 18446744073709551615}";
+	const Object expected = JsonParser::Parse(json);
+	EXPECT_EQ(expected.AsDict().size(), 5);
+
+	// every possible chunk size, so that every token is split at every
+	// possible position
+	for (size_t chunkSize = 1; chunkSize <= json.size(); ++chunkSize)
+	{
+		JsonParser parser;
+		for (size_t i = 0; i < json.size(); i += chunkSize)
+		{
+			parser.Feed(
+				json.data() + i, std::min(chunkSize, json.size() - i));
+		}
+		EXPECT_EQ(parser.Finish(), expected) << "chunk size: " << chunkSize;
+	}
+
+	// a number at the end of a chunk may continue in the next one
+	JsonParser parser;
+	parser.Feed("12");
+	parser.Feed("34");
+	EXPECT_EQ(parser.Finish(), Int64(1234));
+
+	// the parser is reusable after Finish and Reset
+	parser.Feed("[1, 2");
+	parser.Reset();
+	parser.Feed("\"abc\"");
+	EXPECT_EQ(parser.Finish(), String("abc"));
+}
+
+GTEST_TEST(TestJsonParser, Stream)
+{
+	std::string json = "[";
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		json += (i == 0 ? "" : ",") + std::string("{\"id\": ") +
+			std::to_string(i) + ", \"name\": \"item" + std::to_string(i) +
+			"\"}";
+	}
+	json += "]";
+
+	std::istringstream stream(json);
+	Object obj = JsonParser::Parse(stream);
+	const auto& list = obj.AsList();
+	ASSERT_EQ(list.size(), 2000);
+	EXPECT_EQ(list[1999].AsDict()[String("id")], Int64(1999));
+	EXPECT_EQ(list[1999].AsDict()[String("name")], String("item1999"));
+}
+
+GTEST_TEST(TestJsonParser, InternKeys)
+{
+	const std::string json =
+		"[{\"id\": 1, \"k\\u00e9y\": \"id\"}, {\"id\": 2, \"k\\u00e9y\": 3}]";
+
+	JsonParser parser(true);
+	EXPECT_TRUE(parser.IsInterningKeys());
+	EXPECT_FALSE(JsonParser().IsInterningKeys());
+	parser.Feed(json);
+	const Object obj = parser.Finish();
+	EXPECT_EQ(obj, JsonParser::Parse(json));
+
+	const auto& list = obj.AsList();
+	const auto& dict1 = list[0].AsDict();
+	const auto& dict2 = list[1].AsDict();
+	EXPECT_EQ(dict1[String("id")], Int64(1));
+	EXPECT_EQ(dict2[String("k\xc3\xa9y")], Int64(3));
+
+	// keys with the same content share the same interned string,
+	// including the ones with escape sequences
+	for (const char* key : { "id", "k\xc3\xa9y" })
+	{
+		const void* id = InternedString(key).GetInternedId();
+		size_t count = 0;
+		for (const auto& dict : { std::cref(dict1), std::cref(dict2) })
+		{
+			for (auto it = dict.get().cbegin(); it != dict.get().cend(); ++it)
+			{
+				const auto& dictKey = (*std::get<0>(*it)).AsString();
+				if (dictKey == String(key))
+				{
+					EXPECT_EQ(dictKey.GetInternedId(), id);
+					++count;
+				}
+			}
+		}
+		EXPECT_EQ(count, 2);
+	}
+
+	// values are not interned
+	EXPECT_EQ(dict1[String("k\xc3\xa9y")].AsString().GetInternedId(), nullptr);
+}
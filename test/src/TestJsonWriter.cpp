@@ -0,0 +1,170 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+}
+
+GTEST_TEST(TestJsonWriter, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestJsonWriter, Scalars)
+{
+	EXPECT_EQ(JsonWriter::Dump(Null()), "null");
+	EXPECT_EQ(JsonWriter::Dump(Bool(true)), "true");
+	EXPECT_EQ(JsonWriter::Dump(Bool(false)), "false");
+
+	EXPECT_EQ(JsonWriter::Dump(Int8(-128)), "-128");
+	EXPECT_EQ(JsonWriter::Dump(UInt8(255)), "255");
+	EXPECT_EQ(JsonWriter::Dump(Int32(0)), "0");
+	EXPECT_EQ(JsonWriter::Dump(Int32(7)), "7");
+	EXPECT_EQ(JsonWriter::Dump(Int32(-42)), "-42");
+	EXPECT_EQ(JsonWriter::Dump(UInt32(1000)), "1000");
+	EXPECT_EQ(
+		JsonWriter::Dump(Int64(std::numeric_limits<int64_t>::min())),
+		"-9223372036854775808");
+	EXPECT_EQ(
+		JsonWriter::Dump(UInt64(std::numeric_limits<uint64_t>::max())),
+		"18446744073709551615");
+
+	// real numbers have the same format as ToString
+	EXPECT_EQ(JsonWriter::Dump(Double(0.0)), "0.0");
+	EXPECT_EQ(JsonWriter::Dump(Double(-0.0)), "-0.0");
+	EXPECT_EQ(JsonWriter::Dump(Double(1.5)), "1.5");
+	EXPECT_EQ(JsonWriter::Dump(Double(-1e30)), Double(-1e30).ToString());
+	EXPECT_EQ(JsonWriter::Dump(Double(1.234e-7)), Double(1.234e-7).ToString());
+	EXPECT_EQ(JsonWriter::Dump(Float(0.1f)), Float(0.1f).ToString());
+
+	EXPECT_THROW(
+		JsonWriter::Dump(Double(std::numeric_limits<double>::infinity())),
+		TypeError);
+	EXPECT_THROW(
+		JsonWriter::Dump(Double(std::numeric_limits<double>::quiet_NaN())),
+		TypeError);
+}
+
+GTEST_TEST(TestJsonWriter, Strings)
+{
+	EXPECT_EQ(JsonWriter::Dump(String("")), "\"\"");
+	EXPECT_EQ(JsonWriter::Dump(String("abc")), "\"abc\"");
+	EXPECT_EQ(
+		JsonWriter::Dump(String("a\"b\\c/d\b\f\n\r\t")),
+		"\"a\\\"b\\\\c/d\\b\\f\\n\\r\\t\"");
+	EXPECT_EQ(
+		JsonWriter::Dump(String(std::string("\x01\x1F\0", 3))),
+		"\"\\u0001\\u001f\\u0000\"");
+	// UTF-8 is kept as it is
+	EXPECT_EQ(JsonWriter::Dump(String("\xE4\xB8\xAD")), "\"\xE4\xB8\xAD\"");
+}
+
+GTEST_TEST(TestJsonWriter, Containers)
+{
+	EXPECT_EQ(JsonWriter::Dump(List()), "[]");
+	EXPECT_EQ(JsonWriter::Dump(Dict()), "{}");
+	EXPECT_EQ(
+		JsonWriter::Dump(List({
+			Int64(1), String("a"), Null(),
+			List({ Bool(true), List() }),
+		})),
+		"[1,\"a\",null,[true,[]]]");
+	EXPECT_EQ(
+		JsonWriter::Dump(Dict({ { String("a"), List({ Int64(1) }) } })),
+		"{\"a\":[1]}");
+
+	// wrapped in Object
+	EXPECT_EQ(
+		JsonWriter::Dump(Object(List({ Object(Dict()), Object(Int32(3)) }))),
+		"[{},3]");
+
+	// static dict
+	using SDict = StaticDict<std::tuple<
+		std::pair<StrKey<SIMOBJ_KSTR("Key1")>, Int64>,
+		std::pair<StrKey<SIMOBJ_KSTR("Key2")>, String> > >;
+	SDict sDict;
+	sDict.get<StrKey<SIMOBJ_KSTR("Key1")> >() = Int64(12);
+	sDict.get<StrKey<SIMOBJ_KSTR("Key2")> >() = String("val");
+	EXPECT_EQ(JsonWriter::Dump(sDict), "{\"Key1\":12,\"Key2\":\"val\"}");
+
+	EXPECT_THROW(JsonWriter::Dump(Bytes({ 1, 2 })), TypeError);
+	EXPECT_THROW(JsonWriter::Dump(List({ Bytes() })), TypeError);
+	EXPECT_THROW(
+		JsonWriter::Dump(Dict({ { Int64(1), Int64(1) } })),
+		TypeError);
+}
+
+GTEST_TEST(TestJsonWriter, Pretty)
+{
+	EXPECT_EQ(JsonWriter::DumpPretty(List()), "[]");
+	EXPECT_EQ(JsonWriter::DumpPretty(Dict()), "{}");
+	EXPECT_EQ(
+		JsonWriter::DumpPretty(List({
+			Int64(1),
+			Dict({ { String("a"), List({ Null(), List() }) } }),
+		})),
+		"[\n"
+		"    1,\n"
+		"    {\n"
+		"        \"a\": [\n"
+		"            null,\n"
+		"            []\n"
+		"        ]\n"
+		"    }\n"
+		"]");
+	EXPECT_EQ(
+		JsonWriter::DumpPretty(List({ Int64(1), Int64(2) }), 2),
+		"[\n  1,\n  2\n]");
+}
+
+GTEST_TEST(TestJsonWriter, Append)
+{
+	JsonWriter writer;
+	std::string out = "prefix:";
+	writer.Write(List({ Int64(1) }), out);
+	EXPECT_EQ(out, "prefix:[1]");
+
+	// the output is rolled back if it fails
+	EXPECT_THROW(writer.Write(List({ Int64(2), Bytes() }), out), TypeError);
+	EXPECT_EQ(out, "prefix:[1]");
+
+	// large output, which grows the buffer several times
+	List list;
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		list.push_back(String(std::string(i % 50, 'x') + "\n"));
+	}
+	std::string json = writer.Write(list);
+	EXPECT_EQ(JsonParser::Parse(json), list);
+}
+
+GTEST_TEST(TestJsonWriter, RoundTrip)
+{
+	const std::string json =
+		"{\"list\":[1,-2,3.25,true,false,null,\"s\\\"\\u0001\"],"
+		"\"dict\":{\"nested\":{}},\"big\":18446744073709551615}";
+	Object obj = JsonParser::Parse(json);
+
+	EXPECT_EQ(JsonParser::Parse(JsonWriter::Dump(obj)), obj);
+	EXPECT_EQ(JsonParser::Parse(JsonWriter::DumpPretty(obj)), obj);
+}
@@ -324,6 +324,23 @@ GTEST_TEST(TestList, Iterator)
 	}
 }
 
+GTEST_TEST(TestList, NativeIterator)
+{
+	List cpLs = {String("Test String"), Bool(true), Int64(12345)};
+	const List& kCpLs = cpLs;
+
+	EXPECT_EQ(kCpLs.NativeEnd() - kCpLs.NativeBegin(), 3);
+	EXPECT_EQ(&(*kCpLs.NativeBegin()), kCpLs.data());
+	EXPECT_EQ(
+		std::find(kCpLs.NativeBegin(), kCpLs.NativeEnd(), Bool(true)) -
+			kCpLs.NativeBegin(),
+		1);
+
+	std::reverse(cpLs.NativeBegin(), cpLs.NativeEnd());
+	EXPECT_EQ(cpLs,
+		List({Int64(12345), Bool(true), String("Test String")}));
+}
+
 GTEST_TEST(TestList, At)
 {
 	const std::vector<Object> testLs = {String("Test String"), Bool(true), Int64(12345)};
@@ -393,6 +410,9 @@ GTEST_TEST(TestList, Data)
 	//Data
 	List nkLs{String("Test String"),};
 	EXPECT_EQ(nkLs.data(), &nkLs[0]);
+
+	nkLs.data()[0] = Int64(1);
+	EXPECT_EQ(nkLs, List({Int64(1)}));
 }
 
 GTEST_TEST(TestList, InsertRemove)
@@ -548,6 +568,33 @@ GTEST_TEST(TestList, BaseListIterators)
 	}
 }
 
+GTEST_TEST(TestList, BaseListForEach)
+{
+	auto testLs = List({ Null(), Int64(123), String("test"), });
+
+	{
+		const ListBaseObj& testLsB = testLs;
+		List visited;
+		testLsB.ForEach([&](const BaseObj& val)
+		{
+			visited.push_back(Object(val));
+		});
+		EXPECT_EQ(visited, testLs);
+	}
+
+	{
+		ListBaseObj& testLsB = testLs;
+		testLsB.ForEach([](BaseObj& val)
+		{
+			if (val.GetCategory() == ObjCategory::String)
+			{
+				val.AsString().push_back('Y');
+			}
+		});
+		EXPECT_EQ(testLs[2], String("testY"));
+	}
+}
+
 GTEST_TEST(TestList, BaseListIndexing)
 {
 
@@ -635,3 +682,53 @@ GTEST_TEST(TestList, BaseListPushBackAppend)
 				Bool(true), Double(0.0), }));
 	}
 }
+
+GTEST_TEST(TestList, BaseListSameTypeCompare)
+{
+	const List a = { Int64(1), List({ String("x"), Double(2.0) }) };
+	const List b = { Double(1.0), List({ String("x"), Int64(2) }) };
+	const List c = { Int64(1), List({ String("x"), Int64(3) }) };
+	const ListBaseObj& baseA = a;
+
+	// numbers of different types are still compared by values
+	EXPECT_TRUE(baseA == static_cast<const ListBaseObj&>(b));
+	EXPECT_FALSE(baseA == static_cast<const ListBaseObj&>(c));
+	EXPECT_EQ(a.BaseObjectCompare(b), ObjectOrder::Equal);
+	EXPECT_EQ(a.BaseObjectCompare(c), ObjectOrder::Less);
+	EXPECT_EQ(c.BaseObjectCompare(a), ObjectOrder::Greater);
+
+	// lists of different concrete types
+	const ListT<Int64> d = { Int64(1) };
+	EXPECT_FALSE(baseA == static_cast<const ListBaseObj&>(d));
+	EXPECT_EQ(d.BaseObjectCompare(a), ObjectOrder::Less);
+	EXPECT_TRUE(static_cast<const BaseObj&>(d) == List({ Int64(1) }));
+
+	const Tuple ta = { Int64(1), String("x") };
+	const Tuple tb = { Double(1.0), String("x") };
+	EXPECT_TRUE(static_cast<const BaseObj&>(ta) == tb);
+	EXPECT_EQ(ta.BaseObjectCompare(Tuple({ Int64(1), String("y") })),
+		ObjectOrder::Less);
+}
+
+GTEST_TEST(TestList, Allocator)
+{
+	MonotonicArena arena;
+	ArenaAllocator<Object> alloc(&arena);
+
+	auto list = MakeList(alloc);
+	EXPECT_EQ(list.GetVal().get_allocator(), alloc);
+	list.push_back(Int64(1));
+	list.push_back(String("2"));
+	list.push_back(Null());
+	EXPECT_GE(arena.GetAllocatedSize(), 3 * sizeof(Object));
+
+	EXPECT_TRUE(list.BaseObjectIsEqual(
+		List({ Int64(1), String("2"), Null(), })));
+
+	// copies and moves
+	auto listMov = std::move(list);
+	EXPECT_EQ(listMov.GetVal().get_allocator(), alloc);
+	auto listCpy = listMov;
+	EXPECT_EQ(listCpy.GetVal().get_allocator().GetArena(), nullptr);
+	EXPECT_EQ(listCpy, listMov);
+}
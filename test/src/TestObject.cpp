@@ -382,3 +382,134 @@ GTEST_TEST(TestObject, Getters)
 	Object d   = Double((std::numeric_limits<double>::max)());
 	EXPECT_TRUE(d.AsCppDouble() == (std::numeric_limits<double>::max)());
 }
+
+namespace
+{
+
+template<typename _WrapperType, typename _PayloadType>
+bool IsStoredInPlace(const _WrapperType& wrapper, const _PayloadType& payload)
+{
+	const char* begin = reinterpret_cast<const char*>(&wrapper);
+	const char* ptr = reinterpret_cast<const char*>(&payload);
+	return (begin <= ptr) && (ptr < begin + sizeof(_WrapperType));
+}
+
+} // namespace
+
+GTEST_TEST(TestObject, InlineStorage)
+{
+	// small objects are stored in place
+	Object null;
+	EXPECT_TRUE(IsStoredInPlace(null, null.AsNull()));
+	Object i64 = Int64(12345);
+	EXPECT_TRUE(IsStoredInPlace(i64, i64.AsRealNum()));
+	Object str = String("Test");
+	EXPECT_TRUE(IsStoredInPlace(str, str.AsString()));
+	Object bytes = Bytes({ 0x01U, 0x02U, 0x03U, });
+	EXPECT_TRUE(IsStoredInPlace(bytes, bytes.AsBytes()));
+
+	// large objects are stored on the heap
+	Object dict = Dict({
+		{ String("key"), Int64(12345) },
+	});
+	EXPECT_FALSE(IsStoredInPlace(dict, dict.AsDict()));
+	EXPECT_EQ(dict.AsDict().size(), 1);
+
+	// copy keeps the storage location
+	Object strCpy = str;
+	EXPECT_TRUE(IsStoredInPlace(strCpy, strCpy.AsString()));
+	EXPECT_EQ(strCpy, str);
+	Object dictCpy = dict;
+	EXPECT_FALSE(IsStoredInPlace(dictCpy, dictCpy.AsDict()));
+	EXPECT_EQ(dictCpy, dict);
+
+	// move
+	Object strMov = std::move(strCpy);
+	EXPECT_TRUE(IsStoredInPlace(strMov, strMov.AsString()));
+	EXPECT_EQ(strMov, str);
+	const BaseObj* dictPtr = &dict.AsDict();
+	Object dictMov = std::move(dictCpy);
+	EXPECT_EQ(dictMov, dict);
+	EXPECT_EQ(&dict.AsDict(), dictPtr);
+
+	// assignment between different storage locations
+	strMov = dict;
+	EXPECT_FALSE(IsStoredInPlace(strMov, strMov.AsDict()));
+	EXPECT_EQ(strMov, dict);
+	dictMov = str;
+	EXPECT_TRUE(IsStoredInPlace(dictMov, dictMov.AsString()));
+	EXPECT_EQ(dictMov, str);
+	dictMov = Int64(12345);
+	EXPECT_TRUE(IsStoredInPlace(dictMov, dictMov.AsRealNum()));
+	EXPECT_EQ(dictMov, i64);
+
+	// copy from type-erased objects
+	Object fromBase(static_cast<const BaseObj&>(str));
+	EXPECT_EQ(fromBase, str);
+	Object fromObj(static_cast<const BaseObj&>(i64));
+	EXPECT_TRUE(IsStoredInPlace(fromObj, fromObj.AsRealNum()));
+	EXPECT_EQ(fromObj, i64);
+
+	// self assignment
+	str = str.AsString();
+	EXPECT_EQ(str, Object(String("Test")));
+	str = static_cast<const String&>(str.AsString());
+	EXPECT_EQ(str, Object(String("Test")));
+}
+
+GTEST_TEST(TestObject, TaggedAccessors)
+{
+	// the category is updated every time the wrapped object is replaced
+	Object obj;
+	EXPECT_TRUE(obj.IsNull());
+	obj = Int8(-1);
+	EXPECT_FALSE(obj.IsNull());
+	EXPECT_EQ(obj.GetCategory(), ObjCategory::Integer);
+	EXPECT_EQ(obj.AsCppInt64(), -1);
+	EXPECT_EQ(obj.AsCppDouble(), -1.0);
+	EXPECT_TRUE(obj.IsTrue());
+	obj = Object(String("Test"));
+	EXPECT_EQ(obj.GetCategory(), ObjCategory::String);
+	EXPECT_THROW(obj.AsCppInt64(), TypeError);
+	obj = static_cast<const BaseObj&>(Double(1.5));
+	EXPECT_EQ(obj.GetCategory(), ObjCategory::Real);
+	EXPECT_EQ(obj.AsCppDouble(), 1.5);
+	obj = Object(Int64(0).Copy(Object::sk_null));
+	EXPECT_EQ(obj.GetCategory(), ObjCategory::Integer);
+	EXPECT_FALSE(obj.IsTrue());
+	obj = Bool(true);
+	EXPECT_EQ(obj.GetCategory(), ObjCategory::Bool);
+	EXPECT_EQ(obj.AsCppUInt8(), 1);
+
+	// moved-from object
+	Object objMov = std::move(obj);
+	EXPECT_EQ(objMov.GetCategory(), ObjCategory::Bool);
+	obj = List();
+	EXPECT_EQ(obj.GetCategory(), ObjCategory::List);
+	EXPECT_THROW(obj.AsCppUInt64(), TypeError);
+	EXPECT_FALSE(obj.IsTrue());
+
+	// results are the same as the ones given by the wrapped object
+	std::vector<Object> nums = {
+		Bool(true),
+		Int8(-12), Int16(-1234), Int32(-123456), Int64(-1234567890123LL),
+		UInt8(12), UInt16(1234), UInt32(123456), UInt64(1234567890123ULL),
+		Float(1.25f), Double(-2.5),
+	};
+	for (const auto& num : nums)
+	{
+		const RealNumBaseObj& val = num.AsRealNum();
+		EXPECT_EQ(num.IsTrue(),      val.IsTrue());
+		EXPECT_EQ(num.AsCppDouble(), val.AsCppDouble());
+		EXPECT_EQ(num.AsCppInt64(),  val.AsCppInt64());
+		if (val.AsCppDouble() >= 0)
+		{
+			EXPECT_EQ(num.AsCppUInt64(), val.AsCppUInt64());
+		}
+		else
+		{
+			EXPECT_THROW(num.AsCppUInt64(), TypeError);
+			EXPECT_THROW(val.AsCppUInt64(), TypeError);
+		}
+	}
+}
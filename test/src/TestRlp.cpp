@@ -0,0 +1,209 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <vector>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+}
+
+namespace
+{
+
+std::vector<uint8_t> BytesOfStr(const std::string& str)
+{
+	return std::vector<uint8_t>(str.begin(), str.end());
+}
+
+} // namespace
+
+GTEST_TEST(TestRlp, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestRlp, EncodeBytes)
+{
+	using Vec = std::vector<uint8_t>;
+
+	EXPECT_EQ(RlpEncoder::Encode(Bytes()), Vec({ 0x80 }));
+	EXPECT_EQ(RlpEncoder::Encode(Bytes({ 0x00 })), Vec({ 0x00 }));
+	EXPECT_EQ(RlpEncoder::Encode(Bytes({ 0x7F })), Vec({ 0x7F }));
+	EXPECT_EQ(RlpEncoder::Encode(Bytes({ 0x80 })), Vec({ 0x81, 0x80 }));
+	EXPECT_EQ(
+		RlpEncoder::Encode(Bytes({ 'd', 'o', 'g' })),
+		Vec({ 0x83, 'd', 'o', 'g' }));
+
+	// 55 bytes - the longest short form
+	Vec data55(55, 0xAA);
+	Vec expected = { 0xB7 };
+	expected.insert(expected.end(), data55.begin(), data55.end());
+	EXPECT_EQ(RlpEncoder::Encode(Bytes(data55.begin(), data55.end())), expected);
+
+	// 56 bytes - the shortest long form
+	Vec data56(56, 0xAA);
+	expected = { 0xB8, 56 };
+	expected.insert(expected.end(), data56.begin(), data56.end());
+	EXPECT_EQ(RlpEncoder::Encode(Bytes(data56.begin(), data56.end())), expected);
+
+	Vec data1024(1024, 0x55);
+	expected = { 0xB9, 0x04, 0x00 };
+	expected.insert(expected.end(), data1024.begin(), data1024.end());
+	EXPECT_EQ(
+		RlpEncoder::Encode(Bytes(data1024.begin(), data1024.end())),
+		expected);
+}
+
+GTEST_TEST(TestRlp, EncodeList)
+{
+	using Vec = std::vector<uint8_t>;
+
+	EXPECT_EQ(RlpEncoder::Encode(List()), Vec({ 0xC0 }));
+	EXPECT_EQ(
+		RlpEncoder::Encode(List({
+			Bytes({ 'c', 'a', 't' }), Bytes({ 'd', 'o', 'g' }) })),
+		Vec({ 0xC8, 0x83, 'c', 'a', 't', 0x83, 'd', 'o', 'g' }));
+
+	// the set theoretical representation of three
+	EXPECT_EQ(
+		RlpEncoder::Encode(List({
+			List(),
+			List({ List() }),
+			List({ List(), List({ List() }) }),
+		})),
+		Vec({ 0xC7, 0xC0, 0xC1, 0xC0, 0xC3, 0xC0, 0xC1, 0xC0 }));
+
+	// long list
+	std::string lorem =
+		"Lorem ipsum dolor sit amet, consectetur adipisicing elit";
+	Vec loremBytes = BytesOfStr(lorem);
+	Vec expected = { 0xF8, 0x3A, 0xB8, 0x38 };
+	expected.insert(expected.end(), loremBytes.begin(), loremBytes.end());
+	EXPECT_EQ(
+		RlpEncoder::Encode(Object(List({
+			Bytes(loremBytes.begin(), loremBytes.end()) }))),
+		expected);
+
+	// append to existing output
+	RlpEncoder encoder;
+	Vec out = { 0x01 };
+	encoder.Encode(List({ Bytes({ 0x02 }) }), out);
+	EXPECT_EQ(out, Vec({ 0x01, 0xC1, 0x02 }));
+
+	EXPECT_THROW(RlpEncoder::Encode(String("a")), TypeError);
+	EXPECT_THROW(RlpEncoder::Encode(List({ Int64(1) })), TypeError);
+	EXPECT_THROW(RlpEncoder::Encode(Dict()), TypeError);
+}
+
+GTEST_TEST(TestRlp, Decode)
+{
+	using Vec = std::vector<uint8_t>;
+
+	EXPECT_EQ(RlpDecoder::Decode(Vec({ 0x80 })), Bytes());
+	EXPECT_EQ(RlpDecoder::Decode(Vec({ 0x0F })), Bytes({ 0x0F }));
+	EXPECT_EQ(
+		RlpDecoder::Decode(Vec({ 0x83, 'd', 'o', 'g' })),
+		Bytes({ 'd', 'o', 'g' }));
+	EXPECT_EQ(RlpDecoder::Decode(Vec({ 0xC0 })), List());
+	EXPECT_EQ(
+		RlpDecoder::Decode(
+			Vec({ 0xC7, 0xC0, 0xC1, 0xC0, 0xC3, 0xC0, 0xC1, 0xC0 })),
+		List({
+			List(),
+			List({ List() }),
+			List({ List(), List({ List() }) }),
+		}));
+
+	// round trip
+	Vec data1024(1024, 0x55);
+	Object obj = List({
+		Bytes(data1024.begin(), data1024.end()),
+		List({ Bytes({ 0x00 }), Bytes({ 0x80 }), List() }),
+		Bytes(),
+	});
+	EXPECT_EQ(RlpDecoder::Decode(RlpEncoder::Encode(obj)), obj);
+
+	// deeply nested lists
+	List nested;
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		List outer;
+		outer.push_back(std::move(nested));
+		nested = std::move(outer);
+	}
+	EXPECT_EQ(RlpDecoder::Decode(RlpEncoder::Encode(nested)), nested);
+}
+
+GTEST_TEST(TestRlp, DecodeErrors)
+{
+	using Vec = std::vector<uint8_t>;
+
+	EXPECT_THROW(RlpDecoder::Decode(Vec()), ParseError);
+	// truncated
+	EXPECT_THROW(RlpDecoder::Decode(Vec({ 0x83, 'd', 'o' })), ParseError);
+	EXPECT_THROW(RlpDecoder::Decode(Vec({ 0xB8 })), ParseError);
+	EXPECT_THROW(RlpDecoder::Decode(Vec({ 0xC2, 0x01 })), ParseError);
+	// item exceeds the enclosing list
+	EXPECT_THROW(
+		RlpDecoder::Decode(Vec({ 0xC2, 0x82, 0x01, 0x02 })),
+		ParseError);
+	// extra data
+	EXPECT_THROW(RlpDecoder::Decode(Vec({ 0x01, 0x02 })), ParseError);
+	// non-canonical encodings
+	EXPECT_THROW(RlpDecoder::Decode(Vec({ 0x81, 0x01 })), ParseError);
+	EXPECT_THROW(RlpDecoder::Decode(Vec({ 0xB8, 0x01, 0x01 })), ParseError);
+	EXPECT_THROW(
+		RlpDecoder::Decode(Vec({ 0xB9, 0x00, 0x38 })),
+		ParseError);
+
+	try
+	{
+		RlpDecoder::Decode(Vec({ 0xC3, 0x01, 0x81, 0x02 }));
+		FAIL() << "ParseError is not thrown";
+	}
+	catch (const ParseError& e)
+	{
+		EXPECT_EQ(e.GetPos(), 2);
+	}
+}
+
+GTEST_TEST(TestRlp, DecodeView)
+{
+	using Vec = std::vector<uint8_t>;
+
+	const Vec data = { 0xC8, 0x83, 'c', 'a', 't', 0x01, 0xC2, 0x80, 0x02 };
+	Object obj = RlpDecoder::DecodeView(data.data(), data.size());
+	EXPECT_EQ(obj, RlpDecoder::Decode(data));
+	EXPECT_EQ(
+		obj,
+		List({ Bytes({ 'c', 'a', 't' }), Bytes({ 0x01 }),
+			List({ Bytes(), Bytes({ 0x02 }) }) }));
+
+	// byte strings refer to the input buffer
+	EXPECT_EQ(obj.AsList()[0].AsBytes().data(), data.data() + 2);
+	EXPECT_EQ(obj.AsList()[1].AsBytes().data(), data.data() + 5);
+	EXPECT_EQ(obj.AsList()[2].AsList()[1].AsBytes().data(), data.data() + 8);
+
+	EXPECT_THROW(
+		RlpDecoder::DecodeView(data.data(), data.size() - 1),
+		ParseError);
+}
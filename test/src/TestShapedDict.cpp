@@ -0,0 +1,174 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+}
+
+GTEST_TEST(TestShapedDict, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestShapedDict, Basic)
+{
+	ShapedDict dict;
+	EXPECT_EQ(dict.size(), 0);
+	EXPECT_FALSE(dict.IsTrue());
+	EXPECT_EQ(dict.GetShape(), ShapedDict::Shape::GetEmpty());
+
+	EXPECT_TRUE(dict.InsertOnly(String("b"), Int64(1)).second);
+	EXPECT_TRUE(dict.InsertOrAssign(Int64(10), String("ten")).second);
+	EXPECT_FALSE(dict.InsertOnly(String("b"), Int64(2)).second);
+	EXPECT_EQ(dict.InsertOrAssign(String("b"), Int64(3)),
+		std::make_pair(size_t(0), false));
+	dict[String("a")] = Null();
+	EXPECT_EQ(dict.size(), 3);
+	EXPECT_TRUE(dict.IsTrue());
+
+	EXPECT_EQ(dict["b"], Int64(3));
+	EXPECT_EQ(dict[10], String("ten"));
+	EXPECT_TRUE(dict.HasKey(10));
+	EXPECT_FALSE(dict.HasKey("c"));
+	EXPECT_THROW(static_cast<const ShapedDict&>(dict)["c"], KeyError);
+
+	// items are in the order of insertion
+	EXPECT_EQ(dict.ShortDebugString(), "{\"b\":3,10:\"ten\",\"a\":null}");
+	EXPECT_EQ(dict.DebugString(), "{ \"b\" : 3, 10 : \"ten\", \"a\" : null }");
+	EXPECT_EQ(dict.ToString(), "{ \"b\" : 3, 10 : \"ten\", \"a\" : null }");
+
+	EXPECT_EQ(dict.FindSlot("a"), 2);
+	EXPECT_EQ(dict.FindSlot("c"), dict.size());
+	EXPECT_EQ(dict.KeyAt(1), Int64(10));
+	EXPECT_EQ(dict.ValAt(1), String("ten"));
+	EXPECT_THROW(dict.ValAt(3), IndexError);
+
+	dict.Remove(Int64(10));
+	dict.Remove(String("c"));
+	EXPECT_EQ(dict.ShortDebugString(), "{\"b\":3,\"a\":null}");
+	EXPECT_EQ(dict.FindSlot("a"), 1);
+}
+
+GTEST_TEST(TestShapedDict, SharedShapes)
+{
+	std::vector<ShapedDict> records;
+	for (int64_t i = 0; i < 100; ++i)
+	{
+		ShapedDict record;
+		record.InsertOrAssign(String("id"), Int64(i));
+		record.InsertOrAssign(String("type"), String("item"));
+		record.InsertOrAssign(String("ts"), Int64(i * 10));
+		records.push_back(std::move(record));
+	}
+
+	// all records share the same shape, so a field can be accessed by
+	// the slot looked up once
+	const auto& shape = records[0].GetShape();
+	EXPECT_EQ(shape->size(), 3);
+	const size_t tsSlot = records[0].FindSlot("ts");
+	for (int64_t i = 0; i < 100; ++i)
+	{
+		const auto& record = records[static_cast<size_t>(i)];
+		EXPECT_EQ(record.GetShape(), shape);
+		EXPECT_EQ(record.ValAt(tsSlot), Int64(i * 10));
+	}
+
+	// keys added in a different order result in a different shape
+	ShapedDict other = { { String("type"), String("item") },
+		{ String("id"), Int64(0) }, { String("ts"), Int64(0) } };
+	EXPECT_NE(other.GetShape(), shape);
+	EXPECT_TRUE(other == records[0]);
+	EXPECT_FALSE(other == records[1]);
+
+	// adding or removing a key transitions to another shared shape
+	ShapedDict extended = records[1];
+	extended[String("extra")] = Bool(true);
+	EXPECT_EQ(extended.GetShape()->size(), 4);
+	EXPECT_EQ(records[1].GetShape(), shape);
+	extended.Remove(String("extra"));
+	EXPECT_EQ(extended.GetShape(), shape);
+	EXPECT_TRUE(extended == records[1]);
+
+	// a record created from a shape has default values
+	ShapedDict fromShape(shape);
+	EXPECT_EQ(fromShape.size(), 3);
+	EXPECT_EQ(fromShape["id"], Null());
+	fromShape.ValAt(0) = Int64(5);
+	EXPECT_TRUE(fromShape.HasKey("ts"));
+	EXPECT_EQ(fromShape[String("id")], Int64(5));
+
+	// the shape is still alive after all the records are gone
+	std::weak_ptr<const ShapedDict::Shape> weakShape = shape;
+	records.clear();
+	extended = ShapedDict();
+	EXPECT_FALSE(weakShape.expired());
+	fromShape = ShapedDict();
+	EXPECT_TRUE(weakShape.expired());
+}
+
+GTEST_TEST(TestShapedDict, BaseInterface)
+{
+	ShapedDict dict = { { String("a"), Int64(1) }, { Int64(2), String("b") } };
+	Dict ref = { { String("a"), Int64(1) }, { Int64(2), String("b") } };
+
+	const DictBaseObj& base = dict;
+	EXPECT_TRUE(base == static_cast<const DictBaseObj&>(ref));
+	EXPECT_TRUE(ref == base);
+	EXPECT_EQ(*base.FindVal(Int64(2)), String("b"));
+	EXPECT_EQ(base.FindVal(Int64(3)), base.ValsCEnd());
+
+	size_t count = 0;
+	for (auto it = base.cbegin(); it != base.cend(); ++it)
+	{
+		EXPECT_EQ(ref[*std::get<0>(*it)], *std::get<1>(*it));
+		++count;
+	}
+	EXPECT_EQ(count, 2);
+
+	base.ForEach([&](const HashableBaseObj& key, const BaseObj& val)
+	{
+		EXPECT_EQ(ref[key], val);
+	});
+
+	DictBaseObj& mutBase = dict;
+	EXPECT_EQ(mutBase[String("c")], Null());
+	EXPECT_FALSE(mutBase.InsertOrAssign(HashableObject(String("c")), Object(Int64(3))));
+	EXPECT_TRUE(mutBase.InsertOnly(HashableObject(String("d")), Object(Null())));
+	EXPECT_FALSE(mutBase.InsertOrAssign(HashableObject(String("d")), Object(Int64(4))));
+	EXPECT_THROW(mutBase.InsertOnly(String("e"), Null()), TypeError);
+	mutBase.Remove(String("a"));
+	EXPECT_EQ(dict.ShortDebugString(), "{2:\"b\",\"c\":3,\"d\":4}");
+
+	Object obj = dict;
+	EXPECT_EQ(obj.GetCategory(), ObjCategory::Dict);
+	EXPECT_EQ(obj.AsDict()[String("d")], Int64(4));
+	EXPECT_EQ(obj, dict);
+
+	ShapedDict moved = std::move(dict);
+	EXPECT_EQ(moved.size(), 3);
+	EXPECT_EQ(dict.size(), 0);
+	EXPECT_FALSE(dict.HasKey("c"));
+	dict.Set(moved);
+	EXPECT_TRUE(dict == moved);
+	EXPECT_THROW(dict.Set(ref), TypeError);
+}
@@ -405,6 +405,8 @@ GTEST_TEST(TestStaticDict, StaticDictBasic)
 	dict.get_Key1_1() = Int64(54321);
 	EXPECT_FALSE(dictcp == dict);
 	EXPECT_TRUE(dictcp != dict);
+	EXPECT_FALSE(static_cast<const BaseObj&>(dictcp) == dict);
+	EXPECT_TRUE(static_cast<const BaseObj&>(dictcp) == TestStaticDict1(dictcp));
 	EXPECT_TRUE(*(dict.Copy(StaticDictBaseObj::sk_null)) == dict);
 	EXPECT_TRUE(*(dict.Copy(BaseObj::sk_null)) == dict);
 
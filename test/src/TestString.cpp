@@ -27,6 +27,17 @@ namespace SimpleObjects_Test
 	extern size_t g_numOfTestFile;
 } // namespace SimpleObjects_Test
 
+namespace
+{
+
+size_t StrHash(const std::string& str)
+{
+	return Internal::DefaultHashPolicy::HashStr<char, std::char_traits<char> >(
+		str.data(), str.size());
+}
+
+} // namespace
+
 GTEST_TEST(TestString, CountTestFile)
 {
 	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
@@ -194,11 +205,11 @@ GTEST_TEST(TestString, Getters)
 GTEST_TEST(TestString, Hash)
 {
 	EXPECT_EQ(String("test string1").Hash(),
-		std::hash<std::string>()(std::string("test string1")));
+		StrHash("test string1"));
 	EXPECT_EQ(String("test string2").Hash(),
-		std::hash<std::string>()(std::string("test string2")));
+		StrHash("test string2"));
 	EXPECT_NE(String("test string1").Hash(),
-		std::hash<std::string>()(std::string("test string2")));
+		StrHash("test string2"));
 
 	EXPECT_EQ(String("test string1").Hash(),
 		std::hash<String>()(String("test string1")));
@@ -208,6 +219,41 @@ GTEST_TEST(TestString, Hash)
 		std::hash<String>()(String("test string2")));
 }
 
+GTEST_TEST(TestString, HashCache)
+{
+	String str("test string");
+	EXPECT_EQ(str.Hash(), StrHash("test string"));
+
+	// the cached hash value is dropped by every modification
+	str.push_back('1');
+	EXPECT_EQ(str.Hash(), StrHash("test string1"));
+	str.pop_back();
+	EXPECT_EQ(str.Hash(), StrHash("test string"));
+	str[0] = 'T';
+	EXPECT_EQ(str.Hash(), StrHash("Test string"));
+	str.Append(String("2"));
+	EXPECT_EQ(str.Hash(), StrHash("Test string2"));
+	str += String("3");
+	EXPECT_EQ(str.Hash(), StrHash("Test string23"));
+	str.resize(4);
+	EXPECT_EQ(str.Hash(), StrHash("Test"));
+	*str.begin() = 't';
+	EXPECT_EQ(str.Hash(), StrHash("test"));
+	*str.rbegin() = 'T';
+	EXPECT_EQ(str.Hash(), StrHash("tesT"));
+	str.Set(String("other"));
+	EXPECT_EQ(str.Hash(), StrHash("other"));
+
+	// copies share the cached value, and moved-from objects drop it
+	String cpy = str;
+	EXPECT_EQ(cpy.Hash(), StrHash("other"));
+	String moved = std::move(cpy);
+	EXPECT_EQ(moved.Hash(), StrHash("other"));
+	EXPECT_EQ(cpy.Hash(), StrHash(cpy.GetVal()));
+	cpy = str;
+	EXPECT_EQ(cpy.Hash(), StrHash("other"));
+}
+
 GTEST_TEST(TestString, Len)
 {
 	EXPECT_EQ(String("abcdef").size(), std::string("abcdef").size());
@@ -260,6 +306,11 @@ GTEST_TEST(TestString, StartsWith)
 
 	auto longStr = String("abcdefg");
 	EXPECT_FALSE(String("abcdef").StartsWith(longStr.cbegin(), longStr.cend()));
+
+	const char* span = "abcdefg";
+	EXPECT_TRUE(String("abcdef").StartsWith(span, span + 3));
+	EXPECT_FALSE(String("abcdef").StartsWith(span + 1, span + 3));
+	EXPECT_FALSE(String("abcdef").StartsWith(span, span + 7));
 }
 
 GTEST_TEST(TestString, EndsWith)
@@ -274,6 +325,11 @@ GTEST_TEST(TestString, EndsWith)
 
 	auto longStr = String("zabcdef");
 	EXPECT_FALSE(String("abcdef").EndsWith(longStr.cbegin(), longStr.cend()));
+
+	const char* span = "abcdefg";
+	EXPECT_TRUE(String("abcdef").EndsWith(span + 4, span + 6));
+	EXPECT_FALSE(String("abcdef").EndsWith(span + 4, span + 7));
+	EXPECT_FALSE(String("abcdef").EndsWith(span, span + 7));
 }
 
 GTEST_TEST(TestString, Contains)
@@ -289,6 +345,11 @@ GTEST_TEST(TestString, Contains)
 
 	auto longStr = String("abcdefg");
 	EXPECT_EQ(testStr.Contains(longStr.cbegin(), longStr.cend()), testStr.cend());
+
+	const char* span = "abcdefg";
+	EXPECT_EQ(testStr.Contains(span + 2, span + 4), testStr.cbegin() + 2);
+	EXPECT_EQ(testStr.Contains(span, span), testStr.cbegin());
+	EXPECT_EQ(testStr.Contains(span + 5, span + 7), testStr.cend());
 }
 
 GTEST_TEST(TestString, PushPopBack)
@@ -313,6 +374,35 @@ GTEST_TEST(TestString, Append)
 
 	testStr += String("ghijk");
 	EXPECT_EQ(testStr, String("abcdefghijkghijk"));
+
+	const char* span = "lmn";
+	testStr.Append(span, span + 3);
+	EXPECT_EQ(testStr, String("abcdefghijkghijklmn"));
+
+	// append to itself through the base class
+	auto selfStr = String("abc");
+	StringBaseObj& selfBase = selfStr;
+	selfBase += selfBase;
+	EXPECT_EQ(selfStr, String("abcabc"));
+	selfBase.Append(selfBase.data() + 1, selfBase.data() + 3);
+	EXPECT_EQ(selfStr, String("abcabcbc"));
+}
+
+GTEST_TEST(TestString, NativeIterator)
+{
+	auto testStr = String("abcdef");
+	const auto& kTestStr = testStr;
+
+	EXPECT_EQ(kTestStr.NativeEnd() - kTestStr.NativeBegin(), 6);
+	EXPECT_EQ(&(*kTestStr.NativeBegin()), kTestStr.data());
+	EXPECT_EQ(*std::find(kTestStr.NativeBegin(), kTestStr.NativeEnd(), 'c'),
+		'c');
+
+	size_t hash = testStr.Hash();
+	std::reverse(testStr.NativeBegin(), testStr.NativeEnd());
+	EXPECT_EQ(testStr, String("fedcba"));
+	EXPECT_NE(testStr.Hash(), hash);
+	EXPECT_EQ(testStr.Hash(), String("fedcba").Hash());
 }
 
 GTEST_TEST(TestString, CStr)
@@ -433,3 +523,24 @@ GTEST_TEST(TestString, ToString)
 		EXPECT_EQ(res, expRes);
 	}
 }
+
+GTEST_TEST(TestString, Allocator)
+{
+	MonotonicArena arena;
+	ArenaAllocator<char> alloc(&arena);
+	const std::string testStr = "A string that doesn't fit in the SSO buffer";
+
+	auto str1 = MakeString(alloc);
+	EXPECT_EQ(str1.GetVal().get_allocator(), alloc);
+	EXPECT_EQ(str1.size(), 0);
+	str1 += String(testStr);
+
+	auto str2 = MakeString(testStr.c_str(), alloc);
+	EXPECT_EQ(str2.GetVal().get_allocator(), alloc);
+	EXPECT_EQ(str1, str2);
+	EXPECT_GE(arena.GetAllocatedSize(), testStr.size() * 2);
+
+	// strings with different allocators are equal and have the same hash
+	EXPECT_TRUE(str2.BaseObjectIsEqual(String(testStr)));
+	EXPECT_EQ(str2.Hash(), String(testStr).Hash());
+}
@@ -0,0 +1,123 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <string>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+}
+
+GTEST_TEST(TestStringView, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestStringView, ReadAccess)
+{
+	const char* buf = "Hello world";
+	const StringView view(buf);
+
+	EXPECT_FALSE(view.IsOwned());
+	EXPECT_EQ(view.data(), buf);
+	EXPECT_EQ(view.size(), 11);
+	EXPECT_EQ(view[4], 'o');
+	EXPECT_THROW(view[11], IndexError);
+	EXPECT_EQ(view.GetCategory(), ObjCategory::String);
+	EXPECT_FALSE(StringView().IsTrue());
+
+	EXPECT_EQ(std::string(view.begin(), view.end()), "Hello world");
+	EXPECT_EQ(std::string(view.crbegin(), view.crend()), "dlrow olleH");
+
+	EXPECT_TRUE(view.StartsWith(String("Hello")));
+	EXPECT_TRUE(view.EndsWith(String("world")));
+	EXPECT_FALSE(view.EndsWith(String("Hello")));
+	EXPECT_EQ(view.Contains(String("o w")) - view.cbegin(), 4);
+	EXPECT_EQ(view.Contains(String("xyz")), view.cend());
+
+	EXPECT_EQ(view.DebugString(), "\"Hello world\"");
+	EXPECT_EQ(view.ToString(), String("Hello world").ToString());
+
+	EXPECT_FALSE(view.IsOwned());
+}
+
+GTEST_TEST(TestStringView, CompareAndHash)
+{
+	const std::string buf = "abc";
+	const StringView view(buf.data(), buf.size());
+	const String str = "abc";
+
+	EXPECT_TRUE(view == str);
+	EXPECT_TRUE(str == view);
+	EXPECT_TRUE(view < String("abd"));
+	EXPECT_TRUE(view > String("ab"));
+	EXPECT_EQ(view.Hash(), str.Hash());
+	EXPECT_EQ(std::hash<StringView>()(view), std::hash<String>()(str));
+
+	Dict dict = { { HashableObject(str), Int64(1) } };
+	EXPECT_EQ(dict[HashableObject(view)], Int64(1));
+}
+
+GTEST_TEST(TestStringView, SliceAndCStr)
+{
+	const std::string buf = "key=value";
+	const StringView view(buf.data(), buf.size());
+
+	StringView key = view.Slice(0, 3);
+	StringView val = view.Slice(4, std::string::npos);
+	EXPECT_EQ(key.data(), buf.data());
+	EXPECT_EQ(key, String("key"));
+	EXPECT_EQ(val, String("value"));
+	EXPECT_THROW(view.Slice(10, 1), IndexError);
+
+	// the slice is not null-terminated, so c_str copies it
+	EXPECT_EQ(std::strcmp(key.c_str(), "key"), 0);
+	EXPECT_TRUE(key.IsOwned());
+	EXPECT_EQ(key, String("key"));
+}
+
+GTEST_TEST(TestStringView, CopyOnWrite)
+{
+	const std::string buf = "abc";
+	StringView view(buf.data(), buf.size());
+	StringView view2 = view;
+
+	view.push_back('d');
+	EXPECT_TRUE(view.IsOwned());
+	EXPECT_EQ(view, String("abcd"));
+	EXPECT_EQ(buf, "abc");
+	EXPECT_EQ(view2, String("abc"));
+
+	view2[0] = 'x';
+	EXPECT_EQ(view2, String("xbc"));
+	EXPECT_EQ(buf, "abc");
+
+	StringView view3(buf.data(), buf.size());
+	view3 += String("de");
+	EXPECT_EQ(view3, String("abcde"));
+	view3.pop_back();
+	view3.resize(2);
+	EXPECT_EQ(view3, String("ab"));
+
+	Object obj = StringView(buf.data(), buf.size());
+	EXPECT_EQ(obj.AsString().data(), buf.data());
+	EXPECT_EQ(obj, String("abc"));
+}
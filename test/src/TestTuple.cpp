@@ -0,0 +1,240 @@
+// Copyright 2022 Haofan Zheng
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif // _MSC_VER
+#include <SimpleObjects/SimpleObjects.hpp>
+
+#ifndef SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE
+using namespace SimpleObjects;
+#else
+using namespace SIMPLEOBJECTS_CUSTOMIZED_NAMESPACE;
+#endif
+
+namespace SimpleObjects_Test
+{
+	extern size_t g_numOfTestFile;
+} // namespace SimpleObjects_Test
+
+GTEST_TEST(TestTuple, CountTestFile)
+{
+	static auto tmp = ++SimpleObjects_Test::g_numOfTestFile;
+	(void)tmp;
+}
+
+GTEST_TEST(TestTuple, Construction)
+{
+	// Default
+	EXPECT_NO_THROW({
+		Tuple().GetVal();
+	});
+	EXPECT_NO_THROW({
+		std::unique_ptr<BaseObj> base;
+		base.reset(new Tuple());
+		base.reset();
+	});
+
+	// Copy & Move
+	const Tuple testTp = { String("Test String"), Bool(true), Int64(12345) };
+	Tuple cpTp(testTp);
+	EXPECT_EQ(cpTp, testTp);
+	Tuple mvTp(std::move(cpTp));
+	EXPECT_EQ(mvTp, testTp);
+
+	// from range
+	std::vector<HashableObject> items = { String("a"), Int64(1) };
+	EXPECT_EQ(Tuple(items.begin(), items.end()),
+		Tuple({ String("a"), Int64(1) }));
+	EXPECT_EQ(Tuple(items), Tuple({ String("a"), Int64(1) }));
+}
+
+GTEST_TEST(TestTuple, Assignment)
+{
+	const Tuple testTp = { String("Test String"), Bool(true), Int64(12345) };
+
+	Tuple cpTp;
+	EXPECT_EQ(cpTp.size(), 0);
+	cpTp = testTp;
+	EXPECT_EQ(cpTp, testTp);
+
+	Tuple mvTp;
+	mvTp = std::move(cpTp);
+	EXPECT_EQ(mvTp, testTp);
+}
+
+GTEST_TEST(TestTuple, Category)
+{
+	static_assert(Tuple::sk_cat() == ObjCategory::Tuple, "Category failed.");
+	EXPECT_EQ(Tuple::sk_cat(), ObjCategory::Tuple);
+
+	Tuple val;
+	EXPECT_EQ(val.GetCategory(), ObjCategory::Tuple);
+	EXPECT_EQ(val.GetCategoryName(), std::string("Tuple"));
+
+	EXPECT_NO_THROW(val.AsTuple());
+	EXPECT_NO_THROW(val.AsHashable());
+	EXPECT_THROW(val.AsList(), TypeError);
+	EXPECT_THROW(List().AsTuple(), TypeError);
+}
+
+GTEST_TEST(TestTuple, Setters)
+{
+	Tuple tp1 = { Int64(1) };
+	EXPECT_NO_THROW(Tuple().Set(tp1));
+	EXPECT_NO_THROW(Tuple().Set(Tuple()));
+
+	EXPECT_THROW(Tuple().Set(Null()), TypeError);
+	EXPECT_THROW(Tuple().Set(List()), TypeError);
+	EXPECT_THROW(Tuple().Set(static_cast<int64_t>(1)), TypeError);
+
+	Tuple tp2;
+	tp2.Set(tp1);
+	EXPECT_EQ(tp2, tp1);
+}
+
+GTEST_TEST(TestTuple, Getters)
+{
+	EXPECT_FALSE(Tuple().IsTrue());
+	EXPECT_TRUE(Tuple({ Null() }).IsTrue());
+
+	EXPECT_THROW(Tuple().AsCppInt64(), TypeError);
+	EXPECT_THROW(Tuple().AsCppDouble(), TypeError);
+}
+
+GTEST_TEST(TestTuple, Compare)
+{
+	const Tuple tp_12345 = { String("Test String"), Int64(12345) };
+	const Tuple tp_12345_2 = { String("Test String"), Int64(12345) };
+	const Tuple tp_short = { String("Test String") };
+	const Tuple tp_12000 = { String("Test String"), Int64(12000) };
+
+	EXPECT_TRUE(tp_12345 == tp_12345_2);
+	EXPECT_FALSE(tp_12345 != tp_12345_2);
+	EXPECT_TRUE(tp_12345 != tp_12000);
+	EXPECT_TRUE(tp_12000 < tp_12345);
+	EXPECT_TRUE(tp_short < tp_12345);
+	EXPECT_TRUE(tp_12345 > tp_short);
+
+	// through the base classes
+	const BaseObj& base_12345 = tp_12345;
+	const BaseObj& base_12000 = tp_12000;
+	EXPECT_TRUE(base_12345 == tp_12345_2);
+	EXPECT_TRUE(base_12000 < base_12345);
+
+	// tuples and lists are never equal
+	const List ls_12345 = { String("Test String"), Int64(12345) };
+	const BaseObj& base_ls = ls_12345;
+	EXPECT_FALSE(base_12345 == base_ls);
+	EXPECT_FALSE(base_ls == base_12345);
+	EXPECT_EQ(base_12345.BaseObjectCompare(base_ls),
+		ObjectOrder::NotEqualUnordered);
+}
+
+GTEST_TEST(TestTuple, Hash)
+{
+	const Tuple tp1 = { String("key"), Int64(1) };
+	const Tuple tp2 = { String("key"), Int64(1) };
+	const Tuple tp3 = { Int64(1), String("key") };
+
+	EXPECT_EQ(tp1.Hash(), tp2.Hash());
+	EXPECT_NE(tp1.Hash(), tp3.Hash());
+	EXPECT_EQ(tp1.Hash(), std::hash<Tuple>()(tp1));
+
+	size_t expHash = 0;
+	Internal::hash_combine(expHash, String("key").Hash());
+	Internal::hash_combine(expHash, Int64(1).Hash());
+	EXPECT_EQ(tp1.Hash(), expHash);
+
+	// nested tuples
+	const Tuple nested1 = { tp1, Null() };
+	const Tuple nested2 = { tp2, Null() };
+	EXPECT_EQ(nested1.Hash(), nested2.Hash());
+
+	HashableObject obj = tp1;
+	EXPECT_EQ(obj.Hash(), tp1.Hash());
+}
+
+GTEST_TEST(TestTuple, DictKey)
+{
+	Dict dict;
+	dict[Tuple({ String("a"), Int64(1) })] = String("a1");
+	dict[Tuple({ String("a"), Int64(2) })] = String("a2");
+	dict[Tuple({ String("b"), Int64(1) })] = String("b1");
+	EXPECT_EQ(dict.size(), 3);
+
+	EXPECT_EQ(dict[Tuple({ String("a"), Int64(2) })], String("a2"));
+	dict[Tuple({ String("a"), Int64(2) })] = String("a2-new");
+	EXPECT_EQ(dict.size(), 3);
+	EXPECT_EQ(dict[Tuple({ String("a"), Int64(2) })], String("a2-new"));
+
+	const Tuple key = { String("b"), Int64(1) };
+	EXPECT_TRUE(dict.HasKey(key));
+	EXPECT_FALSE(dict.HasKey(Tuple({ String("b"), Int64(2) })));
+	const Dict& constDict = dict;
+	EXPECT_EQ(constDict[key], String("b1"));
+	EXPECT_THROW(constDict[Tuple({ String("c"), Int64(1) })], KeyError);
+}
+
+GTEST_TEST(TestTuple, Access)
+{
+	const Tuple tp = { String("a"), Int64(1), Null() };
+	EXPECT_EQ(tp.size(), 3);
+	EXPECT_EQ(tp[0], String("a"));
+	EXPECT_EQ(tp[1], Int64(1));
+	EXPECT_THROW(tp[3], IndexError);
+	EXPECT_TRUE(tp.Contains(Int64(1)));
+	EXPECT_FALSE(tp.Contains(Int64(2)));
+
+	std::vector<HashableObject> items(tp.begin(), tp.end());
+	EXPECT_EQ(items, tp.GetVal());
+	std::vector<HashableObject> ritems(tp.crbegin(), tp.crend());
+	EXPECT_EQ(ritems,
+		std::vector<HashableObject>({ Null(), Int64(1), String("a") }));
+
+	// through the base class
+	const TupleBaseObj& base = tp;
+	EXPECT_EQ(base.size(), 3);
+	EXPECT_EQ(base[1], Int64(1));
+	EXPECT_THROW(base[3], IndexError);
+	EXPECT_TRUE(base.Contains(String("a")));
+	size_t i = 0;
+	for (auto it = base.cbegin(); it != base.cend(); ++it, ++i)
+	{
+		EXPECT_EQ(*it, tp[i]);
+	}
+	EXPECT_EQ(i, 3);
+
+	i = 0;
+	base.ForEach([&](const HashableBaseObj& item)
+	{
+		EXPECT_EQ(item, tp[i]);
+		++i;
+	});
+	EXPECT_EQ(i, 3);
+
+	const Object obj = tp;
+	EXPECT_EQ(obj.AsTuple().size(), 3);
+	EXPECT_EQ(obj.AsTuple()[0], String("a"));
+}
+
+GTEST_TEST(TestTuple, ToString)
+{
+	const Tuple tp = { String("a"), Int64(1) };
+	EXPECT_EQ(Tuple().DebugString(), "(  )");
+	EXPECT_EQ(tp.DebugString(), "( \"a\", 1 )");
+	EXPECT_EQ(tp.ShortDebugString(), "(\"a\",1)");
+	EXPECT_EQ(tp.ToString(), "( \"a\", 1 )");
+
+	std::string res;
+	tp.DumpString(ToOutIt<char>(std::back_inserter(res)));
+	EXPECT_EQ(res, "( \"a\", 1 )");
+
+	EXPECT_EQ(JsonWriter::Dump(tp), "[\"a\",1]");
+}